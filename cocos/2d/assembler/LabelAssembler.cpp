@@ -0,0 +1,80 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/assembler/LabelAssembler.h"
+
+#include <algorithm>
+#include "2d/assembler/SpriteAssembler.h"
+#include "2d/framework/UIRenderer.h"
+#include "base/Log.h"
+#include "math/Color.h"
+
+namespace cc {
+namespace {
+// uint16 indices address at most 65536 vertices, 4 per glyph
+constexpr size_t MAX_GLYPH_COUNT = 65536 / 4;
+} // namespace
+
+void LabelAssembler::fillTTF(UIRenderer *renderer, const Size &size, const Vec2 &anchor, const Color &color) {
+    SpriteAssembler::fillSimple(renderer, size, anchor, Vec4(0.F, 1.F, 1.F, 0.F), color);
+}
+
+void LabelAssembler::fillBitmapFont(UIRenderer *renderer, const std::vector<Vec4> &glyphRects, const std::vector<Vec4> &glyphUVs, const Color &color) {
+    size_t glyphCount = std::min(glyphRects.size(), glyphUVs.size());
+    if (glyphCount > MAX_GLYPH_COUNT) {
+        CC_LOG_WARNING("Bitmap font label with %u glyphs exceeds the 2D batch limit.", static_cast<uint32_t>(glyphCount));
+        glyphCount = MAX_GLYPH_COUNT;
+    }
+
+    const float r = color.r / 255.F;
+    const float g = color.g / 255.F;
+    const float b = color.b / 255.F;
+    const float a = color.a / 255.F;
+
+    std::vector<float>    vertices;
+    std::vector<uint16_t> indices;
+    vertices.reserve(glyphCount * 4 * UIRenderer::VERTEX_FLOATS);
+    indices.reserve(glyphCount * 6);
+    auto pushVertex = [&](float x, float y, float u, float v) {
+        vertices.insert(vertices.end(), {x, y, 0.F, u, v, r, g, b, a});
+    };
+    for (size_t i = 0; i < glyphCount; ++i) {
+        const auto &rect = glyphRects[i];
+        const auto &uv   = glyphUVs[i];
+        pushVertex(rect.x, rect.y, uv.x, uv.y);
+        pushVertex(rect.x + rect.z, rect.y, uv.z, uv.y);
+        pushVertex(rect.x, rect.y + rect.w, uv.x, uv.w);
+        pushVertex(rect.x + rect.z, rect.y + rect.w, uv.z, uv.w);
+
+        const auto bottomLeft = static_cast<uint16_t>(i * 4);
+        indices.insert(indices.end(), {bottomLeft, static_cast<uint16_t>(bottomLeft + 1), static_cast<uint16_t>(bottomLeft + 2),
+                                       static_cast<uint16_t>(bottomLeft + 1), static_cast<uint16_t>(bottomLeft + 3), static_cast<uint16_t>(bottomLeft + 2)});
+    }
+
+    renderer->setVertices(std::move(vertices));
+    renderer->setIndices(std::move(indices));
+}
+
+} // namespace cc
@@ -0,0 +1,54 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "base/Macros.h"
+#include "math/Geometry.h"
+#include "math/Vec2.h"
+#include "math/Vec4.h"
+
+namespace cc {
+
+class Color;
+class UIRenderer;
+
+/**
+ * Fills the local space geometry of a label's UIRenderer after its layout changed.
+ * TTF labels are rendered into a texture of their content size, bitmap font labels draw one quad per glyph.
+ */
+class CC_DLL LabelAssembler final {
+public:
+    // the label texture is drawn top row first, so v runs downwards
+    static void fillTTF(UIRenderer *renderer, const Size &size, const Vec2 &anchor, const Color &color);
+
+    // glyph rects are (x, y, width, height) in node space from the bottom left corner, uvs are (u0, v0, u1, v1) in the font texture
+    static void fillBitmapFont(UIRenderer *renderer, const std::vector<Vec4> &glyphRects, const std::vector<Vec4> &glyphUVs, const Color &color);
+
+    LabelAssembler() = delete;
+};
+
+} // namespace cc
@@ -0,0 +1,97 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/assembler/SpriteAssembler.h"
+
+#include <algorithm>
+#include <vector>
+#include "2d/framework/UIRenderer.h"
+#include "math/Color.h"
+
+namespace cc {
+namespace {
+// a grid of (columns + 1) * (rows + 1) vertices, xs and us from left to right, ys and vs from bottom to top
+void fillGrid(UIRenderer *renderer, const float *xs, const float *us, uint32_t columns, const float *ys, const float *vs, uint32_t rows, const Color &color) {
+    const float r = color.r / 255.F;
+    const float g = color.g / 255.F;
+    const float b = color.b / 255.F;
+    const float a = color.a / 255.F;
+
+    std::vector<float> vertices;
+    vertices.reserve((columns + 1) * (rows + 1) * UIRenderer::VERTEX_FLOATS);
+    for (uint32_t y = 0; y <= rows; ++y) {
+        for (uint32_t x = 0; x <= columns; ++x) {
+            vertices.insert(vertices.end(), {xs[x], ys[y], 0.F, us[x], vs[y], r, g, b, a});
+        }
+    }
+
+    std::vector<uint16_t> indices;
+    indices.reserve(columns * rows * 6);
+    for (uint32_t y = 0; y < rows; ++y) {
+        for (uint32_t x = 0; x < columns; ++x) {
+            const auto bottomLeft = static_cast<uint16_t>(y * (columns + 1) + x);
+            const auto topLeft    = static_cast<uint16_t>(bottomLeft + columns + 1);
+            indices.insert(indices.end(), {bottomLeft, static_cast<uint16_t>(bottomLeft + 1), topLeft,
+                                           static_cast<uint16_t>(bottomLeft + 1), static_cast<uint16_t>(topLeft + 1), topLeft});
+        }
+    }
+
+    renderer->setVertices(std::move(vertices));
+    renderer->setIndices(std::move(indices));
+}
+} // namespace
+
+void SpriteAssembler::fillSimple(UIRenderer *renderer, const Size &size, const Vec2 &anchor, const Vec4 &uv, const Color &color) {
+    const float left   = -anchor.x * size.width;
+    const float bottom = -anchor.y * size.height;
+    const float xs[]   = {left, left + size.width};
+    const float ys[]   = {bottom, bottom + size.height};
+    const float us[]   = {uv.x, uv.z};
+    const float vs[]   = {uv.y, uv.w};
+    fillGrid(renderer, xs, us, 1, ys, vs, 1, color);
+}
+
+void SpriteAssembler::fillSliced(UIRenderer *renderer, const Size &size, const Vec2 &anchor, const Vec4 &uv, const Vec4 &borders, const Size &frameSize, const Color &color) {
+    // borders which don't fit into the content size shrink proportionally
+    const float xBorders = borders.x + borders.z;
+    const float yBorders = borders.y + borders.w;
+    const float xScale   = xBorders > size.width && xBorders > 0.F ? size.width / xBorders : 1.F;
+    const float yScale   = yBorders > size.height && yBorders > 0.F ? size.height / yBorders : 1.F;
+
+    const float left   = -anchor.x * size.width;
+    const float bottom = -anchor.y * size.height;
+    const float right  = left + size.width;
+    const float top    = bottom + size.height;
+    const float xs[]   = {left, left + borders.x * xScale, right - borders.z * xScale, right};
+    const float ys[]   = {bottom, bottom + borders.y * yScale, top - borders.w * yScale, top};
+
+    const float uPerPixel = frameSize.width > 0.F ? (uv.z - uv.x) / frameSize.width : 0.F;
+    const float vPerPixel = frameSize.height > 0.F ? (uv.w - uv.y) / frameSize.height : 0.F;
+    const float us[]      = {uv.x, uv.x + borders.x * uPerPixel, uv.z - borders.z * uPerPixel, uv.z};
+    const float vs[]      = {uv.y, uv.y + borders.y * vPerPixel, uv.w - borders.w * vPerPixel, uv.w};
+    fillGrid(renderer, xs, us, 3, ys, vs, 3, color);
+}
+
+} // namespace cc
@@ -0,0 +1,54 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "math/Geometry.h"
+#include "math/Vec2.h"
+#include "math/Vec4.h"
+
+namespace cc {
+
+class Color;
+class UIRenderer;
+
+/**
+ * Fills the local space geometry of a sprite's UIRenderer, called by the owner whenever its size,
+ * anchor, sprite frame or color changes. Positions are relative to the node, uv is (u0, v0, u1, v1)
+ * from the bottom left to the top right corner of the frame.
+ */
+class CC_DLL SpriteAssembler final {
+public:
+    // one quad stretched over the content size
+    static void fillSimple(UIRenderer *renderer, const Size &size, const Vec2 &anchor, const Vec4 &uv, const Color &color);
+
+    // a 3x3 grid whose borders, (left, bottom, right, top) in pixels of a frameSize frame, keep their size
+    static void fillSliced(UIRenderer *renderer, const Size &size, const Vec2 &anchor, const Vec4 &uv, const Vec4 &borders, const Size &frameSize, const Color &color);
+
+    SpriteAssembler() = delete;
+};
+
+} // namespace cc
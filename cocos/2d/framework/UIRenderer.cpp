@@ -0,0 +1,153 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/framework/UIRenderer.h"
+
+#include <cstring>
+#include "2d/renderer/Batcher2d.h"
+#include "2d/renderer/DynamicAtlasManager.h"
+#include "core/Root.h"
+#include "core/assets/Material.h"
+#include "core/scene-graph/Node.h"
+#include "renderer/gfx-base/GFXSampler.h"
+#include "renderer/gfx-base/GFXTexture.h"
+
+namespace cc {
+
+namespace {
+Batcher2d *getBatcher() {
+    auto *root = Root::getInstance();
+    return root ? root->getBatcher2D() : nullptr;
+}
+} // namespace
+
+UIRenderer::~UIRenderer() {
+    onDisable();
+    setTexture(nullptr);
+}
+
+void UIRenderer::onEnable() {
+    auto *batcher = getBatcher();
+    if (!_registeredNode && batcher && getNode()) {
+        _registeredNode = getNode();
+        batcher->addRenderer(_registeredNode, this);
+    }
+}
+
+void UIRenderer::onDisable() {
+    auto *batcher = getBatcher();
+    if (_registeredNode && batcher) {
+        batcher->removeRenderer(_registeredNode, this);
+    }
+    _registeredNode = nullptr;
+}
+
+void UIRenderer::setNode(Node *node) {
+    if (_node == node) {
+        return;
+    }
+    const bool registered = _registeredNode != nullptr;
+    onDisable();
+    _node               = node;
+    _worldVerticesDirty = true;
+    if (registered) {
+        onEnable();
+    }
+}
+
+void UIRenderer::setMaterial(Material *material) {
+    _material = material;
+}
+
+void UIRenderer::setSampler(gfx::Sampler *sampler) {
+    _sampler = sampler;
+}
+
+void UIRenderer::setTexture(gfx::Texture *texture) {
+    if (_texture == texture) {
+        return;
+    }
+    if (_packed) {
+        DynamicAtlasManager::getInstance()->releaseTexture(_texture);
+        _packed             = false;
+        _worldVerticesDirty = true;
+    }
+    _texture = texture;
+}
+
+bool UIRenderer::packToDynamicAtlas() {
+    if (!_packed && DynamicAtlasManager::getInstance()->insertTexture(_texture)) {
+        _packed             = true;
+        _worldVerticesDirty = true;
+    }
+    return _packed;
+}
+
+gfx::Texture *UIRenderer::getRenderTexture() const {
+    const auto *frame = _packed ? DynamicAtlasManager::getInstance()->getFrame(_texture) : nullptr;
+    return frame ? frame->texture : _texture.get();
+}
+
+void UIRenderer::setVertices(std::vector<float> vertices) {
+    _vertices           = std::move(vertices);
+    _worldVerticesDirty = true;
+}
+
+void UIRenderer::setIndices(std::vector<uint16_t> indices) {
+    _indices = std::move(indices);
+}
+
+const std::vector<float> &UIRenderer::getWorldVertices() {
+    const auto &worldMatrix = getNode()->getWorldMatrix();
+    const auto *frame       = _packed ? DynamicAtlasManager::getInstance()->getFrame(_texture) : nullptr;
+    auto *      atlasPage   = frame ? frame->texture : nullptr;
+    const auto  version     = frame ? frame->version : 0;
+    if (!_worldVerticesDirty && atlasPage == _atlasPage && version == _atlasFrameVersion &&
+        memcmp(_worldMatrix.m, worldMatrix.m, sizeof(worldMatrix.m)) == 0) {
+        return _worldVertices;
+    }
+
+    _worldMatrix        = worldMatrix;
+    _worldVertices      = _vertices;
+    _atlasPage          = atlasPage;
+    _atlasFrameVersion  = version;
+    _worldVerticesDirty = false;
+
+    Vec3 position;
+    for (size_t i = 0; i + VERTEX_FLOATS <= _worldVertices.size(); i += VERTEX_FLOATS) {
+        position.set(_worldVertices[i], _worldVertices[i + 1], _worldVertices[i + 2]);
+        _worldMatrix.transformPoint(&position);
+        _worldVertices[i]     = position.x;
+        _worldVertices[i + 1] = position.y;
+        _worldVertices[i + 2] = position.z;
+        if (frame) {
+            _worldVertices[i + 3] = _worldVertices[i + 3] * frame->uvTransform.z + frame->uvTransform.x;
+            _worldVertices[i + 4] = _worldVertices[i + 4] * frame->uvTransform.w + frame->uvTransform.y;
+        }
+    }
+    return _worldVertices;
+}
+
+} // namespace cc
@@ -0,0 +1,99 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "base/Ptr.h"
+#include "core/components/Component.h"
+#include "math/Mat4.h"
+
+namespace cc {
+
+class Material;
+
+namespace gfx {
+class Texture;
+class Sampler;
+} // namespace gfx
+
+/**
+ * Native render data of a 2D renderer such as a sprite or a label.
+ * The owner refills the local space vertices only when its geometry changes, Batcher2d transforms them
+ * to world space and merges compatible renderers into shared buffers every frame.
+ */
+class UIRenderer : public Component {
+public:
+    // position xyz, uv, color rgba
+    static constexpr uint32_t VERTEX_FLOATS = 9;
+
+    UIRenderer() = default;
+    ~UIRenderer() override;
+
+    Material *    getMaterial() const { return _material.get(); }
+    void          setMaterial(Material *material);
+    gfx::Texture *getTexture() const { return _texture.get(); }
+    void          setTexture(gfx::Texture *texture);
+    gfx::Sampler *getSampler() const { return _sampler.get(); }
+    void          setSampler(gfx::Sampler *sampler);
+
+    const std::vector<float> &   getVertices() const { return _vertices; }
+    void                         setVertices(std::vector<float> vertices);
+    const std::vector<uint16_t> &getIndices() const { return _indices; }
+    void                         setIndices(std::vector<uint16_t> indices);
+    uint32_t                     getVertexCount() const { return static_cast<uint32_t>(_vertices.size() / VERTEX_FLOATS); }
+
+    // Moves the texture into a DynamicAtlasManager page, uvs are remapped when the world vertices are built
+    bool          packToDynamicAtlas();
+    bool          isPackedToDynamicAtlas() const { return _packed; }
+    // The atlas page while packed, the texture otherwise
+    gfx::Texture *getRenderTexture() const;
+
+    // Vertices transformed by the node's world matrix, only recomputed when the node, the vertices or the atlas frame changed
+    const std::vector<float> &getWorldVertices();
+
+    // Script owned renderers are attached here instead of through Node::addComponent, the node doesn't own them
+    void setNode(Node *node);
+
+    // Registers the renderer to Batcher2d while it is enabled
+    void onEnable() override;
+    void onDisable() override;
+
+private:
+    SharedPtr<Material>     _material;
+    SharedPtr<gfx::Texture> _texture;
+    SharedPtr<gfx::Sampler> _sampler;
+    std::vector<float>      _vertices;
+    std::vector<uint16_t>   _indices;
+    std::vector<float>      _worldVertices;
+    Mat4                    _worldMatrix;
+    gfx::Texture *          _atlasPage{nullptr};
+    uint32_t                _atlasFrameVersion{0};
+    bool                    _worldVerticesDirty{true};
+    bool                    _packed{false};
+    Node *                  _registeredNode{nullptr};
+};
+
+} // namespace cc
@@ -0,0 +1,346 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/renderer/Batcher2d.h"
+
+#include <algorithm>
+#include "2d/framework/UIRenderer.h"
+#include "core/Director.h"
+#include "core/Root.h"
+#include "core/assets/Material.h"
+#include "core/scene-graph/Scene.h"
+#include "math/MathUtil.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXDescriptorSet.h"
+#include "renderer/gfx-base/GFXDescriptorSetLayout.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/gfx-base/GFXInputAssembler.h"
+#include "renderer/gfx-base/GFXSampler.h"
+#include "renderer/gfx-base/GFXTexture.h"
+#include "renderer/pipeline/Define.h"
+#include "scene/DrawBatch2D.h"
+#include "scene/Pass.h"
+#include "scene/RenderScene.h"
+
+namespace cc {
+namespace {
+constexpr uint MAX_VERTEX_COUNT     = 65535;
+constexpr uint INITIAL_VERTEX_COUNT = 4096;
+constexpr uint VERTEX_STRIDE        = UIRenderer::VERTEX_FLOATS * sizeof(float);
+
+const gfx::AttributeList ATTRIBUTES = {
+    {"a_position", gfx::Format::RGB32F},
+    {"a_texCoord", gfx::Format::RG32F},
+    {"a_color", gfx::Format::RGBA32F},
+};
+
+template <typename T>
+void destroyObject(T *&object) {
+    CC_SAFE_DESTROY(object);
+    CC_SAFE_DELETE(object);
+}
+
+// Buffer updates are issued in 4 byte units, grows by doubling
+void ensureBufferSize(gfx::Buffer *buffer, uint size) {
+    if (buffer->getSize() >= size) {
+        return;
+    }
+    auto newSize = buffer->getSize();
+    while (newSize < size) {
+        newSize *= 2;
+    }
+    buffer->resize(newSize);
+}
+} // namespace
+
+size_t Batcher2d::DescriptorSetKeyHasher::operator()(const DescriptorSetKey &key) const {
+    size_t seed = 3;
+    MathUtil::combineHash(seed, key.texture);
+    MathUtil::combineHash(seed, key.sampler);
+    MathUtil::combineHash(seed, key.layout);
+    return seed;
+}
+
+Batcher2d::Batcher2d(Root *root)
+: _root(root) {
+}
+
+Batcher2d::~Batcher2d() {
+    destroy();
+}
+
+bool Batcher2d::initialize() {
+    _device = _root->getDevice();
+    return _device != nullptr;
+}
+
+void Batcher2d::destroy() {
+    for (auto *meshBuffer : _meshBuffers) {
+        for (auto *inputAssembler : meshBuffer->inputAssemblers) {
+            destroyObject(inputAssembler);
+        }
+        destroyObject(meshBuffer->vertexBuffer);
+        destroyObject(meshBuffer->indexBuffer);
+        CC_DELETE(meshBuffer);
+    }
+    _meshBuffers.clear();
+    _usedMeshBuffers = 0;
+
+    for (auto *batch : _batches) {
+        CC_DELETE(batch);
+    }
+    _batches.clear();
+    _batchCount = 0;
+
+    for (auto &pair : _descriptorSets) {
+        destroyObject(pair.second);
+    }
+    _descriptorSets.clear();
+    _renderers.clear();
+}
+
+void Batcher2d::update() {
+    auto *scene = Director::getInstance()->getScene();
+    if (!scene || !scene->getRenderScene() || _renderers.empty()) {
+        return;
+    }
+
+    walk(scene, scene->getRenderScene());
+    flushBatch();
+}
+
+void Batcher2d::uploadBuffers() {
+    for (uint i = 0; i < _usedMeshBuffers; ++i) {
+        auto *meshBuffer = _meshBuffers[i];
+        if (meshBuffer->indices.empty()) {
+            continue;
+        }
+        // keep the index data 4 byte aligned, the padding index is never drawn
+        if (meshBuffer->indices.size() % 2) {
+            meshBuffer->indices.emplace_back(0);
+        }
+
+        const auto vertexSize = static_cast<uint>(meshBuffer->vertices.size() * sizeof(float));
+        const auto indexSize  = static_cast<uint>(meshBuffer->indices.size() * sizeof(uint16_t));
+        ensureBufferSize(meshBuffer->vertexBuffer, vertexSize);
+        ensureBufferSize(meshBuffer->indexBuffer, indexSize);
+        meshBuffer->vertexBuffer->update(meshBuffer->vertices.data(), vertexSize);
+        meshBuffer->indexBuffer->update(meshBuffer->indices.data(), indexSize);
+    }
+}
+
+void Batcher2d::reset() {
+    for (uint i = 0; i < _usedMeshBuffers; ++i) {
+        auto *meshBuffer = _meshBuffers[i];
+        meshBuffer->vertices.clear();
+        meshBuffer->indices.clear();
+        meshBuffer->usedInputAssemblers = 0;
+    }
+    _usedMeshBuffers = 0;
+    _batchCount      = 0;
+    _currBuffer      = nullptr;
+}
+
+void Batcher2d::addRenderer(Node *node, UIRenderer *renderer) {
+    _renderers[node].emplace_back(renderer);
+}
+
+void Batcher2d::removeRenderer(Node *node, UIRenderer *renderer) {
+    auto iter = _renderers.find(node);
+    if (iter == _renderers.end()) {
+        return;
+    }
+    auto &renderers = iter->second;
+    renderers.erase(std::remove(renderers.begin(), renderers.end(), renderer), renderers.end());
+    if (renderers.empty()) {
+        _renderers.erase(iter);
+    }
+}
+
+void Batcher2d::releaseDescriptorSetCache(gfx::Texture *texture) {
+    if (!texture) {
+        return;
+    }
+
+    const auto textureID = texture->getObjectID();
+    for (auto iter = _descriptorSets.begin(); iter != _descriptorSets.end();) {
+        if (iter->first.texture == textureID) {
+            destroyObject(iter->second);
+            iter = _descriptorSets.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void Batcher2d::walk(Node *node, scene::RenderScene *renderScene) {
+    if (!node->isActiveInHierarchy()) {
+        return;
+    }
+
+    auto iter = _renderers.find(node);
+    if (iter != _renderers.end()) {
+        for (auto *renderer : iter->second) {
+            commit(renderer, renderScene);
+        }
+    }
+
+    for (const auto &child : node->getChildren()) {
+        walk(child.get(), renderScene);
+    }
+}
+
+void Batcher2d::commit(UIRenderer *renderer, scene::RenderScene *renderScene) {
+    auto *      material    = renderer->getMaterial();
+    auto *      texture     = renderer->getRenderTexture();
+    auto *      sampler     = renderer->getSampler();
+    const auto &indices     = renderer->getIndices();
+    const auto  vertexCount = renderer->getVertexCount();
+    if (!material || material->getPasses().empty() || !texture || !sampler || !vertexCount || indices.empty()) {
+        return;
+    }
+    if (vertexCount > MAX_VERTEX_COUNT) {
+        CC_LOG_WARNING("UIRenderer with %u vertices exceeds the 2D batch limit.", vertexCount);
+        return;
+    }
+
+    const auto visFlags  = renderer->getNode()->getLayer();
+    const bool mergeable = _currBuffer &&
+                           _currScene == renderScene &&
+                           _currMaterial->getHash() == material->getHash() &&
+                           _currTexture == texture &&
+                           _currSampler == sampler &&
+                           _currVisFlags == visFlags &&
+                           _currBuffer->vertices.size() / UIRenderer::VERTEX_FLOATS + vertexCount <= MAX_VERTEX_COUNT;
+    if (!mergeable) {
+        flushBatch();
+        _currBuffer     = requestMeshBuffer(vertexCount);
+        _currScene      = renderScene;
+        _currMaterial   = material;
+        _currTexture    = texture;
+        _currSampler    = sampler;
+        _currVisFlags   = visFlags;
+        _currFirstIndex = static_cast<uint>(_currBuffer->indices.size());
+    }
+
+    const auto &worldVertices = renderer->getWorldVertices();
+    const auto  baseVertex    = static_cast<uint16_t>(_currBuffer->vertices.size() / UIRenderer::VERTEX_FLOATS);
+    _currBuffer->vertices.insert(_currBuffer->vertices.end(), worldVertices.begin(), worldVertices.end());
+    for (const auto index : indices) {
+        _currBuffer->indices.emplace_back(static_cast<uint16_t>(baseVertex + index));
+    }
+}
+
+void Batcher2d::flushBatch() {
+    if (!_currBuffer) {
+        return;
+    }
+
+    auto *     meshBuffer = _currBuffer;
+    const auto indexCount = static_cast<uint>(meshBuffer->indices.size()) - _currFirstIndex;
+    _currBuffer           = nullptr;
+    if (!indexCount) {
+        return;
+    }
+
+    auto *inputAssembler = requestInputAssembler(meshBuffer);
+    inputAssembler->setFirstIndex(_currFirstIndex);
+    inputAssembler->setIndexCount(indexCount);
+
+    if (_batchCount == _batches.size()) {
+        _batches.emplace_back(CC_NEW(scene::DrawBatch2D));
+    }
+    auto *batch           = _batches[_batchCount++];
+    batch->visFlags       = _currVisFlags;
+    batch->inputAssembler = inputAssembler;
+    batch->descriptorSet  = getDescriptorSet(_currMaterial, _currTexture, _currSampler);
+    batch->passes.clear();
+    batch->shaders.clear();
+    for (const auto &pass : _currMaterial->getPasses()) {
+        batch->passes.emplace_back(pass.get());
+        batch->shaders.emplace_back(pass->getShaderVariant());
+    }
+
+    _currScene->addBatch(batch);
+}
+
+Batcher2d::MeshBuffer *Batcher2d::requestMeshBuffer(uint vertexCount) {
+    if (_usedMeshBuffers > 0) {
+        auto *meshBuffer = _meshBuffers[_usedMeshBuffers - 1];
+        if (meshBuffer->vertices.size() / UIRenderer::VERTEX_FLOATS + vertexCount <= MAX_VERTEX_COUNT) {
+            return meshBuffer;
+        }
+    }
+
+    if (_usedMeshBuffers == _meshBuffers.size()) {
+        auto *meshBuffer         = CC_NEW(MeshBuffer);
+        meshBuffer->vertexBuffer = _device->createBuffer({
+            gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
+            INITIAL_VERTEX_COUNT * VERTEX_STRIDE,
+            VERTEX_STRIDE,
+        });
+        meshBuffer->indexBuffer = _device->createBuffer({
+            gfx::BufferUsageBit::INDEX | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
+            INITIAL_VERTEX_COUNT * 6 / 4 * sizeof(uint16_t),
+            sizeof(uint16_t),
+        });
+        _meshBuffers.emplace_back(meshBuffer);
+    }
+
+    return _meshBuffers[_usedMeshBuffers++];
+}
+
+gfx::InputAssembler *Batcher2d::requestInputAssembler(MeshBuffer *meshBuffer) {
+    if (meshBuffer->usedInputAssemblers == meshBuffer->inputAssemblers.size()) {
+        meshBuffer->inputAssemblers.emplace_back(_device->createInputAssembler({
+            ATTRIBUTES,
+            {meshBuffer->vertexBuffer},
+            meshBuffer->indexBuffer,
+        }));
+    }
+
+    return meshBuffer->inputAssemblers[meshBuffer->usedInputAssemblers++];
+}
+
+gfx::DescriptorSet *Batcher2d::getDescriptorSet(Material *material, gfx::Texture *texture, gfx::Sampler *sampler) {
+    // materials with different local layouts can't share a set even for the same texture and sampler
+    auto *     layout = material->getPasses()[0]->getLocalSetLayout();
+    const auto key    = DescriptorSetKey{texture->getObjectID(), sampler->getObjectID(), layout->getObjectID()};
+    auto       iter   = _descriptorSets.find(key);
+    if (iter != _descriptorSets.end()) {
+        return iter->second;
+    }
+
+    auto *descriptorSet = _device->createDescriptorSet({layout});
+    descriptorSet->bindTexture(pipeline::SPRITETEXTURE::BINDING, texture);
+    descriptorSet->bindSampler(pipeline::SPRITETEXTURE::BINDING, sampler);
+    descriptorSet->update();
+    _descriptorSets.emplace(key, descriptorSet);
+    return descriptorSet;
+}
+
+} // namespace cc
@@ -0,0 +1,135 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include "base/TypeDef.h"
+
+namespace cc {
+
+class Root;
+class Node;
+class Material;
+class UIRenderer;
+
+namespace scene {
+class RenderScene;
+struct DrawBatch2D;
+} // namespace scene
+
+namespace gfx {
+class Buffer;
+class DescriptorSet;
+class DescriptorSetLayout;
+class Device;
+class InputAssembler;
+class Sampler;
+class Texture;
+} // namespace gfx
+
+/**
+ * Native 2D batcher.
+ * Walks the active nodes of the current scene every frame in hierarchy order, merges consecutive enabled UIRenderers sharing
+ * material, texture, sampler and visibility into DrawBatch2Ds over shared vertex and index buffers,
+ * and uploads those buffers once per frame before the pipeline renders.
+ * Root only drives it while native 2D batching is on, the script batcher draws the 2D components otherwise.
+ */
+class Batcher2d final {
+public:
+    explicit Batcher2d(Root *root);
+    ~Batcher2d();
+
+    bool initialize();
+    void destroy();
+
+    void update();
+    void uploadBuffers();
+    void reset();
+
+    // Enabled UIRenderers register themselves, so the walk doesn't have to inspect every component
+    void addRenderer(Node *node, UIRenderer *renderer);
+    void removeRenderer(Node *node, UIRenderer *renderer);
+
+    // Drops the cached descriptor sets that bind a texture which is about to be destroyed
+    void releaseDescriptorSetCache(gfx::Texture *texture);
+
+    inline uint getBatchCount() const { return _batchCount; }
+
+private:
+    // uint16 indices, a buffer holds at most 65535 vertices
+    struct MeshBuffer {
+        gfx::Buffer *                      vertexBuffer{nullptr};
+        gfx::Buffer *                      indexBuffer{nullptr};
+        std::vector<float>                 vertices;
+        std::vector<uint16_t>              indices;
+        std::vector<gfx::InputAssembler *> inputAssemblers;
+        uint                               usedInputAssemblers{0};
+    };
+
+    struct DescriptorSetKey {
+        uint texture{0};
+        uint sampler{0};
+        uint layout{0};
+
+        bool operator==(const DescriptorSetKey &rhs) const {
+            return texture == rhs.texture && sampler == rhs.sampler && layout == rhs.layout;
+        }
+    };
+    struct DescriptorSetKeyHasher {
+        size_t operator()(const DescriptorSetKey &key) const;
+    };
+
+    void walk(Node *node, scene::RenderScene *renderScene);
+    void commit(UIRenderer *renderer, scene::RenderScene *renderScene);
+    void flushBatch();
+
+    MeshBuffer *         requestMeshBuffer(uint vertexCount);
+    gfx::InputAssembler *requestInputAssembler(MeshBuffer *meshBuffer);
+    gfx::DescriptorSet * getDescriptorSet(Material *material, gfx::Texture *texture, gfx::Sampler *sampler);
+
+    Root *       _root{nullptr};
+    gfx::Device *_device{nullptr};
+
+    std::vector<MeshBuffer *>                                                          _meshBuffers;
+    uint                                                                               _usedMeshBuffers{0};
+    std::vector<scene::DrawBatch2D *>                                                  _batches;
+    uint                                                                               _batchCount{0};
+    std::unordered_map<DescriptorSetKey, gfx::DescriptorSet *, DescriptorSetKeyHasher> _descriptorSets;
+    std::unordered_map<const Node *, std::vector<UIRenderer *>>                        _renderers;
+
+    // the batch being merged
+    scene::RenderScene *_currScene{nullptr};
+    Material *          _currMaterial{nullptr};
+    gfx::Texture *      _currTexture{nullptr};
+    gfx::Sampler *      _currSampler{nullptr};
+    uint                _currVisFlags{0};
+    MeshBuffer *        _currBuffer{nullptr};
+    uint                _currFirstIndex{0};
+};
+
+} // namespace cc
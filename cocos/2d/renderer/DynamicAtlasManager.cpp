@@ -0,0 +1,302 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/renderer/DynamicAtlasManager.h"
+
+#include <algorithm>
+#include "2d/renderer/Batcher2d.h"
+#include "core/Root.h"
+#include "renderer/gfx-base/GFXCommandBuffer.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/gfx-base/GFXQueue.h"
+#include "renderer/gfx-base/GFXTexture.h"
+#include "renderer/gfx-base/GFXTextureBarrier.h"
+
+namespace cc {
+namespace {
+DynamicAtlasManager *instance = nullptr;
+
+void destroyTexture(gfx::Texture *texture) {
+    texture->destroy();
+    CC_DELETE(texture);
+}
+} // namespace
+
+DynamicAtlasManager *DynamicAtlasManager::getInstance() {
+    if (instance == nullptr) {
+        instance = new DynamicAtlasManager();
+    }
+    return instance;
+}
+
+DynamicAtlasManager::~DynamicAtlasManager() {
+    reset();
+    if (_cmdBuffer) {
+        _cmdBuffer->destroy();
+        CC_DELETE(_cmdBuffer);
+    }
+    CC_SAFE_DELETE(_copyBarrier);
+}
+
+void DynamicAtlasManager::setEnabled(bool enabled) {
+    if (_enabled == enabled) {
+        return;
+    }
+    _enabled = enabled;
+    if (!enabled) {
+        reset();
+    }
+}
+
+const AtlasFrame *DynamicAtlasManager::insertTexture(gfx::Texture *texture) {
+    if (!_enabled || !texture || !isEligible(texture)) {
+        return nullptr;
+    }
+
+    auto iter = _entries.find(texture);
+    if (iter != _entries.end()) {
+        ++iter->second->refCount;
+        return &iter->second->frame;
+    }
+
+    auto entry          = std::make_unique<Entry>();
+    entry->source       = texture;
+    entry->frame.width  = texture->getWidth();
+    entry->frame.height = texture->getHeight();
+
+    bool packed = false;
+    for (auto &atlas : _atlases) {
+        if ((packed = pack(atlas.get(), entry.get(), texture, 0, 0))) break;
+    }
+    if (!packed && _atlases.size() < _maxAtlasCount) {
+        auto atlas     = std::make_unique<Atlas>(_textureSize);
+        atlas->texture = createPage();
+        packed         = pack(atlas.get(), entry.get(), texture, 0, 0);
+        _atlases.emplace_back(std::move(atlas));
+    }
+    if (!packed && defragment()) {
+        for (auto &atlas : _atlases) {
+            if ((packed = pack(atlas.get(), entry.get(), texture, 0, 0))) break;
+        }
+    }
+    if (!packed) {
+        return nullptr;
+    }
+
+    entry->refCount = 1;
+    auto *frame     = &entry->frame;
+    _entries.emplace(texture, std::move(entry));
+    return frame;
+}
+
+void DynamicAtlasManager::releaseTexture(gfx::Texture *texture) {
+    auto iter = _entries.find(texture);
+    if (iter == _entries.end() || --iter->second->refCount > 0) {
+        return;
+    }
+    eraseEntry(iter);
+}
+
+void DynamicAtlasManager::removeTexture(gfx::Texture *texture) {
+    auto iter = _entries.find(texture);
+    if (iter != _entries.end()) {
+        eraseEntry(iter);
+    }
+}
+
+void DynamicAtlasManager::eraseEntry(EntryMap::iterator iter) {
+    auto *texture = iter->first;
+    auto *entry   = iter->second.get();
+    auto *atlas = entry->atlas;
+    atlas->liveArea -= (entry->frame.width + PADDING) * (entry->frame.height + PADDING);
+    if (atlas->liveArea == 0) {
+        atlas->packer.reset();
+    }
+
+    // the source may be destroyed before the next update
+    _pendingCopies.erase(std::remove_if(_pendingCopies.begin(), _pendingCopies.end(), [texture](const PendingCopy &copy) {
+                             return copy.src == texture;
+                         }),
+                         _pendingCopies.end());
+    _entries.erase(iter);
+}
+
+const AtlasFrame *DynamicAtlasManager::getFrame(gfx::Texture *texture) const {
+    auto iter = _entries.find(texture);
+    return iter != _entries.end() ? &iter->second->frame : nullptr;
+}
+
+void DynamicAtlasManager::update() {
+    auto *device = gfx::Device::getInstance();
+    if (!_pendingCopies.empty()) {
+        if (!_cmdBuffer) {
+            _cmdBuffer   = device->createCommandBuffer({device->getQueue()});
+            _copyBarrier = device->createTextureBarrier({{gfx::AccessType::TRANSFER_WRITE}, {gfx::AccessType::TRANSFER_READ}});
+        }
+
+        // defragmentation reads a page that earlier copies in the list may still be writing
+        std::vector<gfx::Texture *> written;
+        _cmdBuffer->begin();
+        for (const auto &copy : _pendingCopies) {
+            auto iter = std::find(written.begin(), written.end(), copy.src);
+            if (iter != written.end()) {
+                _cmdBuffer->pipelineBarrier(nullptr, &_copyBarrier, &copy.src, 1);
+                written.erase(iter);
+            }
+            _cmdBuffer->blitTexture(copy.src, copy.dst, &copy.region, 1, gfx::Filter::POINT);
+            if (std::find(written.begin(), written.end(), copy.dst) == written.end()) {
+                written.emplace_back(copy.dst);
+            }
+        }
+        _cmdBuffer->end();
+        device->flushCommands(&_cmdBuffer, 1);
+        device->getQueue()->submit(&_cmdBuffer, 1);
+        _pendingCopies.clear();
+    }
+
+    for (auto *texture : _retiredPages) {
+        destroyTexture(texture);
+    }
+    _retiredPages.clear();
+}
+
+void DynamicAtlasManager::reset() {
+    _pendingCopies.clear();
+    _entries.clear();
+    for (auto &atlas : _atlases) {
+        retirePage(atlas->texture);
+    }
+    _atlases.clear();
+    for (auto *texture : _retiredPages) {
+        destroyTexture(texture);
+    }
+    _retiredPages.clear();
+}
+
+bool DynamicAtlasManager::isCandidate(gfx::TextureType type, gfx::Format format, uint width, uint height) const {
+    return _enabled &&
+           type == gfx::TextureType::TEX2D &&
+           format == gfx::Format::RGBA8 &&
+           width <= _maxFrameSize && height <= _maxFrameSize &&
+           width + PADDING <= _textureSize && height + PADDING <= _textureSize;
+}
+
+bool DynamicAtlasManager::isEligible(const gfx::Texture *texture) const {
+    return hasFlag(texture->getUsage(), gfx::TextureUsageBit::TRANSFER_SRC) &&
+           isCandidate(texture->getType(), texture->getFormat(), texture->getWidth(), texture->getHeight());
+}
+
+gfx::Texture *DynamicAtlasManager::createPage() const {
+    return gfx::Device::getInstance()->createTexture({
+        gfx::TextureType::TEX2D,
+        gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST | gfx::TextureUsageBit::TRANSFER_SRC,
+        gfx::Format::RGBA8,
+        _textureSize,
+        _textureSize,
+    });
+}
+
+bool DynamicAtlasManager::pack(Atlas *atlas, Entry *entry, gfx::Texture *src, uint srcX, uint srcY) {
+    auto &frame = entry->frame;
+    uint  x     = 0;
+    uint  y     = 0;
+    if (!atlas->packer.insert(frame.width + PADDING, frame.height + PADDING, &x, &y)) {
+        return false;
+    }
+
+    PendingCopy copy;
+    copy.src              = src;
+    copy.dst              = atlas->texture;
+    copy.region.srcOffset = {static_cast<int>(srcX), static_cast<int>(srcY), 0};
+    copy.region.srcExtent = {frame.width, frame.height, 1};
+    copy.region.dstOffset = {static_cast<int>(x), static_cast<int>(y), 0};
+    copy.region.dstExtent = {frame.width, frame.height, 1};
+    _pendingCopies.emplace_back(copy);
+
+    const auto size   = static_cast<float>(_textureSize);
+    frame.texture     = atlas->texture;
+    frame.x           = x;
+    frame.y           = y;
+    frame.uvTransform = {x / size, y / size, frame.width / size, frame.height / size};
+    entry->atlas      = atlas;
+    atlas->liveArea += (frame.width + PADDING) * (frame.height + PADDING);
+    return true;
+}
+
+bool DynamicAtlasManager::defragment() {
+    Atlas *target    = nullptr;
+    uint   bestWaste = 0;
+    for (auto &atlas : _atlases) {
+        const uint waste = atlas->packer.getUsedArea() - atlas->liveArea;
+        if (waste > bestWaste) {
+            target    = atlas.get();
+            bestWaste = waste;
+        }
+    }
+    if (!target) {
+        return false;
+    }
+
+    std::vector<Entry *> entries;
+    for (auto &pair : _entries) {
+        if (pair.second->atlas == target) {
+            entries.emplace_back(pair.second.get());
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry *lhs, const Entry *rhs) {
+        return lhs->frame.height > rhs->frame.height;
+    });
+
+    // dry run first, the old page stays untouched if the live frames do not fit again
+    SkylinePacker packer(_textureSize, _textureSize);
+    for (const auto *entry : entries) {
+        uint x = 0;
+        uint y = 0;
+        if (!packer.insert(entry->frame.width + PADDING, entry->frame.height + PADDING, &x, &y)) {
+            return false;
+        }
+    }
+
+    auto *oldPage   = target->texture;
+    target->texture = createPage();
+    target->packer.reset();
+    target->liveArea = 0;
+    for (auto *entry : entries) {
+        pack(target, entry, oldPage, entry->frame.x, entry->frame.y);
+        ++entry->frame.version;
+    }
+    retirePage(oldPage);
+    return true;
+}
+
+void DynamicAtlasManager::retirePage(gfx::Texture *texture) {
+    auto *batcher = Root::getInstance() ? Root::getInstance()->getBatcher2D() : nullptr;
+    if (batcher) {
+        batcher->releaseDescriptorSetCache(texture);
+    }
+    _retiredPages.emplace_back(texture);
+}
+
+} // namespace cc
@@ -0,0 +1,142 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "2d/renderer/SkylinePacker.h"
+#include "base/Macros.h"
+#include "math/Vec4.h"
+#include "renderer/gfx-base/GFXDef.h"
+
+namespace cc {
+
+namespace gfx {
+class CommandBuffer;
+class Texture;
+class TextureBarrier;
+} // namespace gfx
+
+struct AtlasFrame {
+    gfx::Texture *texture{nullptr}; // the atlas page
+    uint          x{0};
+    uint          y{0};
+    uint          width{0};
+    uint          height{0};
+    Vec4          uvTransform; // uv' = uv * zw + xy
+    uint          version{0};  // bumped whenever defragmentation moves the frame
+};
+
+/**
+ * Packs small 2D textures into shared RGBA8 atlas pages at runtime so that renderers using different
+ * textures can be merged into one batch. Texels are copied on the GPU at the start of the next frame.
+ * Released textures leave holes behind, when every page is full the page with the most unused area is
+ * defragmented into a fresh page and its frames are moved.
+ */
+class DynamicAtlasManager final {
+public:
+    static DynamicAtlasManager *getInstance();
+
+    static constexpr uint PADDING = 2;
+
+    DynamicAtlasManager() = default;
+    ~DynamicAtlasManager();
+
+    inline bool isEnabled() const { return _enabled; }
+    void        setEnabled(bool enabled);
+    inline uint getMaxAtlasCount() const { return _maxAtlasCount; }
+    inline void setMaxAtlasCount(uint count) { _maxAtlasCount = count; }
+    inline uint getTextureSize() const { return _textureSize; }
+    inline void setTextureSize(uint size) { _textureSize = size; }
+    inline uint getMaxFrameSize() const { return _maxFrameSize; }
+    inline void setMaxFrameSize(uint size) { _maxFrameSize = size; }
+    inline uint getAtlasCount() const { return static_cast<uint>(_atlases.size()); }
+
+    // Whether a texture with these properties could be packed, only candidates need TRANSFER_SRC usage
+    bool isCandidate(gfx::TextureType type, gfx::Format format, uint width, uint height) const;
+
+    // Returns the frame the texture is packed into, or nullptr when it is not eligible or does not fit.
+    // Every successful call must be paired with releaseTexture.
+    const AtlasFrame *insertTexture(gfx::Texture *texture);
+    void              releaseTexture(gfx::Texture *texture);
+    // Drops the entry whatever its reference count, invoked when the texture is destroyed
+    void              removeTexture(gfx::Texture *texture);
+    // Frames move on defragmentation and disappear on reset, so holders look them up again every frame
+    const AtlasFrame *getFrame(gfx::Texture *texture) const;
+
+    // Records and submits the pending copies, invoked once per frame by Root before rendering
+    void update();
+    void reset();
+
+private:
+    struct Atlas {
+        gfx::Texture *texture{nullptr};
+        SkylinePacker packer;
+        uint          liveArea{0};
+
+        explicit Atlas(uint size) : packer(size, size) {}
+    };
+
+    struct Entry {
+        AtlasFrame    frame;
+        gfx::Texture *source{nullptr};
+        Atlas *       atlas{nullptr};
+        uint          refCount{0};
+    };
+
+    struct PendingCopy {
+        gfx::Texture *   src{nullptr};
+        gfx::Texture *   dst{nullptr};
+        gfx::TextureBlit region;
+    };
+
+    using EntryMap = std::unordered_map<gfx::Texture *, std::unique_ptr<Entry>>;
+
+    bool          isEligible(const gfx::Texture *texture) const;
+    void          eraseEntry(EntryMap::iterator iter);
+    gfx::Texture *createPage() const;
+    bool          pack(Atlas *atlas, Entry *entry, gfx::Texture *src, uint srcX, uint srcY);
+    bool          defragment();
+    void          retirePage(gfx::Texture *texture);
+
+    std::vector<std::unique_ptr<Atlas>> _atlases;
+    EntryMap                            _entries;
+    std::vector<PendingCopy>            _pendingCopies;
+    std::vector<gfx::Texture *>         _retiredPages;
+    gfx::CommandBuffer *                _cmdBuffer{nullptr};
+    gfx::TextureBarrier *               _copyBarrier{nullptr};
+
+    bool _enabled{true};
+    uint _maxAtlasCount{5};
+    uint _textureSize{2048};
+    uint _maxFrameSize{512};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(DynamicAtlasManager);
+};
+
+} // namespace cc
@@ -0,0 +1,131 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/renderer/SkylinePacker.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace cc {
+
+SkylinePacker::SkylinePacker(uint width, uint height)
+: _width(width),
+  _height(height) {
+    reset();
+}
+
+void SkylinePacker::reset() {
+    _skyline.clear();
+    _skyline.push_back({0, 0, _width});
+    _usedArea = 0;
+}
+
+bool SkylinePacker::insert(uint width, uint height, uint *x, uint *y) {
+    if (!width || !height || width > _width || height > _height) {
+        return false;
+    }
+
+    size_t bestIndex  = _skyline.size();
+    uint   bestBottom = UINT_MAX;
+    uint   bestWidth  = UINT_MAX;
+    uint   bestY      = 0;
+    for (size_t i = 0; i < _skyline.size(); ++i) {
+        uint top = 0;
+        if (!fits(i, width, height, &top)) {
+            continue;
+        }
+        const uint bottom = top + height;
+        if (bottom < bestBottom || (bottom == bestBottom && _skyline[i].width < bestWidth)) {
+            bestIndex  = i;
+            bestBottom = bottom;
+            bestWidth  = _skyline[i].width;
+            bestY      = top;
+        }
+    }
+
+    if (bestIndex == _skyline.size()) {
+        return false;
+    }
+
+    *x = _skyline[bestIndex].x;
+    *y = bestY;
+    addSegment(bestIndex, *x, bestY, width, height);
+    _usedArea += width * height;
+    return true;
+}
+
+bool SkylinePacker::fits(size_t index, uint width, uint height, uint *y) const {
+    const uint x = _skyline[index].x;
+    if (x + width > _width) {
+        return false;
+    }
+
+    // the rectangle rests on the highest segment it spans
+    uint top       = 0;
+    uint remaining = width;
+    for (size_t i = index; remaining > 0 && i < _skyline.size(); ++i) {
+        top = std::max(top, _skyline[i].y);
+        if (top + height > _height) {
+            return false;
+        }
+        remaining -= std::min(remaining, _skyline[i].width);
+    }
+
+    *y = top;
+    return true;
+}
+
+void SkylinePacker::addSegment(size_t index, uint x, uint y, uint width, uint height) {
+    _skyline.insert(_skyline.begin() + static_cast<std::ptrdiff_t>(index), {x, y + height, width});
+
+    // cut the segments now covered by the new one
+    const uint right = x + width;
+    for (size_t i = index + 1; i < _skyline.size();) {
+        auto &segment = _skyline[i];
+        if (segment.x >= right) {
+            break;
+        }
+        const uint overlap = right - segment.x;
+        if (segment.width <= overlap) {
+            _skyline.erase(_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+            continue;
+        }
+        segment.x += overlap;
+        segment.width -= overlap;
+        break;
+    }
+
+    // merge neighbours at the same height
+    for (size_t i = 0; i + 1 < _skyline.size();) {
+        if (_skyline[i].y == _skyline[i + 1].y) {
+            _skyline[i].width += _skyline[i + 1].width;
+            _skyline.erase(_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+        } else {
+            ++i;
+        }
+    }
+}
+
+} // namespace cc
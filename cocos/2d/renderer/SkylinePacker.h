@@ -0,0 +1,66 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "base/TypeDef.h"
+
+namespace cc {
+
+/**
+ * Skyline rectangle packer.
+ * Keeps the top contour of the packed rectangles as horizontal segments and places every new rectangle
+ * where it ends lowest, preferring the narrowest segment on ties.
+ */
+class SkylinePacker final {
+public:
+    SkylinePacker(uint width, uint height);
+
+    bool insert(uint width, uint height, uint *x, uint *y);
+    void reset();
+
+    inline uint getWidth() const { return _width; }
+    inline uint getHeight() const { return _height; }
+    inline uint getUsedArea() const { return _usedArea; }
+
+private:
+    struct Segment {
+        uint x{0};
+        uint y{0};
+        uint width{0};
+    };
+
+    bool fits(size_t index, uint width, uint height, uint *y) const;
+    void addSegment(size_t index, uint x, uint y, uint width, uint height);
+
+    std::vector<Segment> _skyline;
+    uint                 _width{0};
+    uint                 _height{0};
+    uint                 _usedArea{0};
+};
+
+} // namespace cc
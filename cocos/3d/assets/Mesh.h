@@ -161,7 +161,7 @@ public:
         Uint8Array data;
     };
 
-    Mesh()           = default;
+    Mesh() { enableThreadSafeRefCount(); }
     ~Mesh() override = default;
 
     cc::any getNativeAsset() const override;
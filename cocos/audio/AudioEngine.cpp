@@ -27,6 +27,7 @@
 #include "audio/include/AudioEngine.h"
 #include "base/Log.h"
 #include "base/Utils.h"
+#include "base/memory/TaggedMemoryTracker.h"
 #include "platform/FileUtils.h"
 
 #include <condition_variable>
@@ -189,6 +190,7 @@ bool AudioEngine::lazyInit() {
 }
 
 int AudioEngine::play2d(const std::string &filePath, bool loop, float volume, const AudioProfile *profile) {
+    CC_MEMORY_TAG_SCOPE(MemoryTag::AUDIO);
     int ret = AudioEngine::INVALID_AUDIO_ID;
 
     do {
@@ -527,6 +529,7 @@ AudioProfile *AudioEngine::getProfile(const std::string &name) {
 }
 
 void AudioEngine::preload(const std::string &filePath, const std::function<void(bool isSuccess)> &callback) {
+    CC_MEMORY_TAG_SCOPE(MemoryTag::AUDIO);
     if (!isEnabled()) {
         callback(false);
         return;
@@ -27,6 +27,7 @@
 
 #include "Macros.h"
 #include <memory>
+#include "base/memory/SlabAllocator.h"
 
 namespace cc {
 
@@ -66,9 +66,12 @@
 
 #define CC_JOB_SYSTEM_TASKFLOW 1
 #define CC_JOB_SYSTEM_TBB      2
+#define CC_JOB_SYSTEM_NATIVE   3
 
 #if USE_JOB_SYSTEM_TBB
     #define CC_JOB_SYSTEM CC_JOB_SYSTEM_TBB
 #elif USE_JOB_SYSTEM_TASKFLOW
     #define CC_JOB_SYSTEM CC_JOB_SYSTEM_TASKFLOW
+#elif USE_JOB_SYSTEM_NATIVE
+    #define CC_JOB_SYSTEM CC_JOB_SYSTEM_NATIVE
 #endif
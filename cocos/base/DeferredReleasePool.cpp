@@ -26,21 +26,134 @@
 ****************************************************************************/
 
 #include "base/DeferredReleasePool.h"
-#include "base/Log.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <vector>
+#include "base/Log.h"
+#include "base/threading/MPMCQueue.h"
 namespace cc {
 
+namespace {
+
+enum class PendingAction : uint8_t {
+    RELEASE,
+    DESTROY,
+};
+
+struct PendingObject {
+    RefCounted *  object{nullptr};
+    PendingAction action{PendingAction::RELEASE};
+};
+
+constexpr size_t PENDING_QUEUE_CAPACITY = 4096;
+
+// Filled from any thread and drained by clear(), the overflow keeps producers from ever failing.
+struct PendingObjects {
+    MPMCQueue<PendingObject>  queue{PENDING_QUEUE_CAPACITY};
+    std::deque<PendingObject> overflow;
+    std::mutex                overflowMutex;
+    std::atomic<uint32_t>     overflowNum{0};
+};
+
+// Created on first use and never destroyed, other threads may still release objects during static destruction.
+PendingObjects &getPendingObjects() {
+    static auto *pending = new PendingObjects();
+    return *pending;
+}
+
+// Recorded by setMainThread() at startup. An embedder that never calls it hands the role to the first thread using the pool.
+std::atomic<std::thread::id> &getMainThread() {
+    static std::atomic<std::thread::id> mainThread{std::thread::id()};
+    return mainThread;
+}
+
+bool isMainThread() {
+    auto &                mainThread = getMainThread();
+    const std::thread::id current    = std::this_thread::get_id();
+    std::thread::id       recorded   = mainThread.load(std::memory_order_relaxed);
+    if (recorded == std::thread::id()) {
+        // on failure recorded holds the thread which claimed the role first
+        return mainThread.compare_exchange_strong(recorded, current, std::memory_order_relaxed) || recorded == current;
+    }
+    return recorded == current;
+}
+
+void pushPendingObject(const PendingObject &item) {
+    auto &pending = getPendingObjects();
+    if (!pending.queue.tryPush(item)) {
+        std::lock_guard<std::mutex> lock(pending.overflowMutex);
+        pending.overflow.push_back(item);
+        pending.overflowNum.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void processPendingObject(const PendingObject &item) {
+    if (item.action == PendingAction::RELEASE) {
+        item.object->release();
+    } else {
+        delete item.object;
+    }
+}
+
+void drainPendingObjects() {
+    auto &pending = getPendingObjects();
+
+    // bounded, objects pushed by other threads meanwhile wait for the next frame
+    PendingObject item;
+    for (size_t i = 0; i < pending.queue.capacity() && pending.queue.tryPop(&item); ++i) {
+        processPendingObject(item);
+    }
+
+    if (pending.overflowNum.load(std::memory_order_acquire) > 0) {
+        std::deque<PendingObject> overflow;
+        {
+            std::lock_guard<std::mutex> lock(pending.overflowMutex);
+            overflow.swap(pending.overflow);
+            pending.overflowNum.store(0, std::memory_order_relaxed);
+        }
+        for (const auto &overflowItem : overflow) {
+            processPendingObject(overflowItem);
+        }
+    }
+}
+
+} // namespace
+
 std::vector<RefCounted *> DeferredReleasePool::managedObjectArray{};
 
 void DeferredReleasePool::add(RefCounted *object) {
-    DeferredReleasePool::managedObjectArray.push_back(object);
+    if (isMainThread()) {
+        DeferredReleasePool::managedObjectArray.push_back(object);
+        return;
+    }
+
+    CC_ASSERT(object->isThreadSafeRefCount());
+    pushPendingObject({object, PendingAction::RELEASE});
+}
+
+void DeferredReleasePool::setMainThread() {
+    getMainThread().store(std::this_thread::get_id(), std::memory_order_relaxed);
 }
 
 void DeferredReleasePool::clear() {
+    CC_ASSERT(isMainThread());
+
     for (const auto &obj : DeferredReleasePool::managedObjectArray) {
         obj->release();
     }
     DeferredReleasePool::managedObjectArray.clear();
+
+    drainPendingObjects();
+}
+
+void DeferredReleasePool::destroy(RefCounted *object) {
+    if (isMainThread()) {
+        delete object;
+    } else {
+        pushPendingObject({object, PendingAction::DESTROY});
+    }
 }
 
 bool DeferredReleasePool::contains(RefCounted *object) {
@@ -33,15 +33,30 @@
 
 namespace cc {
 
+/**
+ * Releases objects once per frame, clear() is called by the application on the main thread,
+ * which Application::init() records through setMainThread().
+ * Objects with thread safe reference counts may also be added on other threads. They go into
+ * a lock-free queue which clear() drains, and so do such objects whose last reference was
+ * released off the main thread; their destructors always run on the main thread.
+ */
 class CC_DLL DeferredReleasePool {
 public:
 
+    // the calling thread becomes the one clear() runs on, call it before objects are added from other threads
+    static void setMainThread();
+
     static void add(RefCounted *object);
     static void clear();
 
+    // Deletes an object whose thread safe count dropped to zero, right away on the main thread
+    // and in the next clear() on other threads.
+    static void destroy(RefCounted *object);
+
 
     /**
      * Checks whether the autorelease pool contains the specified object.
+     * Objects added on other threads are not looked at.
      *
      * @param object The object to be checked.
      * @return True if the autorelease pool contains the object, false if not
@@ -0,0 +1,143 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cc {
+
+template <typename Signature, size_t Capacity>
+class InplaceFunction;
+
+/**
+ * Move-only std::function replacement with small buffer storage.
+ * Callables up to Capacity bytes are constructed in place, larger ones fall back to the heap,
+ * so wrapping the usual lambdas and binds doesn't allocate.
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> final {
+public:
+    InplaceFunction() noexcept = default;
+    InplaceFunction(std::nullptr_t) noexcept {} // NOLINT(google-explicit-constructor)
+
+    template <typename Function, typename = std::enable_if_t<!std::is_same<std::decay_t<Function>, InplaceFunction>::value>>
+    InplaceFunction(Function &&func) { // NOLINT(google-explicit-constructor)
+        construct(std::forward<Function>(func), IsInline<std::decay_t<Function>>{});
+    }
+
+    InplaceFunction(InplaceFunction &&rhs) noexcept { moveFrom(rhs); }
+    InplaceFunction(const InplaceFunction &) = delete;
+    InplaceFunction &operator=(InplaceFunction &&rhs) noexcept {
+        if (this != &rhs) {
+            reset();
+            moveFrom(rhs);
+        }
+        return *this;
+    }
+    InplaceFunction &operator=(const InplaceFunction &) = delete;
+    ~InplaceFunction() { reset(); }
+
+    inline R operator()(Args... args) const { return _ops->invoke(_storage, std::forward<Args>(args)...); }
+
+    inline explicit operator bool() const noexcept { return _ops != nullptr; }
+
+    inline void reset() noexcept {
+        if (_ops) {
+            _ops->destroy(_storage);
+            _ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        R (*invoke)(void *storage, Args &&...args);
+        void (*move)(void *dst, void *src);
+        void (*destroy)(void *storage);
+    };
+
+    template <typename Function>
+    struct InlineOps {
+        static R invoke(void *storage, Args &&...args) { return (*static_cast<Function *>(storage))(std::forward<Args>(args)...); }
+        static void move(void *dst, void *src) {
+            new (dst) Function(std::move(*static_cast<Function *>(src)));
+            static_cast<Function *>(src)->~Function();
+        }
+        static void      destroy(void *storage) { static_cast<Function *>(storage)->~Function(); }
+        static const Ops ops;
+    };
+
+    template <typename Function>
+    struct HeapOps {
+        static Function *&get(void *storage) { return *static_cast<Function **>(storage); }
+        static R          invoke(void *storage, Args &&...args) { return (*get(storage))(std::forward<Args>(args)...); }
+        static void       move(void *dst, void *src) { new (dst) Function *(get(src)); }
+        static void       destroy(void *storage) { delete get(storage); }
+        static const Ops  ops;
+    };
+
+    template <typename Function>
+    using IsInline = std::integral_constant<bool, sizeof(Function) <= Capacity &&
+                                                      alignof(Function) <= alignof(std::max_align_t) &&
+                                                      std::is_nothrow_move_constructible<Function>::value>;
+
+    template <typename Function>
+    void construct(Function &&func, std::true_type /*isInline*/) {
+        new (_storage) std::decay_t<Function>(std::forward<Function>(func));
+        _ops = &InlineOps<std::decay_t<Function>>::ops;
+    }
+
+    template <typename Function>
+    void construct(Function &&func, std::false_type /*isInline*/) {
+        new (_storage) std::decay_t<Function> *(new std::decay_t<Function>(std::forward<Function>(func)));
+        _ops = &HeapOps<std::decay_t<Function>>::ops;
+    }
+
+    inline void moveFrom(InplaceFunction &rhs) noexcept {
+        if (rhs._ops) {
+            rhs._ops->move(_storage, rhs._storage);
+            _ops     = rhs._ops;
+            rhs._ops = nullptr;
+        }
+    }
+
+    static_assert(Capacity >= sizeof(void *), "InplaceFunction needs room for at least a pointer");
+
+    alignas(std::max_align_t) mutable unsigned char _storage[Capacity];
+    const Ops *                                     _ops{nullptr};
+};
+
+template <typename R, typename... Args, size_t Capacity>
+template <typename Function>
+const typename InplaceFunction<R(Args...), Capacity>::Ops InplaceFunction<R(Args...), Capacity>::InlineOps<Function>::ops = {&invoke, &move, &destroy};
+
+template <typename R, typename... Args, size_t Capacity>
+template <typename Function>
+const typename InplaceFunction<R(Args...), Capacity>::Ops InplaceFunction<R(Args...), Capacity>::HeapOps<Function>::ops = {&invoke, &move, &destroy};
+
+} // namespace cc
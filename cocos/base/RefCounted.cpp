@@ -26,6 +26,7 @@
 ****************************************************************************/
 
 #include "base/RefCounted.h"
+#include "base/DeferredReleasePool.h"
 
 #if CC_REF_LEAK_DETECTION
     #include <algorithm> // std::find
@@ -46,6 +47,21 @@ RefCounted::RefCounted() {
 #endif
 }
 
+// copies keep the counting behaviour of a plain counter member
+RefCounted::RefCounted(const RefCounted &other)
+: _referenceCount(other._referenceCount.load(std::memory_order_relaxed)),
+  _threadSafeRefCount(other._threadSafeRefCount) {
+#if CC_REF_LEAK_DETECTION
+    trackRef(this);
+#endif
+}
+
+RefCounted &RefCounted::operator=(const RefCounted &other) {
+    _referenceCount.store(other._referenceCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _threadSafeRefCount = other._threadSafeRefCount;
+    return *this;
+}
+
 RefCounted::~RefCounted() {
 #if CC_REF_LEAK_DETECTION
     untrackRef(this);
@@ -53,20 +69,35 @@ RefCounted::~RefCounted() {
 }
 
 void RefCounted::addRef() {
-    ++_referenceCount;
+    if (_threadSafeRefCount) {
+        _referenceCount.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        // a relaxed load and store cost the same as a plain increment
+        _referenceCount.store(_referenceCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
 }
 
 void RefCounted::release() {
-    CC_ASSERT(_referenceCount > 0);
-    --_referenceCount;
+    if (_threadSafeRefCount) {
+        const unsigned int previous = _referenceCount.fetch_sub(1, std::memory_order_acq_rel);
+        CC_ASSERT(previous > 0);
+        if (previous == 1) {
+            DeferredReleasePool::destroy(this);
+        }
+        return;
+    }
+
+    const unsigned int count = _referenceCount.load(std::memory_order_relaxed);
+    CC_ASSERT(count > 0);
+    _referenceCount.store(count - 1, std::memory_order_relaxed);
 
-    if (_referenceCount == 0) {
+    if (count == 1) {
         delete this;
     }
 }
 
 unsigned int RefCounted::getRefCount() const {
-    return _referenceCount;
+    return _referenceCount.load(std::memory_order_relaxed);
 }
 
 #if CC_REF_LEAK_DETECTION
@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <atomic>
 #include "base/Config.h"
 #include "base/Macros.h"
 
@@ -50,6 +51,12 @@ public:
 /**
  * Ref is used for reference count management. If a class inherits from Ref,
  * then it is easy to be shared in different places.
+ *
+ * Counting is single threaded by default. Classes whose objects are retained and released
+ * on other threads, e.g. assets filled in by async loading, call enableThreadSafeRefCount()
+ * in their constructor. Their counts are then updated atomically, and an object whose last
+ * reference is dropped off the main thread is deleted by DeferredReleasePool::clear() on the
+ * main thread instead.
  */
 class CC_DLL RefCounted {
 public:
@@ -83,6 +90,8 @@ public:
      */
     unsigned int getRefCount() const;
 
+    inline bool isThreadSafeRefCount() const { return _threadSafeRefCount; }
+
 protected:
     /**
      * Constructor
@@ -90,10 +99,16 @@ protected:
      * The Ref's reference count is 1 after construction.
      */
     RefCounted();
+    RefCounted(const RefCounted &other);
+    RefCounted &operator=(const RefCounted &other);
+
+    // must be called before the object is shared, i.e. in the constructor
+    inline void enableThreadSafeRefCount() { _threadSafeRefCount = true; }
 
 protected:
-    /// count of references
-    unsigned int _referenceCount{0};
+    /// count of references, only updated with atomic read-modify-writes in the thread safe mode
+    std::atomic<unsigned int> _referenceCount{0};
+    bool                      _threadSafeRefCount{false};
 
     // Memory leak diagnostic data (only included when CC_REF_LEAK_DETECTION is defined and its value isn't zero)
 #if CC_REF_LEAK_DETECTION
@@ -30,6 +30,7 @@
 #include "base/Scheduler.h"
 
 #include <algorithm>
+#include <chrono>
 #include <vector>
 
 #include "base/Log.h"
@@ -38,8 +39,12 @@
 
 namespace {
 constexpr unsigned CC_REPEAT_FOREVER{UINT_MAX - 1};
-constexpr int      MAX_FUNC_TO_PERFORM{30};
 constexpr int      INITIAL_TIMER_COUND{10};
+constexpr size_t   FUNCTION_QUEUE_CAPACITY{2048};
+
+int64_t getSteadyTime() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 } // namespace
 
 namespace cc {
@@ -125,9 +130,8 @@ void TimerTargetCallback::cancel() {
 
 // implementation of Scheduler
 
-Scheduler::Scheduler() {
-    // I don't expect to have more than 30 functions to all per frame
-    _functionsToPerform.reserve(MAX_FUNC_TO_PERFORM);
+Scheduler::Scheduler()
+: _functionsToPerform(FUNCTION_QUEUE_CAPACITY) {
 }
 
 Scheduler::~Scheduler() {
@@ -142,7 +146,7 @@ void Scheduler::removeHashElement(HashTimerEntry *element) {
         element->timers.clear();
 
         _hashForTimers.erase(element->target);
-        free(element);
+        delete element;
     }
 }
 
@@ -322,15 +326,84 @@ bool Scheduler::isTargetPaused(void *target) {
     return false; // should never get here
 }
 
-void Scheduler::performFunctionInCocosThread(const std::function<void()> &function) {
-    _performMutex.lock();
-    _functionsToPerform.push_back(function);
-    _performMutex.unlock();
+void Scheduler::pushFunctionToPerform(PerformFunction &&function) {
+    FunctionToPerform entry{std::move(function), getSteadyTime()};
+
+    const int pendingNum = _functionsToPerformNum.fetch_add(1) + 1;
+    int       maxNum     = _maxFunctionsToPerformNum.load(std::memory_order_relaxed);
+    while (pendingNum > maxNum && !_maxFunctionsToPerformNum.compare_exchange_weak(maxNum, pendingNum, std::memory_order_relaxed)) {
+    }
+
+    // once something overflowed keep pushing behind it, so the functions are still performed in order
+    if (_overflowFunctionNum.load() > 0 || !_functionsToPerform.tryPush(std::move(entry))) {
+        std::lock_guard<std::mutex> lock(_performMutex);
+        _overflowFunctionsToPerform.push_back(std::move(entry));
+        _overflowFunctionNum.fetch_add(1);
+    }
+}
+
+bool Scheduler::popFunctionToPerform(FunctionToPerform *entry) {
+    bool found = _functionsToPerform.tryPop(entry);
+    if (!found && _overflowFunctionNum.load() > 0) {
+        std::lock_guard<std::mutex> lock(_performMutex);
+        if (!_overflowFunctionsToPerform.empty()) {
+            *entry = std::move(_overflowFunctionsToPerform.front());
+            _overflowFunctionsToPerform.pop_front();
+            _overflowFunctionNum.fetch_sub(1);
+            found = true;
+        }
+    }
+    if (found) {
+        _functionsToPerformNum.fetch_sub(1);
+    }
+    return found;
 }
 
 void Scheduler::removeAllFunctionsToBePerformedInCocosThread() {
-    std::unique_lock<std::mutex> lock(_performMutex);
-    _functionsToPerform.clear();
+    FunctionToPerform entry;
+    while (popFunctionToPerform(&entry)) {
+        entry.function.reset();
+    }
+}
+
+Scheduler::PerformFunctionStats Scheduler::getPerformFunctionStats() const {
+    PerformFunctionStats stats;
+    stats.pendingCount    = static_cast<uint32_t>(std::max(_functionsToPerformNum.load(std::memory_order_relaxed), 0));
+    stats.maxPendingCount = static_cast<uint32_t>(_maxFunctionsToPerformNum.load(std::memory_order_relaxed));
+    stats.performedCount  = _performedFunctionNum;
+    stats.averageLatency  = _averagePerformLatency;
+    stats.maxLatency      = _maxPerformLatency;
+    return stats;
+}
+
+void Scheduler::performFunctions() {
+    // Functions queued by the performed ones wait for the next frame, it also keeps a function re-queueing itself from hanging the frame.
+    const int     functionNum = _functionsToPerformNum.load();
+    const int64_t budget      = static_cast<int64_t>(_performFunctionBudget * 1000000.F);
+    const int64_t start       = getSteadyTime();
+
+    FunctionToPerform entry;
+    int64_t           totalLatency = 0;
+    int64_t           maxLatency   = 0;
+    int               performed    = 0;
+    while (performed < functionNum && popFunctionToPerform(&entry)) {
+        const int64_t now     = getSteadyTime();
+        const int64_t latency = now - entry.queueTime;
+        totalLatency += latency;
+        maxLatency = std::max(maxLatency, latency);
+        ++performed;
+
+        entry.function();
+        entry.function.reset();
+
+        if (budget > 0 && getSteadyTime() - start >= budget) {
+            break;
+        }
+    }
+
+    _performedFunctionNum  = static_cast<uint32_t>(performed);
+    _averagePerformLatency = performed ? static_cast<float>(totalLatency) / static_cast<float>(performed) / 1000000.F : 0.F;
+    _maxPerformLatency     = static_cast<float>(maxLatency) / 1000000.F;
 }
 
 // main loop
@@ -382,17 +455,10 @@ void Scheduler::update(float dt) {
     // Functions allocated from another thread
     //
 
-    // Testing size is faster than locking / unlocking.
+    // Testing size is faster than polling the queues.
     // And almost never there will be functions scheduled to be called.
-    if (!_functionsToPerform.empty()) {
-        _performMutex.lock();
-        // fixed #4123: Save the callback functions, they must be invoked after '_performMutex.unlock()', otherwise if new functions are added in callback, it will cause thread deadlock.
-        auto temp = _functionsToPerform;
-        _functionsToPerform.clear();
-        _performMutex.unlock();
-        for (const auto &function : temp) {
-            function();
-        }
+    if (_functionsToPerformNum.load(std::memory_order_relaxed) > 0) {
+        performFunctions();
     }
 }
 
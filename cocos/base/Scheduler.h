@@ -29,14 +29,19 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
+#include "base/InplaceFunction.h"
 #include "base/RefCounted.h"
 #include "base/Vector.h"
+#include "base/memory/SlabAllocator.h"
+#include "base/threading/MPMCQueue.h"
 
 namespace cc {
 
@@ -78,6 +83,8 @@ protected:
 
 class CC_DLL TimerTargetCallback final : public Timer {
 public:
+    CC_SLAB_ALLOCATED(TimerTargetCallback)
+
     TimerTargetCallback() = default;
 
     // Initializes a timer with a target, a lambda and an interval in seconds, repeat in number of times to repeat, delay in seconds.
@@ -255,12 +262,37 @@ public:
     std::set<void *> pauseAllTargetsWithMinPriority(int minPriority);
 
     /** Calls a function on the cocos2d thread. Useful when you need to call a cocos2d function from another thread.
-     This function is thread safe.
+     This function is thread safe and lock free, small callables are queued without allocating.
      @param function The function to be run in cocos2d thread.
      @since v3.0
      @js NA
      */
-    void performFunctionInCocosThread(const std::function<void()> &function);
+    template <typename Function>
+    void performFunctionInCocosThread(Function &&function) {
+        pushFunctionToPerform(PerformFunction(std::forward<Function>(function)));
+    }
+
+    /** Limits the time spent per frame running the functions queued with performFunctionInCocosThread.
+     The functions left over when the budget runs out are performed in the next frames, in order.
+     At least one function is performed per frame. There is no limit by default.
+     @param milliseconds The budget in milliseconds, 0 means no limit.
+     @js NA
+     */
+    inline void  setPerformFunctionBudget(float milliseconds) { _performFunctionBudget = milliseconds; }
+    inline float getPerformFunctionBudget() const { return _performFunctionBudget; }
+
+    struct PerformFunctionStats {
+        uint32_t pendingCount{0};    // functions waiting to be performed
+        uint32_t maxPendingCount{0}; // the most functions ever waiting at once
+        uint32_t performedCount{0};  // functions performed in the last frame
+        float    averageLatency{0};  // milliseconds from queueing to performing, over the last frame
+        float    maxLatency{0};      // milliseconds from queueing to performing, over the last frame
+    };
+
+    /** Gets the queue depth and latency counters of performFunctionInCocosThread.
+     @js NA
+     */
+    PerformFunctionStats getPerformFunctionStats() const;
 
     /**
      * Remove all pending functions queued to be performed with Scheduler::performFunctionInCocosThread
@@ -276,6 +308,8 @@ public:
 private:
     // Hash Element used for "selectors with interval"
     struct HashTimerEntry {
+        CC_SLAB_ALLOCATED(HashTimerEntry)
+
         Vector<Timer *> timers;
         void *          target;
         int             timerIndex;
@@ -284,9 +318,22 @@ private:
         bool            paused;
     };
 
+    static constexpr size_t PERFORM_FUNCTION_STORAGE_SIZE = 96;
+
+    using PerformFunction = InplaceFunction<void(), PERFORM_FUNCTION_STORAGE_SIZE>;
+
+    struct FunctionToPerform {
+        PerformFunction function;
+        int64_t         queueTime{0}; // steady clock, nanoseconds
+    };
+
     void removeHashElement(struct HashTimerEntry *element);
     void removeUpdateFromHash(struct _listEntry *entry);
 
+    void pushFunctionToPerform(PerformFunction &&function);
+    bool popFunctionToPerform(FunctionToPerform *entry);
+    void performFunctions();
+
     // update specific
 
     // Used for "selectors with interval"
@@ -296,9 +343,17 @@ private:
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
     bool _updateHashLocked = false;
 
-    // Used for "perform Function"
-    std::vector<std::function<void()>> _functionsToPerform;
-    std::mutex                         _performMutex;
+    // Used for "perform Function", the mutex only guards the overflow when the lock-free queue is full
+    MPMCQueue<FunctionToPerform>  _functionsToPerform;
+    std::deque<FunctionToPerform> _overflowFunctionsToPerform;
+    std::mutex                    _performMutex;
+    std::atomic<int>              _overflowFunctionNum{0};
+    std::atomic<int>              _functionsToPerformNum{0};
+    std::atomic<int>              _maxFunctionsToPerformNum{0};
+    float                         _performFunctionBudget{0};
+    uint32_t                      _performedFunctionNum{0};
+    float                         _averagePerformLatency{0};
+    float                         _maxPerformLatency{0};
 };
 
 // end of base group
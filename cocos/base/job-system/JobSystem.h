@@ -39,6 +39,14 @@ using JobToken  = TBBJobToken;
 using JobGraph  = TBBJobGraph;
 using JobSystem = TBBJobSystem;
 } // namespace cc
+#elif CC_JOB_SYSTEM == CC_JOB_SYSTEM_NATIVE
+    #include "job-system-native/NativeJobGraph.h"
+    #include "job-system-native/NativeJobSystem.h"
+namespace cc {
+using JobToken  = NativeJobToken;
+using JobGraph  = NativeJobGraph;
+using JobSystem = NativeJobSystem;
+} // namespace cc
 #else
     #include "job-system-dummy/DummyJobGraph.h"
     #include "job-system-dummy/DummyJobSystem.h"
@@ -0,0 +1,162 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "JobTracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include "base/StringUtil.h"
+
+namespace cc {
+
+namespace {
+JobTracer *instance = nullptr;
+
+const auto            EPOCH = std::chrono::steady_clock::now();
+std::atomic<uint64_t> generationCounter{0};
+thread_local uint64_t bufferGeneration = 0;
+thread_local void *   threadBuffer     = nullptr;
+
+void appendEscaped(std::string &out, const char *str) {
+    for (const char *c = str; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out += '\\';
+        }
+        out += *c;
+    }
+}
+
+inline double toMicroseconds(uint64_t ns) {
+    return static_cast<double>(ns) / 1000.0;
+}
+} // namespace
+
+JobTracer::JobTracer()
+: _generation(++generationCounter) {
+}
+
+JobTracer *JobTracer::getInstance() {
+    if (instance == nullptr) {
+        instance = new JobTracer();
+    }
+    return instance;
+}
+
+void JobTracer::destroyInstance() {
+    delete instance;
+    instance = nullptr;
+}
+
+uint64_t JobTracer::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - EPOCH).count());
+}
+
+JobTracer::ThreadBuffer *JobTracer::getThreadBuffer() {
+    if (bufferGeneration != _generation) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _buffers.emplace_back(std::make_unique<ThreadBuffer>());
+        auto *buffer  = _buffers.back().get();
+        buffer->index = static_cast<uint32_t>(_buffers.size() - 1);
+        buffer->events.resize(RING_CAPACITY);
+        bufferGeneration = _generation;
+        threadBuffer     = buffer;
+    }
+    return static_cast<ThreadBuffer *>(threadBuffer);
+}
+
+void JobTracer::record(const JobTraceEvent &event) {
+    auto *buffer                                     = getThreadBuffer();
+    buffer->worker                                   = event.worker;
+    buffer->events[buffer->recorded % RING_CAPACITY] = event;
+    ++buffer->recorded;
+}
+
+void JobTracer::recordSteal() {
+    ++getThreadBuffer()->steals;
+}
+
+uint64_t JobTracer::getStealCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint64_t                    steals = 0;
+    for (const auto &buffer : _buffers) {
+        steals += buffer->steals;
+    }
+    return steals;
+}
+
+void JobTracer::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &buffer : _buffers) {
+        buffer->recorded = 0;
+        buffer->steals   = 0;
+    }
+}
+
+std::string JobTracer::exportChromeTrace() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::string out      = "{\"traceEvents\":[";
+    bool        first    = true;
+    auto        separate = [&]() {
+        if (!first) out += ',';
+        first = false;
+    };
+
+    for (const auto &buffer : _buffers) {
+        const uint64_t count = std::min<uint64_t>(buffer->recorded, RING_CAPACITY);
+        if (!count && !buffer->steals) {
+            continue;
+        }
+
+        separate();
+        const String threadName = buffer->worker >= 0 ? StringUtil::format("Job Worker %d", buffer->worker)
+                                                      : StringUtil::format("Thread %u", buffer->index);
+        out += StringUtil::format(R"({"name":"thread_name","ph":"M","pid":0,"tid":%u,"args":{"name":"%s"}})",
+                                  buffer->index, threadName.c_str());
+
+        uint64_t lastEnd = 0;
+        for (uint64_t i = buffer->recorded - count; i < buffer->recorded; ++i) {
+            const auto &event = buffer->events[i % RING_CAPACITY];
+            separate();
+            out += R"({"name":")";
+            appendEscaped(out, event.name ? event.name : "job");
+            out += StringUtil::format(R"(","cat":"job","ph":"X","pid":0,"tid":%u,"ts":%.3f,"dur":%.3f,)"
+                                      R"("args":{"dependencyWaitUs":%.3f,"queueWaitUs":%.3f,"stolen":%s}})",
+                                      buffer->index, toMicroseconds(event.start), toMicroseconds(event.end - event.start),
+                                      toMicroseconds(event.ready - event.graphStart), toMicroseconds(event.start - event.ready),
+                                      event.stolen ? "true" : "false");
+            lastEnd = std::max(lastEnd, event.end);
+        }
+
+        separate();
+        out += StringUtil::format(R"({"name":"steals","ph":"C","pid":0,"tid":%u,"ts":%.3f,"args":{"steals":%llu}})",
+                                  buffer->index, toMicroseconds(lastEnd), static_cast<unsigned long long>(buffer->steals));
+    }
+
+    out += "]}";
+    return out;
+}
+
+} // namespace cc
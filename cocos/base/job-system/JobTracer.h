@@ -0,0 +1,96 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "cocos/base/Macros.h"
+
+namespace cc {
+
+struct JobTraceEvent {
+    const char *name{nullptr};
+    uint64_t    graphStart{0}; // the owning graph was run
+    uint64_t    ready{0};      // the last predecessor finished
+    uint64_t    start{0};
+    uint64_t    end{0};
+    int         worker{-1}; // -1 for threads outside of the job system
+    bool        stolen{false};
+};
+
+/**
+ * Optional job instrumentation.
+ * Every thread that executes jobs records into its own ring buffer, the oldest events are overwritten
+ * once it is full. The collected events export as Chrome trace JSON, which Perfetto opens as well.
+ * Recording costs a relaxed load per job while disabled.
+ */
+class JobTracer final {
+public:
+    static constexpr size_t RING_CAPACITY = 16384;
+
+    static JobTracer *getInstance();
+    static void       destroyInstance();
+
+    JobTracer();
+    ~JobTracer() = default;
+
+    // nanoseconds on a steady clock, the time base of every event
+    static uint64_t now();
+
+    inline bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+    inline void setEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+    void record(const JobTraceEvent &event);
+    void recordSteal();
+
+    // buffers are read without synchronization, export and clear while no job is running
+    std::string exportChromeTrace() const;
+    uint64_t    getStealCount() const;
+    void        clear();
+
+private:
+    struct ThreadBuffer {
+        uint32_t                   index{0};
+        int                        worker{-1};
+        std::vector<JobTraceEvent> events;
+        uint64_t                   recorded{0};
+        uint64_t                   steals{0};
+    };
+
+    ThreadBuffer *getThreadBuffer();
+
+    std::atomic<bool>                          _enabled{false};
+    mutable std::mutex                         _mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+    // tells thread local buffers of a destroyed tracer apart from ours, even at the same address
+    uint64_t                                   _generation{0};
+};
+
+} // namespace cc
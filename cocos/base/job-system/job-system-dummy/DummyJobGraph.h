@@ -131,10 +131,10 @@ public:
     ~DummyJobGraph() noexcept                  = default;
 
     template <typename Function>
-    uint createJob(Function &&func) noexcept;
+    uint createJob(Function &&func, const char *name = nullptr) noexcept;
 
     template <typename Function>
-    uint createForEachIndexJob(uint begin, uint end, uint step, Function &&func) noexcept;
+    uint createForEachIndexJob(uint begin, uint end, uint step, Function &&func, const char *name = nullptr) noexcept;
 
     void makeEdge(uint j1, uint j2);
 
@@ -147,12 +147,12 @@ private:
 };
 
 template <typename Function>
-uint DummyJobGraph::createJob(Function &&func) noexcept {
+uint DummyJobGraph::createJob(Function &&func, const char * /*name*/) noexcept {
     return static_cast<uint>(_dummyGraph.addNode(std::forward<Function>(func)));
 }
 
 template <typename Function>
-uint DummyJobGraph::createForEachIndexJob(uint begin, uint end, uint step, Function &&func) noexcept {
+uint DummyJobGraph::createForEachIndexJob(uint begin, uint end, uint step, Function &&func, const char * /*name*/) noexcept {
     return static_cast<uint>(_dummyGraph.addNode([callable = std::forward<Function>(func), first = begin, last = end, step = step]() {
         for (auto i = first; i < last; i += step) {
             callable(i);
@@ -0,0 +1,100 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CoreStd.h"
+
+#include <cassert>
+#include "NativeJobGraph.h"
+#include "NativeJobSystem.h"
+
+namespace cc {
+
+uint NativeJobGraph::addNode(std::function<void()> &&task, const char *name) {
+    _nodes.emplace_back();
+    auto &node = _nodes.back();
+    node.task  = std::move(task);
+    node.graph = this;
+    node.name  = name;
+    return static_cast<uint>(_nodes.size() - 1U);
+}
+
+void NativeJobGraph::makeEdge(uint j1, uint j2) {
+    assert(!_pending);
+    auto *exit = &_nodes[_jobs[j1].exit];
+    for (uint i = _jobs[j2].entryBegin; i < _jobs[j2].entryEnd; ++i) {
+        exit->successors.push_back(&_nodes[i]);
+        _nodes[i].predecessorCount++;
+    }
+}
+
+void NativeJobGraph::run() noexcept {
+    if (_pending || _nodes.empty()) return;
+
+    for (auto &node : _nodes) {
+        node.pendingPredecessors.store(node.predecessorCount, std::memory_order_relaxed);
+    }
+    _remainingJobs.store(static_cast<uint>(_nodes.size()));
+    _finished = false;
+    _pending  = true;
+    _runTime  = JobTracer::now();
+
+    for (auto &node : _nodes) {
+        if (!node.predecessorCount) {
+            _system->submit(&node);
+        }
+    }
+}
+
+void NativeJobGraph::waitForAll() {
+    if (!_pending) return;
+
+    NativeJobNode *job  = nullptr;
+    uint           idle = 0;
+    while (_remainingJobs.load(std::memory_order_acquire) > 0 && idle < NativeJobSystem::SPIN_COUNT) {
+        if (_system->findJob(&job)) {
+            _system->execute(job);
+            idle = 0;
+        } else {
+            std::this_thread::yield();
+            ++idle;
+        }
+    }
+
+    // nothing left to help with, block until the last job flags the graph finished,
+    // it still touches the graph until then so the flag is only set under the lock
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this]() { return _finished; });
+    _pending = false;
+}
+
+void NativeJobGraph::onJobFinished() {
+    if (_remainingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _finished = true;
+        _condition.notify_all();
+    }
+}
+
+} // namespace cc
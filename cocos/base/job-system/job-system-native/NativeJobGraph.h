@@ -0,0 +1,132 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <deque>
+#include "NativeJobSystem.h"
+
+namespace cc {
+
+class NativeJobGraph final {
+public:
+    explicit NativeJobGraph(NativeJobSystem *system) noexcept : _system(system) {}
+    NativeJobGraph(const NativeJobGraph &) = delete;
+    NativeJobGraph(NativeJobGraph &&)      = delete;
+    NativeJobGraph &operator=(const NativeJobGraph &) = delete;
+    NativeJobGraph &operator=(NativeJobGraph &&) = delete;
+    ~NativeJobGraph() { waitForAll(); }
+
+    // names only show up in JobTracer exports
+    template <typename Function>
+    uint createJob(Function &&func, const char *name = nullptr) noexcept;
+
+    template <typename Function>
+    uint createForEachIndexJob(uint begin, uint end, uint step, Function &&func, const char *name = nullptr) noexcept;
+
+    void makeEdge(uint j1, uint j2);
+
+    void run() noexcept;
+
+    // the calling thread executes queued jobs while it waits
+    void waitForAll();
+
+private:
+    friend class NativeJobSystem;
+
+    // a for-each job is split into several chunk nodes joined by one exit node
+    struct Job {
+        uint entryBegin{0};
+        uint entryEnd{0};
+        uint exit{0};
+    };
+
+    uint addNode(std::function<void()> &&task, const char *name);
+    void onJobFinished();
+
+    NativeJobSystem *_system{nullptr};
+
+    std::deque<NativeJobNode>              _nodes;          // existing nodes cannot be invalidated
+    std::deque<std::function<void(uint)>> _indexFunctions; // shared by the chunks of a for-each job
+    std::vector<Job>                       _jobs;
+
+    std::atomic<uint>       _remainingJobs{0};
+    uint64_t                _runTime{0};
+    bool                    _finished{true};
+    bool                    _pending{false};
+    std::mutex              _mutex;
+    std::condition_variable _condition;
+};
+
+template <typename Function>
+uint NativeJobGraph::createJob(Function &&func, const char *name) noexcept {
+    const uint node = addNode(std::forward<Function>(func), name);
+    _jobs.push_back({node, node + 1, node});
+    return static_cast<uint>(_jobs.size() - 1U);
+}
+
+template <typename Function>
+uint NativeJobGraph::createForEachIndexJob(uint begin, uint end, uint step, Function &&func, const char *name) noexcept {
+    const uint iterations = begin < end ? (end - begin + step - 1) / step : 0U;
+    if (iterations <= 1) {
+        auto task = [begin, end, step, callable = std::forward<Function>(func)]() {
+            for (auto i = begin; i < end; i += step) {
+                callable(i);
+            }
+        };
+        return createJob(std::move(task), name);
+    }
+
+    // a few chunks per worker leave room for stealing to even out uneven iterations
+    const uint chunkCount = std::min(iterations, std::max(_system->threadCount(), 1U) * 4U);
+    const uint chunkSize  = (iterations + chunkCount - 1) / chunkCount;
+
+    _indexFunctions.emplace_back(std::forward<Function>(func));
+    const auto *callable = &_indexFunctions.back();
+
+    const auto entryBegin = static_cast<uint>(_nodes.size());
+    for (uint first = 0; first < iterations; first += chunkSize) {
+        const uint chunkBegin = begin + first * step;
+        const uint chunkEnd   = begin + std::min(first + chunkSize, iterations) * step;
+        auto       task       = [callable, chunkBegin, chunkEnd, step]() {
+            for (auto i = chunkBegin; i < chunkEnd; i += step) {
+                (*callable)(i);
+            }
+        };
+        addNode(std::move(task), name);
+    }
+    const auto entryEnd = static_cast<uint>(_nodes.size());
+
+    const uint exit = addNode([]() {}, name);
+    for (uint i = entryBegin; i < entryEnd; ++i) {
+        _nodes[i].successors.push_back(&_nodes[exit]);
+        _nodes[exit].predecessorCount++;
+    }
+
+    _jobs.push_back({entryBegin, entryEnd, exit});
+    return static_cast<uint>(_jobs.size() - 1U);
+}
+
+} // namespace cc
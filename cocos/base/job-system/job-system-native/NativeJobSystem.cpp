@@ -0,0 +1,167 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CoreStd.h"
+
+#include "NativeJobGraph.h"
+#include "NativeJobSystem.h"
+
+namespace cc {
+
+NativeJobSystem *NativeJobSystem::instance = nullptr;
+
+namespace {
+// index of the worker owning the current thread, -1 on threads outside of the job system
+thread_local int workerIndex = -1;
+} // namespace
+
+NativeJobSystem::NativeJobSystem(uint threadCount) noexcept {
+    _workers.reserve(threadCount);
+    for (uint i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(std::make_unique<Worker>());
+    }
+    // start the threads only after every deque exists, they steal from each other right away
+    for (uint i = 0; i < threadCount; ++i) {
+        _workers[i]->thread = std::thread(&NativeJobSystem::workerLoop, this, i);
+    }
+    CC_LOG_INFO("Native Job system initialized: %d worker threads", threadCount);
+}
+
+NativeJobSystem::~NativeJobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(_parkMutex);
+        _running.store(false);
+    }
+    _parkCondition.notify_all();
+    for (auto &worker : _workers) {
+        worker->thread.join();
+    }
+}
+
+void NativeJobSystem::submit(NativeJobNode *job) {
+    if (JobTracer::getInstance()->isEnabled()) {
+        job->readyTime = JobTracer::now();
+    }
+
+    if (workerIndex >= 0) {
+        _workers[workerIndex]->deque.push(job);
+    } else if (!_injectionQueue.tryPush(job)) {
+        // the injection queue is full, the submitting thread does the work itself
+        execute(job);
+        return;
+    }
+
+    _queuedJobs.fetch_add(1);
+    if (_sleepingWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(_parkMutex);
+        _parkCondition.notify_one();
+    }
+}
+
+bool NativeJobSystem::findJob(NativeJobNode **job) {
+    const auto workerCount = static_cast<int>(_workers.size());
+    if (workerIndex >= 0 && _workers[workerIndex]->deque.pop(job)) {
+        _queuedJobs.fetch_sub(1);
+        (*job)->stolen = false;
+        return true;
+    }
+    if (_injectionQueue.tryPop(job)) {
+        _queuedJobs.fetch_sub(1);
+        (*job)->stolen = false;
+        return true;
+    }
+    const int start = std::max(workerIndex, 0);
+    for (int i = 1; i <= workerCount; ++i) {
+        const int victim = (start + i) % workerCount;
+        if (victim != workerIndex && _workers[victim]->deque.steal(job)) {
+            _queuedJobs.fetch_sub(1);
+            (*job)->stolen = true;
+            auto *tracer   = JobTracer::getInstance();
+            if (tracer->isEnabled()) {
+                tracer->recordSteal();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void NativeJobSystem::execute(NativeJobNode *job) {
+    auto *tracer = JobTracer::getInstance();
+    if (tracer->isEnabled()) {
+        execute(job, tracer);
+    } else {
+        job->task();
+    }
+
+    for (auto *successor : job->successors) {
+        if (successor->pendingPredecessors.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            submit(successor);
+        }
+    }
+    job->graph->onJobFinished();
+}
+
+void NativeJobSystem::execute(NativeJobNode *job, JobTracer *tracer) {
+    JobTraceEvent event;
+    event.name       = job->name;
+    event.graphStart = job->graph->_runTime;
+    event.ready      = std::max(job->readyTime, event.graphStart); // tracing may have been enabled mid-graph
+    event.worker     = workerIndex;
+    event.stolen     = job->stolen;
+    event.start      = JobTracer::now();
+    job->task();
+    event.end = JobTracer::now();
+    tracer->record(event);
+}
+
+void NativeJobSystem::workerLoop(uint index) {
+    workerIndex = static_cast<int>(index);
+
+    NativeJobNode *job = nullptr;
+    while (_running.load(std::memory_order_relaxed)) {
+        bool found = false;
+        for (uint spin = 0; spin < SPIN_COUNT && !found; ++spin) {
+            found = findJob(&job);
+            if (!found) {
+                std::this_thread::yield();
+            }
+        }
+        if (found) {
+            execute(job);
+            continue;
+        }
+
+        // submitters bump _queuedJobs before checking _sleepingWorkers, so one of the two sides always sees the other
+        std::unique_lock<std::mutex> lock(_parkMutex);
+        _sleepingWorkers.fetch_add(1);
+        _parkCondition.wait(lock, [this]() {
+            return !_running.load() || _queuedJobs.load() > 0;
+        });
+        _sleepingWorkers.fetch_sub(1);
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,125 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../JobTracer.h"
+#include "WorkStealingDeque.h"
+#include "cocos/base/Macros.h"
+#include "cocos/base/TypeDef.h"
+#include "cocos/base/threading/MPMCQueue.h"
+
+namespace cc {
+
+using NativeJobToken = void;
+
+class NativeJobGraph;
+
+struct NativeJobNode final {
+    std::function<void()>        task;
+    std::vector<NativeJobNode *> successors;
+    uint                         predecessorCount{0};
+    std::atomic<uint>            pendingPredecessors{0};
+    NativeJobGraph *             graph{nullptr};
+
+    // JobTracer bookkeeping
+    const char *name{nullptr};
+    uint64_t    readyTime{0};
+    bool        stolen{false};
+};
+
+/**
+ * Work-stealing job system without third-party dependencies.
+ * Every worker owns a Chase-Lev deque: jobs made ready by a worker go to its own deque,
+ * jobs submitted from other threads go through a lock-free injection queue, and idle workers
+ * steal from each other before parking on a condition variable.
+ */
+class NativeJobSystem final {
+public:
+    static NativeJobSystem *getInstance() {
+        if (!instance) {
+            instance = new NativeJobSystem;
+        }
+        return instance;
+    }
+
+    static void destroyInstance() {
+        delete instance;
+        instance = nullptr;
+    }
+
+    NativeJobSystem() noexcept : NativeJobSystem(defaultThreadCount()) {}
+    explicit NativeJobSystem(uint threadCount) noexcept;
+    NativeJobSystem(const NativeJobSystem &) = delete;
+    NativeJobSystem(NativeJobSystem &&)      = delete;
+    NativeJobSystem &operator=(const NativeJobSystem &) = delete;
+    NativeJobSystem &operator=(NativeJobSystem &&) = delete;
+    ~NativeJobSystem();
+
+    inline uint threadCount() const { return static_cast<uint>(_workers.size()); }
+
+private:
+    friend class NativeJobGraph;
+
+    static constexpr size_t INJECTION_QUEUE_CAPACITY = 4096;
+    static constexpr uint   SPIN_COUNT               = 64;
+
+    static uint defaultThreadCount() {
+        const uint hardwareThreads = std::thread::hardware_concurrency();
+        return std::max(2U, hardwareThreads > 2U ? hardwareThreads - 2U : 0U);
+    }
+
+    struct Worker {
+        WorkStealingDeque<NativeJobNode *> deque;
+        std::thread                        thread;
+    };
+
+    void submit(NativeJobNode *job);
+    bool findJob(NativeJobNode **job);
+    void execute(NativeJobNode *job, JobTracer *tracer);
+    void execute(NativeJobNode *job);
+    void workerLoop(uint index);
+
+    static NativeJobSystem *instance;
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    MPMCQueue<NativeJobNode *>           _injectionQueue{INJECTION_QUEUE_CAPACITY};
+
+    std::atomic<int>        _queuedJobs{0};
+    std::atomic<uint>       _sleepingWorkers{0};
+    std::atomic<bool>       _running{true};
+    std::mutex              _parkMutex;
+    std::condition_variable _parkCondition;
+};
+
+} // namespace cc
@@ -0,0 +1,145 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cc {
+
+/**
+ * Chase-Lev work-stealing deque.
+ * The owning thread pushes and pops at the bottom, any other thread steals from the top.
+ * T must be trivially copyable, job pointers in practice.
+ */
+template <typename T>
+class WorkStealingDeque final {
+public:
+    explicit WorkStealingDeque(int64_t capacity = 256) : _ring(new Ring(capacity)) {}
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque(WorkStealingDeque &&)      = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(WorkStealingDeque &&) = delete;
+    ~WorkStealingDeque() { delete _ring.load(std::memory_order_relaxed); }
+
+    // owner only
+    void push(T item);
+    bool pop(T *out);
+
+    // any thread
+    bool steal(T *out);
+    bool empty() const;
+
+private:
+    struct Ring {
+        explicit Ring(int64_t cap) : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]) {}
+
+        inline T    load(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        inline void store(int64_t i, T item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+
+        Ring *grow(int64_t bottom, int64_t top) const {
+            auto *ring = new Ring(capacity * 2);
+            for (int64_t i = top; i < bottom; ++i) {
+                ring->store(i, load(i));
+            }
+            return ring;
+        }
+
+        int64_t                        capacity{0};
+        int64_t                        mask{0};
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    alignas(64) std::atomic<int64_t> _top{0};
+    alignas(64) std::atomic<int64_t> _bottom{0};
+    std::atomic<Ring *> _ring{nullptr};
+    // thieves may still be reading a ring that was replaced, keep them until the deque goes away
+    std::vector<std::unique_ptr<Ring>> _retired;
+};
+
+template <typename T>
+void WorkStealingDeque<T>::push(T item) {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    const int64_t top    = _top.load(std::memory_order_acquire);
+    Ring *        ring   = _ring.load(std::memory_order_relaxed);
+    if (bottom - top > ring->capacity - 1) {
+        _retired.emplace_back(ring);
+        ring = ring->grow(bottom, top);
+        _ring.store(ring, std::memory_order_release);
+    }
+    ring->store(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::pop(T *out) {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    Ring *        ring   = _ring.load(std::memory_order_relaxed);
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    *out = ring->load(bottom);
+    if (top == bottom) {
+        // last item, race the thieves for it
+        const bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::steal(T *out) {
+    int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = _bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return false;
+    }
+
+    T item = _ring.load(std::memory_order_acquire)->load(top);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return false;
+    }
+    *out = item;
+    return true;
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::empty() const {
+    return _top.load(std::memory_order_relaxed) >= _bottom.load(std::memory_order_relaxed);
+}
+
+} // namespace cc
@@ -37,10 +37,10 @@ public:
     explicit TFJobGraph(TFJobSystem *system) noexcept : _executor(&system->_executor) {}
 
     template <typename Function>
-    uint createJob(Function &&func) noexcept;
+    uint createJob(Function &&func, const char *name = nullptr) noexcept;
 
     template <typename Function>
-    uint createForEachIndexJob(uint begin, uint end, uint step, Function &&func) noexcept;
+    uint createForEachIndexJob(uint begin, uint end, uint step, Function &&func, const char *name = nullptr) noexcept;
 
     void makeEdge(uint j1, uint j2) noexcept;
 
@@ -64,13 +64,13 @@ private:
 };
 
 template <typename Function>
-uint TFJobGraph::createJob(Function &&func) noexcept {
+uint TFJobGraph::createJob(Function &&func, const char * /*name*/) noexcept {
     _tasks.emplace_back(_flow.emplace(func));
     return static_cast<uint>(_tasks.size() - 1u);
 }
 
 template <typename Function>
-uint TFJobGraph::createForEachIndexJob(uint begin, uint end, uint step, Function &&func) noexcept {
+uint TFJobGraph::createForEachIndexJob(uint begin, uint end, uint step, Function &&func, const char * /*name*/) noexcept {
     _tasks.emplace_back(_flow.for_each_index(begin, end, step, func));
     return static_cast<uint>(_tasks.size() - 1u);
 }
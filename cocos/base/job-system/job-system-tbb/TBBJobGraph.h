@@ -40,10 +40,10 @@ public:
     }
 
     template <typename Function>
-    uint createJob(Function &&func) noexcept;
+    uint createJob(Function &&func, const char *name = nullptr) noexcept;
 
     template <typename Function>
-    uint createForEachIndexJob(uint begin, uint end, uint step, Function &&func) noexcept;
+    uint createForEachIndexJob(uint begin, uint end, uint step, Function &&func, const char *name = nullptr) noexcept;
 
     void makeEdge(uint j1, uint j2) noexcept;
 
@@ -75,14 +75,14 @@ private:
 };
 
 template <typename Function>
-uint TBBJobGraph::createJob(Function &&func) noexcept {
+uint TBBJobGraph::createJob(Function &&func, const char * /*name*/) noexcept {
     _nodes.emplace_back(_graph, func);
     tbb::flow::make_edge(_nodes.front(), _nodes.back());
     return static_cast<uint>(_nodes.size() - 1u);
 }
 
 template <typename Function>
-uint TBBJobGraph::createForEachIndexJob(uint begin, uint end, uint step, Function &&func) noexcept {
+uint TBBJobGraph::createForEachIndexJob(uint begin, uint end, uint step, Function &&func, const char * /*name*/) noexcept {
     _nodes.emplace_back(_graph, [](TBBJobToken t) {});
     uint        predecessorIdx = static_cast<uint>(_nodes.size() - 1u);
     TBBJobNode &predecessor    = _nodes.back();
@@ -0,0 +1,101 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/memory/FrameArena.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace cc {
+
+constexpr size_t FrameArena::DEFAULT_BLOCK_SIZE;
+
+FrameArena *FrameArena::getInstance() {
+    static FrameArena instance;
+    return &instance;
+}
+
+FrameArena::FrameArena(size_t blockSize)
+: _blockSize(std::max(blockSize, static_cast<size_t>(alignof(std::max_align_t)))) {
+}
+
+FrameArena::~FrameArena() {
+    for (auto &frame : _frames) {
+        for (auto &block : frame.blocks) {
+            free(block.data);
+        }
+    }
+}
+
+void *FrameArena::allocate(size_t size, size_t alignment) {
+    auto &frame = _frames[_current];
+    if (!frame.blocks.empty()) {
+        const auto &block   = frame.blocks.back();
+        const auto  base    = reinterpret_cast<uintptr_t>(block.data);
+        const auto  aligned = (base + frame.offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        if (aligned + size <= base + block.capacity) {
+            frame.usedSize += aligned + size - base - frame.offset;
+            frame.offset = aligned + size - base;
+            return reinterpret_cast<void *>(aligned);
+        }
+    }
+
+    addBlock(&frame, size + alignment);
+    return allocate(size, alignment);
+}
+
+void FrameArena::nextFrame() {
+    _current = 1 - _current;
+    reset(&_frames[_current]);
+}
+
+void FrameArena::addBlock(Frame *frame, size_t minSize) {
+    // grow geometrically so a frame that outgrows the arena only needs a few more blocks
+    const size_t lastCapacity = frame->blocks.empty() ? 0 : frame->blocks.back().capacity;
+    Block        block;
+    block.capacity = std::max({_blockSize, lastCapacity * 2, minSize});
+    block.data     = static_cast<uint8_t *>(malloc(block.capacity));
+    CC_ASSERT(block.data);
+
+    frame->blocks.push_back(block);
+    frame->capacity += block.capacity;
+    frame->offset = 0;
+}
+
+void FrameArena::reset(Frame *frame) {
+    if (frame->blocks.size() > 1) {
+        const size_t capacity = frame->capacity;
+        for (auto &block : frame->blocks) {
+            free(block.data);
+        }
+        frame->blocks.clear();
+        frame->capacity = 0;
+        addBlock(frame, capacity);
+    }
+    frame->offset   = 0;
+    frame->usedSize = 0;
+}
+
+} // namespace cc
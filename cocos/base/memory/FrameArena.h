@@ -0,0 +1,131 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "base/Macros.h"
+
+namespace cc {
+
+/**
+ * Double-buffered linear arena for data which only lives for a frame, e.g. culling results.
+ * Allocating bumps a pointer and freeing is a no-op; nextFrame() switches to the other half
+ * and empties it, so memory handed out in a frame stays valid until the end of the next one.
+ * A half which needed several blocks is coalesced into a single block when it is reset,
+ * after a few frames the arena stops touching the heap.
+ * @note Not thread safe, it is meant to be used by the thread running the render pipeline.
+ */
+class CC_DLL FrameArena final {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    // the arena shared by the render pipeline, reset by Root after each frame is presented
+    static FrameArena *getInstance();
+
+    explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    FrameArena(const FrameArena &) = delete;
+    FrameArena(FrameArena &&)      = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+    FrameArena &operator=(FrameArena &&) = delete;
+    ~FrameArena();
+
+    void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    template <typename T>
+    inline T *allocate(size_t count) {
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void nextFrame();
+
+    // bytes allocated in the current frame, including alignment padding
+    inline size_t getUsedSize() const { return _frames[_current].usedSize; }
+    inline size_t getCapacity() const { return _frames[_current].capacity; }
+
+private:
+    struct Block {
+        uint8_t *data{nullptr};
+        size_t   capacity{0};
+    };
+
+    struct Frame {
+        std::vector<Block> blocks;
+        size_t             offset{0}; // into the last block
+        size_t             usedSize{0};
+        size_t             capacity{0};
+    };
+
+    void addBlock(Frame *frame, size_t minSize);
+    void reset(Frame *frame);
+
+    Frame    _frames[2];
+    uint32_t _current{0};
+    size_t   _blockSize{DEFAULT_BLOCK_SIZE};
+};
+
+/**
+ * STL allocator drawing from a FrameArena, the default one is FrameArena::getInstance().
+ * deallocate() is a no-op, the memory comes back when the arena moves past the frame.
+ */
+template <typename T>
+class FrameAllocator {
+public:
+    using value_type                             = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    FrameAllocator() noexcept : _arena(FrameArena::getInstance()) {}
+    explicit FrameAllocator(FrameArena *arena) noexcept : _arena(arena) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U> &rhs) noexcept : _arena(rhs.getArena()) {} // NOLINT(google-explicit-constructor)
+
+    inline T *  allocate(size_t count) { return _arena->allocate<T>(count); }
+    inline void deallocate(T * /*ptr*/, size_t /*count*/) noexcept {}
+
+    inline FrameArena *getArena() const noexcept { return _arena; }
+
+private:
+    FrameArena *_arena{nullptr};
+};
+
+template <typename T, typename U>
+inline bool operator==(const FrameAllocator<T> &lhs, const FrameAllocator<U> &rhs) noexcept {
+    return lhs.getArena() == rhs.getArena();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const FrameAllocator<T> &lhs, const FrameAllocator<U> &rhs) noexcept {
+    return lhs.getArena() != rhs.getArena();
+}
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace cc
@@ -0,0 +1,317 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/memory/SlabAllocator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include "base/Log.h"
+
+namespace cc {
+
+namespace {
+
+constexpr uint32_t CLASS_COUNT              = 20;
+constexpr size_t   CLASS_SIZES[CLASS_COUNT] = {16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512, 640, 768, 896, 1024};
+constexpr size_t   BATCH_BYTES              = 8 * 1024;
+constexpr uint32_t MIN_BATCH_SIZE           = 8;
+constexpr uint32_t MAX_BATCH_SIZE           = 64;
+static_assert(CLASS_SIZES[CLASS_COUNT - 1] == SlabAllocator::MAX_SIZE, "the last size class must be MAX_SIZE");
+
+// 16 byte steps up to 128, then four classes for each doubling
+inline uint32_t getSizeClass(size_t size) {
+    if (size <= 128) {
+        return size ? static_cast<uint32_t>((size - 1) / 16) : 0;
+    }
+    if (size <= 256) {
+        return 8 + static_cast<uint32_t>((size - 129) / 32);
+    }
+    if (size <= 512) {
+        return 12 + static_cast<uint32_t>((size - 257) / 64);
+    }
+    return 16 + static_cast<uint32_t>((size - 513) / 128);
+}
+
+// number of objects moved between a thread cache and the depot at once
+inline uint32_t getBatchSize(uint32_t sizeClass) {
+    return static_cast<uint32_t>(std::min<size_t>(std::max<size_t>(BATCH_BYTES / CLASS_SIZES[sizeClass], MIN_BATCH_SIZE), MAX_BATCH_SIZE));
+}
+
+// lives in the free object itself, every size class has room for two pointers
+struct FreeNode {
+    FreeNode *next;
+    FreeNode *nextBatch; // only set on the head of a batch in the depot
+};
+
+struct Depot {
+    std::mutex mutex;
+    FreeNode * batches{nullptr}; // full batches
+    FreeNode * loose{nullptr};   // objects returned by exiting threads
+    uint8_t *  cursor{nullptr};  // unused part of the newest slab
+    uint8_t *  end{nullptr};
+    size_t     slabCount{0};
+};
+
+// Created on first use and never destroyed, objects may still be freed during static destruction.
+Depot *getDepots() {
+    static auto *depots = new Depot[CLASS_COUNT];
+    return depots;
+}
+
+std::atomic<SlabTypeStats *> gTypeStatsHead{nullptr};
+
+struct ThreadCache {
+    FreeNode *heads[CLASS_COUNT];
+    uint32_t  counts[CLASS_COUNT];
+};
+
+thread_local ThreadCache tCache{};
+thread_local bool        tCacheReleased{false};
+
+FreeNode *takeFromDepot(uint32_t sizeClass, uint32_t *count);
+void      returnToDepot(uint32_t sizeClass, FreeNode *head);
+
+struct CacheReleaser {
+    void touch() {}
+    ~CacheReleaser() {
+        for (uint32_t i = 0; i < CLASS_COUNT; ++i) {
+            returnToDepot(i, tCache.heads[i]);
+            tCache.heads[i]  = nullptr;
+            tCache.counts[i] = 0;
+        }
+        tCacheReleased = true;
+    }
+};
+thread_local CacheReleaser tCacheReleaser;
+
+// A full batch if there is one, otherwise up to a batch of loose or new objects.
+FreeNode *takeFromDepot(uint32_t sizeClass, uint32_t *count) {
+    auto &                      depot     = getDepots()[sizeClass];
+    const uint32_t              batchSize = getBatchSize(sizeClass);
+    std::lock_guard<std::mutex> lock(depot.mutex);
+
+    if (depot.batches) {
+        FreeNode *head = depot.batches;
+        depot.batches  = head->nextBatch;
+        *count         = batchSize;
+        return head;
+    }
+
+    if (depot.loose) {
+        FreeNode *head = depot.loose;
+        FreeNode *tail = head;
+        *count         = 1;
+        while (tail->next && *count < batchSize) {
+            tail = tail->next;
+            ++*count;
+        }
+        depot.loose = tail->next;
+        tail->next  = nullptr;
+        return head;
+    }
+
+    const size_t objectSize = CLASS_SIZES[sizeClass];
+    if (static_cast<size_t>(depot.end - depot.cursor) < objectSize) {
+        auto *slab = static_cast<uint8_t *>(std::malloc(SlabAllocator::SLAB_SIZE));
+        if (!slab) {
+            *count = 0;
+            return nullptr;
+        }
+        depot.cursor = slab;
+        depot.end    = slab + SlabAllocator::SLAB_SIZE;
+        ++depot.slabCount;
+    }
+
+    const auto carved = static_cast<uint32_t>(std::min<size_t>(batchSize, (depot.end - depot.cursor) / objectSize));
+    FreeNode * head   = nullptr;
+    for (uint32_t i = carved; i > 0; --i) {
+        auto *node = reinterpret_cast<FreeNode *>(depot.cursor + (i - 1) * objectSize);
+        node->next = head;
+        head       = node;
+    }
+    depot.cursor += carved * objectSize;
+    *count = carved;
+    return head;
+}
+
+void returnToDepot(uint32_t sizeClass, FreeNode *head) {
+    if (!head) {
+        return;
+    }
+    FreeNode *tail = head;
+    while (tail->next) {
+        tail = tail->next;
+    }
+
+    auto &                      depot = getDepots()[sizeClass];
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    tail->next  = depot.loose;
+    depot.loose = head;
+}
+
+void returnBatchToDepot(uint32_t sizeClass, FreeNode *head) {
+    auto &                      depot = getDepots()[sizeClass];
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    head->nextBatch = depot.batches;
+    depot.batches   = head;
+}
+
+inline void countAllocation(SlabTypeStats *stats, size_t size) {
+    if (stats) {
+        stats->objectSize.store(size, std::memory_order_relaxed);
+        stats->liveCount.fetch_add(1, std::memory_order_relaxed);
+        stats->allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+constexpr size_t SlabAllocator::MAX_SIZE;
+constexpr size_t SlabAllocator::SLAB_SIZE;
+
+SlabTypeStats::SlabTypeStats(const char *typeName) : name(typeName) {
+    next = gTypeStatsHead.load(std::memory_order_relaxed);
+    while (!gTypeStatsHead.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+void *SlabAllocator::allocate(size_t size, SlabTypeStats *stats) {
+    void *ptr = tryAllocate(size, stats);
+    if (!ptr) {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+        throw std::bad_alloc();
+#else
+        std::abort();
+#endif
+    }
+    return ptr;
+}
+
+void *SlabAllocator::tryAllocate(size_t size, SlabTypeStats *stats) noexcept {
+    if (size > MAX_SIZE) {
+        void *ptr = ::operator new(size, std::nothrow);
+        if (ptr) {
+            countAllocation(stats, size);
+        }
+        return ptr;
+    }
+
+    const uint32_t sizeClass = getSizeClass(size);
+    FreeNode *     node      = nullptr;
+    if (tCacheReleased) {
+        // the thread is exiting, go to the depot directly
+        uint32_t count = 0;
+        node           = takeFromDepot(sizeClass, &count);
+        if (node) {
+            returnToDepot(sizeClass, node->next);
+        }
+    } else {
+        FreeNode *&head = tCache.heads[sizeClass];
+        if (!head) {
+            tCacheReleaser.touch();
+            head = takeFromDepot(sizeClass, &tCache.counts[sizeClass]);
+        }
+        node = head;
+        if (node) {
+            head = node->next;
+            --tCache.counts[sizeClass];
+        }
+    }
+
+    if (node) {
+        countAllocation(stats, size);
+    }
+    return node;
+}
+
+void SlabAllocator::deallocate(void *ptr, size_t size, SlabTypeStats *stats) noexcept {
+    if (!ptr) {
+        return;
+    }
+    if (stats) {
+        stats->liveCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (size > MAX_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    const uint32_t sizeClass = getSizeClass(size);
+    auto *         node      = static_cast<FreeNode *>(ptr);
+    node->next               = nullptr;
+    if (tCacheReleased) {
+        returnToDepot(sizeClass, node);
+        return;
+    }
+
+    FreeNode *&head  = tCache.heads[sizeClass];
+    uint32_t & count = tCache.counts[sizeClass];
+    if (!head) {
+        tCacheReleaser.touch();
+    }
+    node->next = head;
+    head       = node;
+    ++count;
+
+    // keep up to two batches, so alternating allocations and frees don't bounce on the depot
+    const uint32_t batchSize = getBatchSize(sizeClass);
+    if (count >= 2 * batchSize) {
+        FreeNode *tail = head;
+        for (uint32_t i = 1; i < batchSize; ++i) {
+            tail = tail->next;
+        }
+        FreeNode *batch = head;
+        head            = tail->next;
+        tail->next      = nullptr;
+        count -= batchSize;
+        returnBatchToDepot(sizeClass, batch);
+    }
+}
+
+size_t SlabAllocator::getReservedSize() {
+    size_t slabCount = 0;
+    for (uint32_t i = 0; i < CLASS_COUNT; ++i) {
+        auto &                      depot = getDepots()[i];
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        slabCount += depot.slabCount;
+    }
+    return slabCount * SLAB_SIZE;
+}
+
+const SlabTypeStats *SlabAllocator::getTypeStatsList() {
+    return gTypeStatsHead.load(std::memory_order_acquire);
+}
+
+void SlabAllocator::printStatistics() {
+    CC_LOG_INFO("Slab allocator: %zu bytes reserved", getReservedSize());
+    for (const auto *stats = getTypeStatsList(); stats; stats = stats->next) {
+        CC_LOG_INFO("  %-24s %6zu bytes, %lld live, %llu allocated", stats->name,
+                    stats->objectSize.load(std::memory_order_relaxed),
+                    static_cast<long long>(stats->liveCount.load(std::memory_order_relaxed)),
+                    static_cast<unsigned long long>(stats->allocationCount.load(std::memory_order_relaxed)));
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,138 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "base/Macros.h"
+
+namespace cc {
+
+// Allocation counters of one type using CC_SLAB_ALLOCATED or SlabStlAllocator.
+struct CC_DLL SlabTypeStats final {
+    explicit SlabTypeStats(const char *typeName);
+    SlabTypeStats(const SlabTypeStats &) = delete;
+    SlabTypeStats(SlabTypeStats &&)      = delete;
+    SlabTypeStats &operator=(const SlabTypeStats &) = delete;
+    SlabTypeStats &operator=(SlabTypeStats &&) = delete;
+    ~SlabTypeStats()                           = default;
+
+    const char *          name{nullptr};
+    std::atomic<size_t>   objectSize{0}; // of the last allocation, derived classes may differ
+    std::atomic<int64_t>  liveCount{0};
+    std::atomic<uint64_t> allocationCount{0};
+    SlabTypeStats *       next{nullptr}; // registry, never unlinked
+};
+
+/**
+ * Size-class slab allocator for small objects which are created and destroyed in large numbers.
+ * Sizes up to MAX_SIZE are rounded up to one of a few size classes. Each class carves 64 KB
+ * slabs into objects and keeps its free objects in a shared depot. Every thread caches a free
+ * list per class and moves objects to and from the depot in batches, so most allocations and
+ * frees take no lock. Larger sizes go to the global heap. Slabs are kept for reuse and never
+ * handed back to the system.
+ * Objects are aligned to alignof(std::max_align_t), and the size given to deallocate() must be
+ * the size given to allocate(). Class operator delete gets that right as long as polymorphic
+ * types have virtual destructors.
+ */
+class CC_DLL SlabAllocator final {
+public:
+    static constexpr size_t MAX_SIZE  = 1024;
+    static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+    // throws std::bad_alloc on failure
+    static void *allocate(size_t size, SlabTypeStats *stats = nullptr);
+    static void *tryAllocate(size_t size, SlabTypeStats *stats = nullptr) noexcept;
+    static void  deallocate(void *ptr, size_t size, SlabTypeStats *stats = nullptr) noexcept;
+
+    // memory held by slabs of every size class
+    static size_t getReservedSize();
+
+    static const SlabTypeStats *getTypeStatsList();
+    static void                 printStatistics();
+
+    SlabAllocator() = delete;
+};
+
+// STL allocator backed by the slab allocator, e.g. for std::allocate_shared.
+template <typename T>
+class SlabStlAllocator {
+public:
+    using value_type = T;
+
+    SlabStlAllocator() noexcept = default;
+    explicit SlabStlAllocator(SlabTypeStats *stats) noexcept : _stats(stats) {}
+    template <typename U>
+    SlabStlAllocator(const SlabStlAllocator<U> &other) noexcept : _stats(other.getStats()) {} // NOLINT(google-explicit-constructor)
+
+    T *allocate(size_t count) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+        return static_cast<T *>(SlabAllocator::allocate(count * sizeof(T), _stats));
+    }
+    void deallocate(T *ptr, size_t count) noexcept {
+        SlabAllocator::deallocate(ptr, count * sizeof(T), _stats);
+    }
+
+    inline SlabTypeStats *getStats() const noexcept { return _stats; }
+
+    template <typename U>
+    bool operator==(const SlabStlAllocator<U> & /*other*/) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const SlabStlAllocator<U> & /*other*/) const noexcept { return false; }
+
+private:
+    SlabTypeStats *_stats{nullptr};
+};
+
+} // namespace cc
+
+/**
+ * Allocates a class and its derived classes from the slab allocator and counts them under the class name.
+ * Use it in the public section of the class.
+ */
+#define CC_SLAB_ALLOCATED(type)                                                                                   \
+    static cc::SlabTypeStats &getSlabTypeStats() {                                                                \
+        static cc::SlabTypeStats stats{#type};                                                                    \
+        return stats;                                                                                             \
+    }                                                                                                             \
+    static void *operator new(size_t size) {                                                                      \
+        static_assert(alignof(type) <= alignof(std::max_align_t), "over-aligned types are not supported");        \
+        return cc::SlabAllocator::allocate(size, &getSlabTypeStats());                                            \
+    }                                                                                                             \
+    static void *operator new(size_t size, const std::nothrow_t & /*tag*/) noexcept {                             \
+        return cc::SlabAllocator::tryAllocate(size, &getSlabTypeStats());                                         \
+    }                                                                                                             \
+    static void *operator new(size_t /*size*/, void *ptr) noexcept { return ptr; }                                \
+    /* _CC_NEW passes the call site when CC_MEMORY_TRACKER is defined */                                          \
+    static void *operator new(size_t size, const char * /*file*/, int /*line*/, const char * /*func*/) {          \
+        return cc::SlabAllocator::allocate(size, &getSlabTypeStats());                                            \
+    }                                                                                                             \
+    static void  operator delete(void *ptr, size_t size) noexcept {                                                \
+        cc::SlabAllocator::deallocate(ptr, size, &getSlabTypeStats());                                            \
+    }                                                                                                             \
+    static void operator delete(void * /*ptr*/, void * /*place*/) noexcept {}
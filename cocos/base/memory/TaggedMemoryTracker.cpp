@@ -0,0 +1,580 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/memory/TaggedMemoryTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+#include "base/Log.h"
+
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    #include <Windows.h>
+#elif (CC_PLATFORM == CC_PLATFORM_MAC_OSX || CC_PLATFORM == CC_PLATFORM_MAC_IOS)
+    #include <dlfcn.h>
+    #include <execinfo.h>
+#else
+    #include <dlfcn.h>
+    #include <unwind.h>
+#endif
+
+namespace cc {
+
+namespace {
+
+constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::COUNT);
+
+enum Counter : uint32_t {
+    LIVE_BYTES,
+    LIVE_COUNT,
+    ALLOCATED_BYTES,
+    ALLOCATION_COUNT,
+    COUNTER_COUNT,
+};
+
+// Written by its owning thread only, read by everyone. The members have no initializers
+// so the shared slot below is zeroed statically, operator new may run before dynamic init.
+struct CounterSlot {
+    std::atomic<int64_t> values[TAG_COUNT][COUNTER_COUNT];
+    std::atomic<bool>    inUse;
+    CounterSlot *        next;
+};
+
+// Slots are never freed, a thread returns its slot on exit and a later thread adopts it.
+// Live bytes freed on another thread go negative in that thread's slot, only the sum means anything.
+std::atomic<CounterSlot *> gSlotHead{nullptr};
+// for threads which are exiting, updated with atomic adds
+CounterSlot gSharedSlot;
+
+constexpr size_t   HEADER_SIZE = 16;
+constexpr uint16_t HEADER_MAGIC = 0xCC7A;
+
+struct Header {
+    size_t   size;
+    uint32_t offset; // from the start of the malloc'd block to the user pointer
+    uint16_t magic;
+    uint8_t  tag;
+    uint8_t  sampled;
+};
+static_assert(sizeof(Header) <= HEADER_SIZE, "allocation header too large");
+static_assert(HEADER_SIZE % alignof(std::max_align_t) == 0, "allocation header breaks the default alignment");
+
+constexpr uint32_t MAX_STACK_FRAMES = 16;
+
+struct Sample {
+    size_t    size{0};
+    MemoryTag tag{MemoryTag::DEFAULT};
+    uint32_t  frameCount{0};
+    void *    frames[MAX_STACK_FRAMES]{};
+};
+
+std::atomic<uint32_t> gSampleInterval{TaggedMemoryTracker::DEFAULT_SAMPLE_INTERVAL};
+std::mutex            gSampleMutex;
+
+struct RateState {
+    std::chrono::steady_clock::time_point lastTime;
+    uint64_t                              lastBytes[TAG_COUNT]{};
+    uint64_t                              lastCount[TAG_COUNT]{};
+    double                                byteRate[TAG_COUNT]{};
+    double                                allocationRate[TAG_COUNT]{};
+    bool                                  started{false};
+};
+
+std::mutex gRateMutex;
+
+RateState &getRateState() {
+    static RateState state;
+    return state;
+}
+
+// Created on first use and never destroyed, allocations may still be freed during static destruction.
+std::unordered_map<const void *, Sample> &getSamples() {
+    static auto *samples = new std::unordered_map<const void *, Sample>();
+    return *samples;
+}
+
+thread_local CounterSlot *tSlot{nullptr};
+thread_local uint8_t      tTag{0};
+thread_local uint32_t     tSampleCounter{0};
+// set while the tracker allocates for itself
+thread_local bool         tInTracker{false};
+thread_local bool         tSlotReleased{false};
+
+// the tracker's own allocations are charged to the default tag and never sampled
+class InTrackerScope final {
+public:
+    InTrackerScope() : _inTracker(tInTracker), _tag(tTag) {
+        tInTracker = true;
+        tTag       = static_cast<uint8_t>(MemoryTag::DEFAULT);
+    }
+    ~InTrackerScope() {
+        tInTracker = _inTracker;
+        tTag       = _tag;
+    }
+
+private:
+    bool    _inTracker;
+    uint8_t _tag;
+};
+
+struct SlotReleaser {
+    void touch() {}
+    ~SlotReleaser() {
+        if (tSlot) {
+            tSlot->inUse.store(false, std::memory_order_release);
+            tSlot = nullptr;
+        }
+        tSlotReleased = true;
+    }
+};
+thread_local SlotReleaser tSlotReleaser;
+
+CounterSlot *acquireSlot() {
+    for (auto *slot = gSlotHead.load(std::memory_order_acquire); slot; slot = slot->next) {
+        bool expected = false;
+        if (!slot->inUse.load(std::memory_order_relaxed) &&
+            slot->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return slot;
+        }
+    }
+
+    void *memory = std::malloc(sizeof(CounterSlot));
+    if (!memory) {
+        return nullptr;
+    }
+    auto *slot = new (memory) CounterSlot();
+    slot->inUse.store(true, std::memory_order_relaxed);
+    slot->next = gSlotHead.load(std::memory_order_relaxed);
+    while (!gSlotHead.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return slot;
+}
+
+CounterSlot *currentSlot() {
+    if (tSlot) {
+        return tSlot;
+    }
+    if (tSlotReleased || tInTracker) {
+        return &gSharedSlot;
+    }
+
+    InTrackerScope scope;
+    tSlot = acquireSlot();
+    // registers the thread exit hook, which may allocate
+    tSlotReleaser.touch();
+    return tSlot ? tSlot : &gSharedSlot;
+}
+
+inline void addCounters(uint8_t tag, int64_t liveBytes, int64_t liveCount, uint64_t allocatedBytes, uint64_t allocationCount) {
+    CounterSlot *slot   = currentSlot();
+    auto &       values = slot->values[tag];
+    if (slot == &gSharedSlot) {
+        values[LIVE_BYTES].fetch_add(liveBytes, std::memory_order_relaxed);
+        values[LIVE_COUNT].fetch_add(liveCount, std::memory_order_relaxed);
+        values[ALLOCATED_BYTES].fetch_add(static_cast<int64_t>(allocatedBytes), std::memory_order_relaxed);
+        values[ALLOCATION_COUNT].fetch_add(static_cast<int64_t>(allocationCount), std::memory_order_relaxed);
+        return;
+    }
+
+    // single writer, a plain load and store is enough and avoids the locked add
+    auto add = [](std::atomic<int64_t> &value, int64_t delta) {
+        value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    };
+    add(values[LIVE_BYTES], liveBytes);
+    add(values[LIVE_COUNT], liveCount);
+    add(values[ALLOCATED_BYTES], static_cast<int64_t>(allocatedBytes));
+    add(values[ALLOCATION_COUNT], static_cast<int64_t>(allocationCount));
+}
+
+#if (CC_PLATFORM != CC_PLATFORM_WINDOWS && CC_PLATFORM != CC_PLATFORM_MAC_OSX && CC_PLATFORM != CC_PLATFORM_MAC_IOS)
+struct UnwindState {
+    void **  frames;
+    uint32_t count;
+    uint32_t maxCount;
+};
+
+_Unwind_Reason_Code unwindCallback(struct _Unwind_Context *context, void *arg) {
+    auto *state = static_cast<UnwindState *>(arg);
+    auto  pc    = _Unwind_GetIP(context);
+    if (pc) {
+        if (state->count == state->maxCount) {
+            return _URC_END_OF_STACK;
+        }
+        state->frames[state->count++] = reinterpret_cast<void *>(pc);
+    }
+    return _URC_NO_REASON;
+}
+#endif
+
+uint32_t captureStack(void **frames, uint32_t maxCount) {
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    return CaptureStackBackTrace(0, maxCount, frames, nullptr);
+#elif (CC_PLATFORM == CC_PLATFORM_MAC_OSX || CC_PLATFORM == CC_PLATFORM_MAC_IOS)
+    int count = backtrace(frames, static_cast<int>(maxCount));
+    return count > 0 ? static_cast<uint32_t>(count) : 0;
+#else
+    UnwindState state{frames, 0, maxCount};
+    _Unwind_Backtrace(unwindCallback, &state);
+    return state.count;
+#endif
+}
+
+void recordSample(const void *ptr, size_t size, MemoryTag tag) {
+    Sample sample;
+    sample.size       = size;
+    sample.tag        = tag;
+    sample.frameCount = captureStack(sample.frames, MAX_STACK_FRAMES);
+
+    InTrackerScope              scope;
+    std::lock_guard<std::mutex> lock(gSampleMutex);
+    getSamples()[ptr] = sample;
+}
+
+void eraseSample(const void *ptr) {
+    InTrackerScope              scope;
+    std::lock_guard<std::mutex> lock(gSampleMutex);
+    getSamples().erase(ptr);
+}
+
+inline Header *getHeader(const void *ptr) {
+    return reinterpret_cast<Header *>(const_cast<uint8_t *>(static_cast<const uint8_t *>(ptr)) - HEADER_SIZE);
+}
+
+void printFrame(uint32_t index, void *frame) {
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    CC_LOG_INFO("    #%02u %p", index, frame);
+#else
+    Dl_info info;
+    if (!dladdr(frame, &info)) {
+        CC_LOG_INFO("    #%02u %p", index, frame);
+    } else if (info.dli_sname) {
+        auto offset = static_cast<size_t>(static_cast<uint8_t *>(frame) - static_cast<uint8_t *>(info.dli_saddr));
+        CC_LOG_INFO("    #%02u %p %s+%zu", index, frame, info.dli_sname, offset);
+    } else if (info.dli_fname) {
+        auto offset = static_cast<size_t>(static_cast<uint8_t *>(frame) - static_cast<uint8_t *>(info.dli_fbase));
+        CC_LOG_INFO("    #%02u %p %s+0x%zx", index, frame, info.dli_fname, offset);
+    } else {
+        CC_LOG_INFO("    #%02u %p", index, frame);
+    }
+#endif
+}
+
+} // namespace
+
+constexpr uint32_t TaggedMemoryTracker::DEFAULT_SAMPLE_INTERVAL;
+
+void *TaggedMemoryTracker::allocate(size_t size, size_t alignment) {
+    alignment = std::max(alignment, alignof(std::max_align_t));
+    if (size > SIZE_MAX - HEADER_SIZE - alignment) {
+        return nullptr;
+    }
+
+    uint8_t *raw  = nullptr;
+    uint8_t *user = nullptr;
+    if (alignment == alignof(std::max_align_t)) {
+        raw  = static_cast<uint8_t *>(std::malloc(size + HEADER_SIZE));
+        user = raw + HEADER_SIZE;
+    } else {
+        raw  = static_cast<uint8_t *>(std::malloc(size + HEADER_SIZE + alignment - 1));
+        user = reinterpret_cast<uint8_t *>((reinterpret_cast<uintptr_t>(raw) + HEADER_SIZE + alignment - 1) & ~(alignment - 1));
+    }
+    if (!raw) {
+        return nullptr;
+    }
+
+    auto *header    = getHeader(user);
+    header->size    = size;
+    header->offset  = static_cast<uint32_t>(user - raw);
+    header->magic   = HEADER_MAGIC;
+    header->tag     = tTag;
+    header->sampled = 0;
+    addCounters(tTag, static_cast<int64_t>(size), 1, size, 1);
+
+    uint32_t interval = gSampleInterval.load(std::memory_order_relaxed);
+    if (interval != 0 && !tInTracker && ++tSampleCounter >= interval) {
+        tSampleCounter  = 0;
+        header->sampled = 1;
+        recordSample(user, size, static_cast<MemoryTag>(header->tag));
+    }
+    return user;
+}
+
+void *TaggedMemoryTracker::reallocate(void *ptr, size_t size) {
+    if (!ptr) {
+        return allocate(size);
+    }
+    if (size == 0) {
+        deallocate(ptr);
+        return nullptr;
+    }
+
+    void *newPtr = allocate(size);
+    if (newPtr) {
+        std::memcpy(newPtr, ptr, std::min(size, getHeader(ptr)->size));
+        deallocate(ptr);
+    }
+    return newPtr;
+}
+
+void TaggedMemoryTracker::deallocate(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    auto *header = getHeader(ptr);
+    CC_ASSERT(header->magic == HEADER_MAGIC);
+    if (header->sampled) {
+        eraseSample(ptr);
+    }
+    addCounters(header->tag, -static_cast<int64_t>(header->size), -1, 0, 0);
+    std::free(static_cast<uint8_t *>(ptr) - header->offset);
+}
+
+size_t TaggedMemoryTracker::getAllocationSize(const void *ptr) {
+    return ptr ? getHeader(ptr)->size : 0;
+}
+
+MemoryTag TaggedMemoryTracker::getCurrentTag() {
+    return static_cast<MemoryTag>(tTag);
+}
+
+void TaggedMemoryTracker::setCurrentTag(MemoryTag tag) {
+    CC_ASSERT(tag < MemoryTag::COUNT);
+    tTag = static_cast<uint8_t>(tag);
+}
+
+const char *TaggedMemoryTracker::getTagName(MemoryTag tag) {
+    static const char *names[] = {"default", "gfx", "scene", "spine", "audio", "script"};
+    static_assert(sizeof(names) / sizeof(names[0]) == TAG_COUNT, "a memory tag has no name");
+    return tag < MemoryTag::COUNT ? names[static_cast<size_t>(tag)] : "unknown";
+}
+
+MemoryTagStats TaggedMemoryTracker::getStats(MemoryTag tag) {
+    CC_ASSERT(tag < MemoryTag::COUNT);
+    auto           index = static_cast<size_t>(tag);
+    int64_t        sums[COUNTER_COUNT]{};
+    auto accumulate = [&](const CounterSlot &slot) {
+        for (uint32_t i = 0; i < COUNTER_COUNT; ++i) {
+            sums[i] += slot.values[index][i].load(std::memory_order_relaxed);
+        }
+    };
+    for (auto *slot = gSlotHead.load(std::memory_order_acquire); slot; slot = slot->next) {
+        accumulate(*slot);
+    }
+    accumulate(gSharedSlot);
+
+    MemoryTagStats stats;
+    stats.liveBytes       = sums[LIVE_BYTES];
+    stats.liveCount       = sums[LIVE_COUNT];
+    stats.allocatedBytes  = static_cast<uint64_t>(sums[ALLOCATED_BYTES]);
+    stats.allocationCount = static_cast<uint64_t>(sums[ALLOCATION_COUNT]);
+
+    std::lock_guard<std::mutex> lock(gRateMutex);
+    const auto &                rates = getRateState();
+    stats.byteRate                     = rates.byteRate[index];
+    stats.allocationRate               = rates.allocationRate[index];
+    return stats;
+}
+
+void TaggedMemoryTracker::update() {
+    MemoryTagStats stats[TAG_COUNT];
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        stats[i] = getStats(static_cast<MemoryTag>(i));
+    }
+
+    auto                        now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(gRateMutex);
+    auto &                      rates   = getRateState();
+    double                      seconds = std::chrono::duration<double>(now - rates.lastTime).count();
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        if (rates.started && seconds > 0.0) {
+            rates.byteRate[i]       = static_cast<double>(stats[i].allocatedBytes - rates.lastBytes[i]) / seconds;
+            rates.allocationRate[i] = static_cast<double>(stats[i].allocationCount - rates.lastCount[i]) / seconds;
+        }
+        rates.lastBytes[i] = stats[i].allocatedBytes;
+        rates.lastCount[i] = stats[i].allocationCount;
+    }
+    rates.lastTime = now;
+    rates.started  = true;
+}
+
+void TaggedMemoryTracker::setSampleInterval(uint32_t interval) {
+    gSampleInterval.store(interval, std::memory_order_relaxed);
+}
+
+uint32_t TaggedMemoryTracker::getSampleInterval() {
+    return gSampleInterval.load(std::memory_order_relaxed);
+}
+
+void TaggedMemoryTracker::printStatistics(uint32_t maxStacks) {
+    CC_LOG_INFO("Memory by tag:");
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        auto tag   = static_cast<MemoryTag>(i);
+        auto stats = getStats(tag);
+        CC_LOG_INFO("  %-8s live %lld bytes in %lld blocks, %.0f bytes/s in %.0f allocations/s",
+                    getTagName(tag), static_cast<long long>(stats.liveBytes), static_cast<long long>(stats.liveCount),
+                    stats.byteRate, stats.allocationRate);
+    }
+
+    // copied out so logging does not run under the lock
+    std::vector<Sample> samples;
+    {
+        InTrackerScope              scope;
+        std::lock_guard<std::mutex> lock(gSampleMutex);
+        samples.reserve(getSamples().size());
+        for (const auto &it : getSamples()) {
+            samples.emplace_back(it.second);
+        }
+    }
+    if (samples.empty()) {
+        return;
+    }
+
+    auto sameStack = [](const Sample &lhs, const Sample &rhs) {
+        return lhs.frameCount == rhs.frameCount && std::equal(lhs.frames, lhs.frames + lhs.frameCount, rhs.frames);
+    };
+    std::sort(samples.begin(), samples.end(), [](const Sample &lhs, const Sample &rhs) {
+        return std::lexicographical_compare(lhs.frames, lhs.frames + lhs.frameCount, rhs.frames, rhs.frames + rhs.frameCount);
+    });
+
+    struct StackGroup {
+        const Sample *sample{nullptr};
+        size_t        bytes{0};
+        size_t        count{0};
+    };
+    std::vector<StackGroup> groups;
+    for (const auto &sample : samples) {
+        if (groups.empty() || !sameStack(*groups.back().sample, sample)) {
+            groups.push_back({&sample, 0, 0});
+        }
+        groups.back().bytes += sample.size;
+        ++groups.back().count;
+    }
+    std::sort(groups.begin(), groups.end(), [](const StackGroup &lhs, const StackGroup &rhs) {
+        return lhs.bytes > rhs.bytes;
+    });
+
+    uint32_t interval = std::max(getSampleInterval(), 1U);
+    CC_LOG_INFO("Sampled live allocations, 1 in %u:", interval);
+    for (size_t i = 0; i < groups.size() && i < maxStacks; ++i) {
+        const auto &group = groups[i];
+        CC_LOG_INFO("  [%s] %zu sampled blocks, %zu bytes, about %zu bytes live",
+                    getTagName(group.sample->tag), group.count, group.bytes, group.bytes * interval);
+        for (uint32_t frame = 0; frame < group.sample->frameCount; ++frame) {
+            printFrame(frame, group.sample->frames[frame]);
+        }
+    }
+}
+
+} // namespace cc
+
+#if CC_USE_TAGGED_MEMORY_TRACKER
+
+namespace {
+
+void *allocateOrFail(size_t size, size_t alignment) {
+    while (true) {
+        void *ptr = cc::TaggedMemoryTracker::allocate(size, alignment);
+        if (ptr) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+    #if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+            throw std::bad_alloc();
+    #else
+            std::abort();
+    #endif
+        }
+        handler();
+    }
+}
+
+} // namespace
+
+void *operator new(size_t size) {
+    return allocateOrFail(size, alignof(std::max_align_t));
+}
+void *operator new[](size_t size) {
+    return allocateOrFail(size, alignof(std::max_align_t));
+}
+void *operator new(size_t size, const std::nothrow_t & /*tag*/) noexcept {
+    return cc::TaggedMemoryTracker::allocate(size);
+}
+void *operator new[](size_t size, const std::nothrow_t & /*tag*/) noexcept {
+    return cc::TaggedMemoryTracker::allocate(size);
+}
+void operator delete(void *ptr) noexcept {
+    cc::TaggedMemoryTracker::deallocate(ptr);
+}
+void operator delete[](void *ptr) noexcept {
+    cc::TaggedMemoryTracker::deallocate(ptr);
+}
+void operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+    cc::TaggedMemoryTracker::deallocate(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+    cc::TaggedMemoryTracker::deallocate(ptr);
+}
+void operator delete(void *ptr, size_t /*size*/) noexcept {
+    cc::TaggedMemoryTracker::deallocate(ptr);
+}
+void operator delete[](void *ptr, size_t /*size*/) noexcept {
+    cc::TaggedMemoryTracker::deallocate(ptr);
+}
+
+    #if defined(__cpp_aligned_new)
+void *operator new(size_t size, std::align_val_t alignment) {
+    return allocateOrFail(size, static_cast<size_t>(alignment));
+}
+void *operator new[](size_t size, std::align_val_t alignment) {
+    return allocateOrFail(size, static_cast<size_t>(alignment));
+}
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept {
+    return cc::TaggedMemoryTracker::allocate(size, static_cast<size_t>(alignment));
+}
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept {
+    return cc::TaggedMemoryTracker::allocate(size, static_cast<size_t>(alignment));
+}
+void operator delete(void *ptr, std::align_val_t /*alignment*/) noexcept {
+    cc::TaggedMemoryTracker::deallocate(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t /*alignment*/) noexcept {
+    cc::TaggedMemoryTracker::deallocate(ptr);
+}
+void operator delete(void *ptr, size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    cc::TaggedMemoryTracker::deallocate(ptr);
+}
+void operator delete[](void *ptr, size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    cc::TaggedMemoryTracker::deallocate(ptr);
+}
+    #endif
+
+#endif
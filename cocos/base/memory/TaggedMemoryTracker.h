@@ -0,0 +1,118 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "base/Macros.h"
+
+#ifndef CC_USE_TAGGED_MEMORY_TRACKER
+    #define CC_USE_TAGGED_MEMORY_TRACKER 0
+#endif
+
+namespace cc {
+
+// The subsystem an allocation is charged to, see MemoryTagScope.
+enum class MemoryTag : uint8_t {
+    DEFAULT,
+    GFX,
+    SCENE,
+    SPINE,
+    AUDIO,
+    SCRIPT,
+    COUNT,
+};
+
+struct MemoryTagStats {
+    int64_t  liveBytes{0};
+    int64_t  liveCount{0};
+    uint64_t allocatedBytes{0};  // since startup
+    uint64_t allocationCount{0}; // since startup
+    double   byteRate{0.0};       // bytes allocated per second, measured between the last two update() calls
+    double   allocationRate{0.0}; // allocations per second, measured between the last two update() calls
+};
+
+/**
+ * Tagged allocation tracking which is cheap enough to be left on in release builds.
+ * Every block carries a small header recording its size and tag. The counters live in
+ * per-thread slots written without locks; getStats() adds the slots up. A mutex is only
+ * taken when a thread first allocates and when an allocation is sampled.
+ * One allocation in getSampleInterval() has its call stack recorded until it is freed.
+ * printStatistics() lists those stacks by live bytes, which points at where memory grows.
+ *
+ * When the engine is built with CC_USE_TAGGED_MEMORY_TRACKER, the global operator new and
+ * delete are routed through allocate() and deallocate(). Allocations are charged to the tag
+ * of the innermost MemoryTagScope on the allocating thread. The scope itself is always active.
+ */
+class CC_DLL TaggedMemoryTracker final {
+public:
+    static constexpr uint32_t DEFAULT_SAMPLE_INTERVAL = 1024;
+
+    static void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    static void *reallocate(void *ptr, size_t size);
+    static void  deallocate(void *ptr);
+
+    // size requested for a block returned by allocate(), 0 for nullptr
+    static size_t getAllocationSize(const void *ptr);
+
+    static MemoryTag   getCurrentTag();
+    static void        setCurrentTag(MemoryTag tag);
+    static const char *getTagName(MemoryTag tag);
+
+    static MemoryTagStats getStats(MemoryTag tag);
+
+    // refreshes the allocation rates, Root calls it once a frame
+    static void update();
+
+    // 0 turns stack sampling off
+    static void     setSampleInterval(uint32_t interval);
+    static uint32_t getSampleInterval();
+
+    // logs the stats of every tag and the sampled stacks holding the most live memory
+    static void printStatistics(uint32_t maxStacks = 10);
+
+    TaggedMemoryTracker() = delete;
+};
+
+class MemoryTagScope final {
+public:
+    explicit MemoryTagScope(MemoryTag tag) : _previous(TaggedMemoryTracker::getCurrentTag()) {
+        TaggedMemoryTracker::setCurrentTag(tag);
+    }
+    MemoryTagScope(const MemoryTagScope &) = delete;
+    MemoryTagScope(MemoryTagScope &&)      = delete;
+    MemoryTagScope &operator=(const MemoryTagScope &) = delete;
+    MemoryTagScope &operator=(MemoryTagScope &&) = delete;
+    ~MemoryTagScope() { TaggedMemoryTracker::setCurrentTag(_previous); }
+
+private:
+    MemoryTag _previous;
+};
+
+} // namespace cc
+
+// The scope is kept in every build, other trackers such as the GFX memory tracker read the current tag as well
+#define CC_MEMORY_TAG_SCOPE(tag) cc::MemoryTagScope ccMemoryTagScope(tag)
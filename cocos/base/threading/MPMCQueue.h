@@ -0,0 +1,126 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace cc {
+
+/**
+ * Bounded lock-free multi-producer multi-consumer queue (Vyukov).
+ * Every cell carries a sequence number telling producers and consumers whose turn it is,
+ * so a push or a pop is a single CAS on the shared position in the common case.
+ */
+template <typename T>
+class MPMCQueue final {
+public:
+    // capacity must be a power of two
+    explicit MPMCQueue(size_t capacity);
+    MPMCQueue(const MPMCQueue &) = delete;
+    MPMCQueue(MPMCQueue &&)      = delete;
+    MPMCQueue &operator=(const MPMCQueue &) = delete;
+    MPMCQueue &operator=(MPMCQueue &&) = delete;
+    ~MPMCQueue()                       = default;
+
+    // both return false instead of blocking when the queue is full or empty, item is left untouched on failure
+    template <typename U>
+    bool tryPush(U &&item);
+    bool tryPop(T *out);
+
+    inline size_t capacity() const { return _mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T                   data{};
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t                  _mask{0};
+
+    alignas(64) std::atomic<size_t> _enqueuePos{0};
+    alignas(64) std::atomic<size_t> _dequeuePos{0};
+};
+
+template <typename T>
+MPMCQueue<T>::MPMCQueue(size_t capacity) : _cells(new Cell[capacity]), _mask(capacity - 1) {
+    for (size_t i = 0; i < capacity; ++i) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+template <typename U>
+bool MPMCQueue<T>::tryPush(U &&item) {
+    Cell * cell = nullptr;
+    size_t pos  = _enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        cell                 = &_cells[pos & _mask];
+        const size_t   seq   = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t delta = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (delta == 0) {
+            if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (delta < 0) {
+            return false;
+        } else {
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    cell->data = std::forward<U>(item);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool MPMCQueue<T>::tryPop(T *out) {
+    Cell * cell = nullptr;
+    size_t pos  = _dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        cell                 = &_cells[pos & _mask];
+        const size_t   seq   = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t delta = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (delta == 0) {
+            if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (delta < 0) {
+            return false;
+        } else {
+            pos = _dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+    *out = std::move(cell->data);
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+} // namespace cc
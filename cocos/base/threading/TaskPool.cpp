@@ -0,0 +1,165 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "TaskPool.h"
+
+namespace cc {
+
+constexpr size_t TaskPool::QUEUE_CAPACITY;
+
+TaskPool::TaskPool(uint32_t threadNum) {
+    for (auto &queue : _queues) {
+        queue = std::make_unique<MPMCQueue<Task>>(QUEUE_CAPACITY);
+    }
+
+    threadNum = std::max(threadNum, 1U);
+    _threads.reserve(threadNum);
+    for (uint32_t i = 0; i < threadNum; ++i) {
+        _threads.emplace_back(&TaskPool::workerLoop, this, static_cast<int>(i));
+    }
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(_parkMutex);
+        _running.store(false);
+    }
+    _parkCondition.notify_all();
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+    stopAllTasks();
+}
+
+void TaskPool::push(Task &&task, Priority priority) {
+    const auto index = static_cast<size_t>(priority);
+
+    // count the task first so a worker going to sleep can never miss it
+    _taskNum.fetch_add(1);
+    if (!_queues[index]->tryPush(std::move(task))) {
+        std::lock_guard<std::mutex> lock(_overflowMutex);
+        _overflowQueues[index].push_back(std::move(task));
+        _overflowTaskNum.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (_idleThreadNum.load() > 0) {
+        std::lock_guard<std::mutex> lock(_parkMutex);
+        _parkCondition.notify_one();
+    }
+}
+
+bool TaskPool::pop(Task *task) {
+    for (size_t i = 0; i < static_cast<size_t>(Priority::COUNT); ++i) {
+        bool found = _queues[i]->tryPop(task);
+        if (!found && _overflowTaskNum.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(_overflowMutex);
+            if (!_overflowQueues[i].empty()) {
+                *task = std::move(_overflowQueues[i].front());
+                _overflowQueues[i].pop_front();
+                _overflowTaskNum.fetch_sub(1, std::memory_order_relaxed);
+                found = true;
+            }
+        }
+        if (found) {
+            _taskNum.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskPool::stopAllTasks() {
+    Task task;
+    while (pop(&task)) {
+        task.callback.reset();
+    }
+}
+
+void TaskPool::stopTasksByType(TaskType type) {
+    for (size_t i = 0; i < static_cast<size_t>(Priority::COUNT); ++i) {
+        std::vector<Task> notStopTasks;
+        Task              task;
+        while (_queues[i]->tryPop(&task)) {
+            if (task.type != type) {
+                notStopTasks.push_back(std::move(task));
+            } else {
+                _taskNum.fetch_sub(1);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_overflowMutex);
+        auto &                      overflow = _overflowQueues[i];
+        for (auto it = overflow.begin(); it != overflow.end();) {
+            if (it->type == type) {
+                it = overflow.erase(it);
+                _overflowTaskNum.fetch_sub(1, std::memory_order_relaxed);
+                _taskNum.fetch_sub(1);
+            } else {
+                ++it;
+            }
+        }
+        // the survivors go back in order, behind anything pushed in the meantime
+        for (auto &t : notStopTasks) {
+            if (!_queues[i]->tryPush(std::move(t))) {
+                overflow.push_back(std::move(t));
+                _overflowTaskNum.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void TaskPool::workerLoop(int tid) {
+    Task task;
+    while (true) {
+        bool found = false;
+        for (uint32_t spin = 0; spin < SPIN_COUNT && !found; ++spin) {
+            found = pop(&task);
+            if (!found) {
+                std::this_thread::yield();
+            }
+        }
+        if (found) {
+            if (!task.isCancelled()) {
+                task.callback(tid);
+            }
+            task.callback.reset();
+            task.cancelled.reset();
+            continue;
+        }
+        if (!_running.load()) {
+            return; // the queues are drained
+        }
+
+        // pushers bump _taskNum before checking _idleThreadNum, so one of the two sides always sees the other
+        std::unique_lock<std::mutex> lock(_parkMutex);
+        _idleThreadNum.fetch_add(1);
+        _parkCondition.wait(lock, [this]() {
+            return !_running.load() || _taskNum.load() > 0;
+        });
+        _idleThreadNum.fetch_sub(1);
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,138 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "MPMCQueue.h"
+#include "base/InplaceFunction.h"
+#include "base/Macros.h"
+#include "base/ThreadPool.h"
+
+namespace cc {
+
+/**
+ * Fixed size pool for short independent tasks such as image decoding.
+ * Tasks wait in lock-free MPMC queues, one per priority, and callables which fit in
+ * INLINE_STORAGE_SIZE bytes are stored in the queue cell itself, so pushing a task neither
+ * locks nor allocates. A task is only delayed by a lock when its priority queue is full.
+ */
+class CC_DLL TaskPool final {
+public:
+    using TaskType = LegacyThreadPool::TaskType;
+
+    enum class Priority : uint8_t {
+        HIGH,
+        NORMAL,
+        LOW,
+        COUNT,
+    };
+
+    // Tasks pushed with a token are dropped instead of run once it is cancelled
+    class CancelToken final {
+    public:
+        CancelToken() : _cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+        inline void cancel() { _cancelled->store(true, std::memory_order_relaxed); }
+        inline bool isCancelled() const { return _cancelled->load(std::memory_order_relaxed); }
+
+    private:
+        friend class TaskPool;
+
+        std::shared_ptr<std::atomic<bool>> _cancelled;
+    };
+
+    explicit TaskPool(uint32_t threadNum);
+    TaskPool(const TaskPool &) = delete;
+    TaskPool(TaskPool &&)      = delete;
+    TaskPool &operator=(const TaskPool &) = delete;
+    TaskPool &operator=(TaskPool &&) = delete;
+
+    // the destructor waits for all the tasks in the queues to be finished
+    ~TaskPool();
+
+    /* Pushes a task to the pool, same as LegacyThreadPool::pushTask
+     *  @param runnable Callable taking the index of the worker thread running it
+     *  @note Tasks of the same priority start roughly in push order, across priorities higher ones start first
+     */
+    template <typename Function>
+    void pushTask(Function &&runnable, TaskType type = TaskType::DEFAULT, Priority priority = Priority::NORMAL, const CancelToken *token = nullptr);
+
+    // Removes all the tasks which haven't started yet
+    void stopAllTasks();
+
+    // Removes the tasks of the given type which haven't started yet
+    void stopTasksByType(TaskType type);
+
+    inline uint32_t getThreadNum() const { return static_cast<uint32_t>(_threads.size()); }
+    inline int      getIdleThreadNum() const { return _idleThreadNum.load(std::memory_order_relaxed); }
+    inline int      getTaskNum() const { return _taskNum.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t   INLINE_STORAGE_SIZE = 96;
+    static constexpr size_t   QUEUE_CAPACITY      = 1024;
+    static constexpr uint32_t SPIN_COUNT          = 16;
+
+    struct Task {
+        InplaceFunction<void(int), INLINE_STORAGE_SIZE> callback;
+        TaskType                                        type{TaskType::DEFAULT};
+        std::shared_ptr<std::atomic<bool>>              cancelled;
+
+        inline bool isCancelled() const { return cancelled && cancelled->load(std::memory_order_relaxed); }
+    };
+
+    void push(Task &&task, Priority priority);
+    bool pop(Task *task);
+    void workerLoop(int tid);
+
+    std::unique_ptr<MPMCQueue<Task>> _queues[static_cast<size_t>(Priority::COUNT)];
+    std::deque<Task>                 _overflowQueues[static_cast<size_t>(Priority::COUNT)];
+    std::mutex                       _overflowMutex;
+    std::atomic<int>                 _overflowTaskNum{0};
+
+    std::vector<std::thread> _threads;
+    std::atomic<int>         _taskNum{0};
+    std::atomic<int>         _idleThreadNum{0};
+    std::atomic<bool>        _running{true};
+    std::mutex               _parkMutex;
+    std::condition_variable  _parkCondition;
+};
+
+template <typename Function>
+void TaskPool::pushTask(Function &&runnable, TaskType type, Priority priority, const CancelToken *token) {
+    push({std::forward<Function>(runnable), type, token ? token->_cancelled : nullptr}, priority);
+}
+
+} // namespace cc
@@ -0,0 +1,179 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "ThreadSafeGrowableLinearAllocator.h"
+#include <algorithm>
+
+namespace cc {
+
+namespace {
+std::atomic<uint64_t> allocatorCount{0};
+
+// a thread usually works with one or two allocators at a time, the ids are never reused.
+// Evicted entries are found again in the allocator's own map.
+constexpr uint32_t THREAD_STATE_CACHE_SIZE = 4;
+struct ThreadStateCacheEntry {
+    uint64_t allocatorId{0};
+    void *   state{nullptr};
+};
+thread_local ThreadStateCacheEntry threadStateCache[THREAD_STATE_CACHE_SIZE];
+thread_local uint32_t              threadStateCacheNext{0};
+
+inline uint8_t *alignUp(uint8_t *ptr, size_t alignment) noexcept {
+    const auto address = reinterpret_cast<uintptr_t>(ptr);
+    return reinterpret_cast<uint8_t *>((address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+}
+} // namespace
+
+constexpr uint32_t ThreadSafeGrowableLinearAllocator::DEFAULT_BLOCK_SIZE;
+
+ThreadSafeGrowableLinearAllocator::ThreadSafeGrowableLinearAllocator(uint32_t blockSize) noexcept
+: _id(++allocatorCount),
+  _blockSize(blockSize) {
+}
+
+ThreadSafeGrowableLinearAllocator::~ThreadSafeGrowableLinearAllocator() {
+    for (auto &block : _freeBlocks) {
+        free(block.data);
+    }
+    for (auto &block : _usedBlocks) {
+        free(block.data);
+    }
+}
+
+void *ThreadSafeGrowableLinearAllocator::doAllocate(size_t size, size_t alignment) noexcept {
+    if (size == 0) {
+        return nullptr;
+    }
+
+    auto *state   = getThreadState();
+    auto *aligned = alignUp(state->cursor, alignment);
+    if (state->cursor && aligned + size <= state->end) {
+        state->cursor = aligned + size;
+        state->usedSize.store(state->usedSize.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+        return aligned;
+    }
+    return allocateSlow(state, size, alignment);
+}
+
+void *ThreadSafeGrowableLinearAllocator::allocateSlow(ThreadState *state, size_t size, size_t alignment) noexcept {
+    const size_t required = size + alignment - 1;
+    const Block  block    = acquireBlock(required);
+    if (!block.data) {
+        return nullptr;
+    }
+
+    auto *aligned = alignUp(block.data, alignment);
+    // a dedicated block is used up right away, keep bumping in the current one
+    if (block.size == _blockSize) {
+        state->cursor = aligned + size;
+        state->end    = block.data + block.size;
+    }
+    state->usedSize.store(state->usedSize.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+    return aligned;
+}
+
+ThreadSafeGrowableLinearAllocator::ThreadState *ThreadSafeGrowableLinearAllocator::getThreadState() noexcept {
+    for (auto &entry : threadStateCache) {
+        if (entry.allocatorId == _id) {
+            return static_cast<ThreadState *>(entry.state);
+        }
+    }
+
+    ThreadState *state = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto &                      slot = _threadStates[std::this_thread::get_id()];
+        if (!slot) {
+            slot = std::make_unique<ThreadState>();
+        }
+        state = slot.get();
+    }
+    auto &entry       = threadStateCache[threadStateCacheNext++ % THREAD_STATE_CACHE_SIZE];
+    entry.allocatorId = _id;
+    entry.state       = state;
+    return state;
+}
+
+ThreadSafeGrowableLinearAllocator::Block ThreadSafeGrowableLinearAllocator::acquireBlock(size_t size) noexcept {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Block block;
+    if (size <= _blockSize && !_freeBlocks.empty()) {
+        block = _freeBlocks.back();
+        _freeBlocks.pop_back();
+    } else {
+        block.size = std::max(size, static_cast<size_t>(_blockSize));
+        block.data = static_cast<uint8_t *>(malloc(block.size));
+        if (!block.data) {
+            return {};
+        }
+        _capacity.fetch_add(block.size, std::memory_order_relaxed);
+    }
+    _usedBlocks.push_back(block);
+    return block;
+}
+
+size_t ThreadSafeGrowableLinearAllocator::getUsedSize() const noexcept {
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t                      usedSize = 0;
+    for (const auto &pair : _threadStates) {
+        usedSize += pair.second->usedSize.load(std::memory_order_relaxed);
+    }
+    return usedSize;
+}
+
+size_t ThreadSafeGrowableLinearAllocator::getPeakUsedSize() const noexcept {
+    const size_t                usedSize = getUsedSize();
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::max(_peakUsedSize, usedSize);
+}
+
+void ThreadSafeGrowableLinearAllocator::recycle() noexcept {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    size_t usedSize = 0;
+    for (auto &pair : _threadStates) {
+        auto &state = pair.second;
+        usedSize += state->usedSize.load(std::memory_order_relaxed);
+        state->usedSize.store(0, std::memory_order_relaxed);
+        state->cursor = nullptr;
+        state->end    = nullptr;
+    }
+    _peakUsedSize = std::max(_peakUsedSize, usedSize);
+
+    // dedicated blocks go back to the system, the pool only keeps blocks of the regular size
+    for (auto &block : _usedBlocks) {
+        if (block.size == _blockSize) {
+            _freeBlocks.push_back(block);
+        } else {
+            free(block.data);
+            _capacity.fetch_sub(block.size, std::memory_order_relaxed);
+        }
+    }
+    _usedBlocks.clear();
+}
+
+} // namespace cc
@@ -0,0 +1,100 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cc {
+
+/**
+ * Linear allocator which grows on demand and doesn't contend between threads.
+ * Every thread bumps a pointer in a block of its own, blocks are carved from a pool shared by the allocator,
+ * so threads only synchronize when they need a new block. Requests bigger than a block get a dedicated one.
+ * recycle() hands all the blocks back to the pool at once, usually when the scratch memory of a frame is done with.
+ * Alignments must be powers of two. Each allocating thread keeps a small state until the allocator is destroyed,
+ * looked up by thread id, a thread reusing the id of an exited one takes its state over.
+ */
+class ThreadSafeGrowableLinearAllocator final {
+public:
+    static constexpr uint32_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit ThreadSafeGrowableLinearAllocator(uint32_t blockSize = DEFAULT_BLOCK_SIZE) noexcept;
+    ~ThreadSafeGrowableLinearAllocator();
+    ThreadSafeGrowableLinearAllocator(ThreadSafeGrowableLinearAllocator const &) = delete;
+    ThreadSafeGrowableLinearAllocator(ThreadSafeGrowableLinearAllocator &&)      = delete;
+    ThreadSafeGrowableLinearAllocator &operator=(ThreadSafeGrowableLinearAllocator const &) = delete;
+    ThreadSafeGrowableLinearAllocator &operator=(ThreadSafeGrowableLinearAllocator &&) = delete;
+
+    template <typename T>
+    inline T *allocate(size_t count, size_t alignment = 1) noexcept {
+        return reinterpret_cast<T *>(doAllocate(count * sizeof(T), alignment));
+    }
+
+    // no thread may allocate while recycling
+    void recycle() noexcept;
+
+    inline uint32_t getBlockSize() const noexcept { return _blockSize; }
+    inline size_t   getCapacity() const noexcept { return _capacity.load(std::memory_order_relaxed); }
+    // bytes handed out since the last recycle, alignment padding excluded
+    size_t getUsedSize() const noexcept;
+    // the most bytes ever in use between two recycles
+    size_t getPeakUsedSize() const noexcept;
+
+private:
+    struct Block {
+        uint8_t *data{nullptr};
+        size_t   size{0};
+    };
+
+    struct alignas(64) ThreadState {
+        uint8_t *           cursor{nullptr};
+        uint8_t *           end{nullptr};
+        std::atomic<size_t> usedSize{0}; // only written by the owning thread
+    };
+
+    void *       doAllocate(size_t size, size_t alignment) noexcept;
+    void *       allocateSlow(ThreadState *state, size_t size, size_t alignment) noexcept;
+    ThreadState *getThreadState() noexcept;
+    Block        acquireBlock(size_t size) noexcept;
+
+    uint64_t                                                          _id{0};
+    uint32_t                                                          _blockSize{DEFAULT_BLOCK_SIZE};
+    std::atomic<size_t>                                               _capacity{0};
+    size_t                                                            _peakUsedSize{0};
+    mutable std::mutex                                                _mutex;
+    std::unordered_map<std::thread::id, std::unique_ptr<ThreadState>> _threadStates;
+    std::vector<Block>                                                _freeBlocks;
+    std::vector<Block>                                                _usedBlocks;
+};
+
+} // namespace cc
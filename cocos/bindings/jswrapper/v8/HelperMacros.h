@@ -35,6 +35,7 @@
 #include "../ValueArrayPool.h"
 #include "../config.h"
 #include "base/Log.h"
+#include "base/memory/TaggedMemoryTracker.h"
 
 //#define RECORD_JSB_INVOKING
 
@@ -55,12 +56,13 @@ private:
     const char *                                                _functionName;
     std::chrono::time_point<std::chrono::high_resolution_clock> _start;
 };
-        #define JsbInvokeScope(arg) JsbInvokeScopeT invokeScope(arg); // NOLINT(readability-identifier-naming)
+        // NOLINTNEXTLINE(readability-identifier-naming)
+        #define JsbInvokeScope(arg)            \
+            JsbInvokeScopeT invokeScope(arg); \
+            CC_MEMORY_TAG_SCOPE(cc::MemoryTag::SCRIPT)
     #else
         // NOLINTNEXTLINE(readability-identifier-naming)
-        #define JsbInvokeScope(arg) \
-            do {                    \
-            } while (0)
+        #define JsbInvokeScope(arg) CC_MEMORY_TAG_SCOPE(cc::MemoryTag::SCRIPT)
 
     #endif
 
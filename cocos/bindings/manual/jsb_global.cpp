@@ -26,9 +26,9 @@
 #include "jsb_global.h"
 #include "base/CoreStd.h"
 #include "base/Scheduler.h"
-#include "base/ThreadPool.h"
 #include "base/ZipUtils.h"
 #include "base/base64.h"
+#include "base/threading/TaskPool.h"
 #include "gfx-base/GFXDef.h"
 #include "jsb_conversions.h"
 #include "network/Downloader.h"
@@ -49,7 +49,7 @@
 
 using namespace cc; //NOLINT
 
-static LegacyThreadPool *gThreadPool = nullptr;
+static TaskPool *gThreadPool = nullptr;
 
 static std::shared_ptr<cc::network::Downloader>                                               gLocalDownloader = nullptr;
 static std::map<std::string, std::function<void(const std::string &, unsigned char *, uint)>> gLocalDownloaderHandlers;
@@ -859,7 +859,7 @@ SE_BIND_FUNC(JSB_hideInputBox)
 #endif
 
 bool jsb_register_global_variables(se::Object *global) { //NOLINT
-    gThreadPool = LegacyThreadPool::newFixedThreadPool(3);
+    gThreadPool = new TaskPool(3);
 
     global->defineFunction("require", _SE(require));
     global->defineFunction("requireModule", _SE(moduleRequire));
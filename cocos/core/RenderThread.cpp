@@ -0,0 +1,81 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/RenderThread.h"
+
+namespace cc {
+
+RenderThread::RenderThread()
+: _thread(&RenderThread::loop, this) {
+}
+
+RenderThread::~RenderThread() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _exit = true;
+    }
+    _condition.notify_all();
+    _thread.join();
+}
+
+void RenderThread::kick(std::function<void()> &&task) {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = std::move(task);
+        _busy.store(true, std::memory_order_release);
+    }
+    _condition.notify_all();
+}
+
+void RenderThread::wait() {
+    // the flag keeps the common idle case free of locking, callers fence on every gfx message
+    if (!isBusy()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this]() { return !_busy.load(std::memory_order_relaxed); });
+}
+
+void RenderThread::loop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _condition.wait(lock, [this]() { return _exit || _busy.load(std::memory_order_relaxed); });
+        if (_exit) {
+            break;
+        }
+
+        lock.unlock();
+        _task();
+        lock.lock();
+
+        _task = nullptr;
+        _busy.store(false, std::memory_order_release);
+        _condition.notify_all();
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,68 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "base/Macros.h"
+
+namespace cc {
+
+/**
+ * A thread that runs one frame's rendering at a time.
+ * kick() hands over the work for a frame, wait() blocks until it is done.
+ */
+class RenderThread final {
+public:
+    RenderThread();
+    ~RenderThread();
+    RenderThread(const RenderThread &) = delete;
+    RenderThread(RenderThread &&)      = delete;
+    RenderThread &operator=(const RenderThread &) = delete;
+    RenderThread &operator=(RenderThread &&) = delete;
+
+    // waits for the previous frame before taking the new one
+    void kick(std::function<void()> &&task);
+    void wait();
+
+    inline bool isBusy() const { return _busy.load(std::memory_order_acquire); }
+    inline bool isCurrentThread() const { return std::this_thread::get_id() == _thread.get_id(); }
+
+private:
+    void loop();
+
+    std::function<void()>   _task;
+    std::atomic<bool>       _busy{false};
+    bool                    _exit{false};
+    std::mutex              _mutex;
+    std::condition_variable _condition;
+    std::thread             _thread;
+};
+
+} // namespace cc
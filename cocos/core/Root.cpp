@@ -24,9 +24,16 @@
  ****************************************************************************/
 
 #include "core/Root.h"
+#include "2d/renderer/Batcher2d.h"
+#include "2d/renderer/DynamicAtlasManager.h"
+#include "base/memory/FrameArena.h"
+#include "base/memory/TaggedMemoryTracker.h"
 #include "core/Director.h"
+#include "core/RenderThread.h"
+#include "core/assets/TextureStreamer.h"
 #include "core/event/CallbacksInvoker.h"
 #include "core/event/EventTypesToJS.h"
+#include "renderer/gfx-agent/DeviceAgent.h"
 #include "renderer/gfx-base/GFXDef.h"
 #include "renderer/pipeline/deferred/DeferredPipeline.h"
 #include "renderer/pipeline/forward/ForwardPipeline.h"
@@ -52,6 +59,7 @@ Root::Root(gfx::Device *device)
 }
 
 Root::~Root() {
+    setFramePipelining(false);
     instance = nullptr;
     delete _cameraPool;
     CC_SAFE_DELETE(_eventProcessor);
@@ -87,17 +95,20 @@ void Root::initialize() {
 }
 
 void Root::destroy() {
+    setFramePipelining(false);
     destroyScenes();
 
+    DynamicAtlasManager::getInstance()->reset();
+    TextureStreamer::destroyInstance();
+    CC_SAFE_DELETE(_batcher2D);
     CC_SAFE_DESTROY(_pipeline);
-    // TODO(minggo):
-    //    CC_SAFE_DESTROY(_batcher2D);
 
     // TODO(minggo):
     //    this.dataPoolManager.clear();
 }
 
 void Root::resize(uint32_t width, uint32_t height) {
+    waitForRender();
     _device->resize(width, height);
     _mainWindow->resize(width, height);
     for (const auto &window : _windows) {
@@ -111,6 +122,7 @@ void Root::resize(uint32_t width, uint32_t height) {
 }
 
 bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
+    waitForRender();
     if (rppl != nullptr && dynamic_cast<pipeline::DeferredPipeline *>(rppl) != nullptr) {
         _useDeferredPipeline = true;
     }
@@ -134,20 +146,22 @@ bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
 
     onGlobalPipelineStateChanged();
 
-    _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_INIT, this);
-    // TODO(minggo):
-    //    if (!_batcher) {
-    //        _batcher = new Batcher2D(this);
-    //        if (!this._batcher.initialize()) {
-    //            this.destroy();
-    //            return false;
-    //        }
-    //    }
+    if (!_nativeBatcher2D) {
+        _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_INIT, this);
+    }
+    if (!_batcher2D) {
+        _batcher2D = CC_NEW(Batcher2d(this));
+        if (!_batcher2D->initialize()) {
+            destroy();
+            return false;
+        }
+    }
 
     return true;
 }
 
 void Root::onGlobalPipelineStateChanged() {
+    waitForRender();
     for (const auto &scene : _scenes) {
         scene->onGlobalPipelineStateChanged();
     }
@@ -163,8 +177,75 @@ void Root::resetCumulativeTime() {
     _cumulativeTime = 0;
 }
 
+void Root::setFramePipelining(bool enabled) {
+    if (enabled == isFramePipelining()) {
+        return;
+    }
+
+    auto *agent = gfx::DeviceAgent::getInstance();
+    if (enabled) {
+        // without the agent, or in its immediate mode, the backend would be driven from two threads
+        if (agent == nullptr || agent != _device || !agent->isMultithreaded()) {
+            CC_LOG_WARNING("Frame pipelining needs the multithreaded gfx agent, keep rendering on the main thread.");
+            return;
+        }
+        _mainThreadId = std::this_thread::get_id();
+        _renderThread = new RenderThread();
+        agent->setProducerFence([this]() {
+            if (std::this_thread::get_id() == _mainThreadId) {
+                waitForRender();
+            }
+        });
+    } else {
+        waitForRender();
+        agent->setProducerFence(nullptr);
+        CC_SAFE_DELETE(_renderThread);
+        if (_batcher2DResetPending) {
+            resetBatcher2D();
+        }
+    }
+}
+
+void Root::setNativeBatcher2D(bool enabled) {
+    if (enabled == _nativeBatcher2D) {
+        return;
+    }
+
+    // the batches of the frame being rendered belong to the path that built them
+    waitForRender();
+    resetBatcher2D();
+    _nativeBatcher2D = enabled;
+    if (!enabled) {
+        _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_INIT, this);
+    }
+}
+
+void Root::waitForRender() {
+    if (_renderThread && !_renderThread->isCurrentThread()) {
+        _renderThread->wait();
+    }
+}
+
+void Root::resetBatcher2D() {
+    _batcher2DResetPending = false;
+    if (!_nativeBatcher2D) {
+        _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_RESET, this);
+    } else if (_batcher2D) {
+        _batcher2D->reset();
+    }
+}
+
 void Root::frameMove(float deltaTime, int32_t totalFrames) {
+    // the previous frame may still be rendering, everything below changes what it reads
+    waitForRender();
+    if (_batcher2DResetPending) {
+        resetBatcher2D();
+    }
+
     _frameTime = deltaTime;
+#if CC_USE_TAGGED_MEMORY_TRACKER
+    TaggedMemoryTracker::update();
+#endif
 
     ++_frameCount;
     _cumulativeTime += deltaTime;
@@ -179,12 +260,11 @@ void Root::frameMove(float deltaTime, int32_t totalFrames) {
         scene->removeBatches();
     }
 
-    _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_UPDATE, this); //cjh added for sync logic in ts.
-
-    // TODO(minggo):
-    //    if (_batcher) {
-    //        _batcher.update();
-    //    }
+    if (!_nativeBatcher2D) {
+        _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_UPDATE, this); //cjh added for sync logic in ts.
+    } else if (_batcher2D) {
+        _batcher2D->update();
+    }
 
     //
     std::vector<scene::Camera *> cameraList;
@@ -194,16 +274,23 @@ void Root::frameMove(float deltaTime, int32_t totalFrames) {
 
     if (_pipeline != nullptr && !cameraList.empty()) {
         _device->acquire();
+        _device->flushTextureUploads();
+        DynamicAtlasManager::getInstance()->update();
+        TextureStreamer::getInstance()->update();
         //cjh TODO:        const stamp = legacyCC.director.getTotalFrames();
         uint32_t stamp = totalFrames;
 
-        _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_UPLOAD_BUFFERS, this);
-        //                if (_batcher != nullptr) {
-        //                    _batcher->uploadBuffers();
-        //                }
+        if (!_nativeBatcher2D) {
+            _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_UPLOAD_BUFFERS, this);
+        } else if (_batcher2D) {
+            _batcher2D->uploadBuffers();
+        }
 
-        for (const auto &scene : _scenes) {
-            scene->update(stamp);
+        {
+            CC_MEMORY_TAG_SCOPE(MemoryTag::SCENE);
+            for (const auto &scene : _scenes) {
+                scene->update(stamp);
+            }
         }
 
         _eventProcessor->emit(EventTypesToJS::DIRECTOR_BEFORE_COMMIT, this);
@@ -211,15 +298,31 @@ void Root::frameMove(float deltaTime, int32_t totalFrames) {
         std::stable_sort(cameraList.begin(), cameraList.end(), [](const auto *a, const auto *b) {
             return a->getPriority() < b->getPriority();
         });
-        _pipeline->render(cameraList);
-        _device->present();
+        if (_renderThread) {
+            _renderThread->kick([this, cameraList = std::move(cameraList)]() {
+                CC_MEMORY_TAG_SCOPE(MemoryTag::GFX);
+                _pipeline->render(cameraList);
+                _device->present();
+                FrameArena::getInstance()->nextFrame();
+            });
+        } else {
+            CC_MEMORY_TAG_SCOPE(MemoryTag::GFX);
+            _pipeline->render(cameraList);
+            _device->present();
+            FrameArena::getInstance()->nextFrame();
+        }
     }
 
-    _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_RESET, this);
-    //cjh TODO:    if (this._batcher) this._batcher.reset();
+    // the 2D batches are drawn by the render thread, they are reset at the start of the next frame instead
+    if (_renderThread) {
+        _batcher2DResetPending = true;
+    } else {
+        resetBatcher2D();
+    }
 }
 
 scene::RenderWindow *Root::createWindow(scene::IRenderWindowInfo &info) {
+    waitForRender();
     SharedPtr<scene::RenderWindow> window = new scene::RenderWindow();
 
     window->initialize(_device, info);
@@ -228,6 +331,7 @@ scene::RenderWindow *Root::createWindow(scene::IRenderWindowInfo &info) {
 }
 
 void Root::destroyWindow(scene::RenderWindow *window) {
+    waitForRender();
     auto it = std::find(_windows.begin(), _windows.end(), window);
     if (it != _windows.end()) {
         CC_SAFE_DESTROY(*it);
@@ -236,6 +340,7 @@ void Root::destroyWindow(scene::RenderWindow *window) {
 }
 
 void Root::destroyWindows() {
+    waitForRender();
     for (const auto &window : _windows) {
         CC_SAFE_DESTROY(window);
     }
@@ -243,6 +348,7 @@ void Root::destroyWindows() {
 }
 
 scene::RenderScene *Root::createScene(const scene::IRenderSceneInfo &info) {
+    waitForRender();
     SharedPtr<scene::RenderScene> scene = new scene::RenderScene();
     scene->initialize(info);
     _scenes.emplace_back(scene);
@@ -250,6 +356,7 @@ scene::RenderScene *Root::createScene(const scene::IRenderSceneInfo &info) {
 }
 
 void Root::destroyScene(scene::RenderScene *scene) {
+    waitForRender();
     auto it = std::find(_scenes.begin(), _scenes.end(), scene);
     if (it != _scenes.end()) {
         CC_SAFE_DESTROY(*it);
@@ -258,6 +365,7 @@ void Root::destroyScene(scene::RenderScene *scene) {
 }
 
 void Root::destroyScenes() {
+    waitForRender();
     for (const auto &scene : _scenes) {
         CC_SAFE_DESTROY(scene);
     }
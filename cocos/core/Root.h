@@ -25,6 +25,7 @@
 #pragma once
 
 #include <cstdint>
+#include <thread>
 #include <vector>
 #include "3d/skeletal-animation/DataPoolManager.h"
 #include "core/memop/Pool.h"
@@ -43,6 +44,8 @@
 namespace cc {
 
 class CallbacksInvoker;
+class Batcher2d;
+class RenderThread;
 
 class Root final {
 public:
@@ -85,6 +88,26 @@ public:
      */
     void frameMove(float deltaTime, int32_t totalFrames); // TODO: c++ doesn't have a Director, so totalFrames need to be set from JS
 
+    /**
+     * Frame pipelining: the pipeline renders and presents frame N on a render thread while the main thread
+     * goes on with the logic of frame N+1. The pipeline reads camera, light and model transforms snapshotted
+     * by the scene update, and the main thread waits for the render thread before it changes anything else
+     * the pipeline reads or sends anything to the gfx device. Needs the multithreaded gfx agent.
+     */
+    void        setFramePipelining(bool enabled);
+    inline bool isFramePipelining() const { return _renderThread != nullptr; }
+
+    /**
+     * Native 2D batching: Batcher2d merges the enabled UIRenderers in hierarchy order and the ROOT_BATCH2D_*
+     * events are no longer sent to the script batcher, so the two paths never draw the same frame.
+     * Turn it on once the 2D components fill UIRenderers through the sprite and label assemblers.
+     */
+    void        setNativeBatcher2D(bool enabled);
+    inline bool isNativeBatcher2D() const { return _nativeBatcher2D; }
+
+    // Blocks until the render thread is done with the frame it was handed, a no-op without frame pipelining
+    void waitForRender();
+
     /**
      * @zh
      * 创建窗口
@@ -137,6 +160,7 @@ public:
         if (model == nullptr) {
             return;
         }
+        waitForRender();
         model->destroy();
         if (model->getScene() != nullptr) {
             model->getScene()->removeModel(model);
@@ -155,6 +179,7 @@ public:
         if (light == nullptr) {
             return;
         }
+        waitForRender();
         light->destroy();
         if (light->getScene() != nullptr) {
             auto *directionalLightPtr = dynamic_cast<scene::DirectionalLight *>(light);
@@ -223,7 +248,7 @@ public:
      * UI实例
      * 引擎内部使用，用户无需调用此接口
      */
-    inline scene::DrawBatch2D *getBatcher2D() const { return _batcher2D; }
+    inline Batcher2d *getBatcher2D() const { return _batcher2D; }
 
     /**
      * @zh
@@ -270,13 +295,19 @@ public:
     inline CallbacksInvoker *getEventProcessor() const { return _eventProcessor; }
 
 private:
+    void resetBatcher2D();
+
     gfx::Device *                               _device{nullptr};
     SharedPtr<scene::RenderWindow>              _mainWindow;
     SharedPtr<scene::RenderWindow>              _curWindow;
     SharedPtr<scene::RenderWindow>              _tempWindow;
     std::vector<SharedPtr<scene::RenderWindow>> _windows;
     pipeline::RenderPipeline *                  _pipeline{nullptr};
-    scene::DrawBatch2D *                        _batcher2D{nullptr};
+    Batcher2d *                                 _batcher2D{nullptr};
+    RenderThread *                              _renderThread{nullptr};
+    std::thread::id                             _mainThreadId;
+    bool                                        _batcher2DResetPending{false};
+    bool                                        _nativeBatcher2D{false};
     SharedPtr<DataPoolManager>                  _dataPoolMgr;
     std::vector<SharedPtr<scene::RenderScene>>  _scenes;
     memop::Pool<scene::Camera> *                _cameraPool{nullptr};
@@ -103,7 +103,7 @@ public:
         return static_cast<double>(getHashForMaterial(material));
     }
 
-    Material()           = default;
+    Material() { enableThreadSafeRefCount(); }
     ~Material() override = default;
 
     /**
@@ -60,6 +60,8 @@ RenderingSubMesh::RenderingSubMesh(const gfx::BufferList &   vertexBuffers,
     _iaInfo.vertexBuffers  = vertexBuffers;
     _iaInfo.indexBuffer    = indexBuffer;
     _iaInfo.indirectBuffer = indirectBuffer;
+    // kept alive by the loading and render threads too
+    enableThreadSafeRefCount();
 }
 
 RenderingSubMesh::~RenderingSubMesh() = default;
@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "core/assets/SimpleTexture.h"
+#include "2d/renderer/DynamicAtlasManager.h"
 #include "core/assets/ImageAsset.h"
 #include "core/event/EventTypesToJS.h"
 #include "core/platform/Macro.h"
@@ -157,6 +158,10 @@ void SimpleTexture::createTexture(gfx::Device *device) {
         getGFXFormat(),
         _mipmapLevel,
         flags | gfx::TextureFlagBit::IMMUTABLE);
+    // TRANSFER_SRC lets small textures be copied into dynamic atlas pages
+    if (DynamicAtlasManager::getInstance()->isCandidate(textureCreateInfo.type, textureCreateInfo.format, textureCreateInfo.width, textureCreateInfo.height)) {
+        textureCreateInfo.usage |= gfx::TextureUsageBit::TRANSFER_SRC;
+    }
 
     //cjh    if (!textureCreateInfo) {
     //        return;
@@ -29,9 +29,19 @@
 
 #include "base/Log.h"
 #include "core/assets/ImageAsset.h"
+#include "core/assets/TextureStreamer.h"
+#include "renderer/gfx-base/GFXDevice.h"
 
 namespace cc {
 
+Texture2D::~Texture2D() {
+    // the pending upload holds a callback into this texture
+    cancelStreaming();
+    if (TextureStreamer::hasInstance()) {
+        TextureStreamer::getInstance()->removeTexture(this);
+    }
+}
+
 void Texture2D::syncMipmapsForJS(const std::vector<SharedPtr<ImageAsset>> &value) {
     _mipmaps = value;
 }
@@ -39,15 +49,25 @@ void Texture2D::syncMipmapsForJS(const std::vector<SharedPtr<ImageAsset>> &value
 void Texture2D::setMipmaps(const std::vector<SharedPtr<ImageAsset>> &value) {
     _mipmaps = value;
     setMipmapLevel(_mipmaps.size());
+    cancelStreaming();
+    _residentLevel = 0;
+
+    // textures with authored mipmaps are tracked even while streaming is disabled, so enabling it later covers them,
+    // they only start from their low levels and are streamed in on demand while it is enabled
+    auto *     streamer   = TextureStreamer::getInstance();
+    const bool streamable = _mipmaps.size() > 1;
     if (!_mipmaps.empty()) {
         ImageAsset *imageAsset = _mipmaps[0];
+        if (streamable && streamer->isEnabled()) {
+            _residentLevel = streamer->getInitialLevel(imageAsset->getWidth(), imageAsset->getHeight(), _mipmaps.size());
+        }
         reset({.width       = imageAsset->getWidth(),
                .height      = imageAsset->getHeight(),
                .format      = imageAsset->getFormat(),
                .mipmapLevel = static_cast<uint32_t>(_mipmaps.size())});
 
-        for (size_t i = 0, len = _mipmaps.size(); i < len; ++i) {
-            assignImage(_mipmaps[i], i);
+        for (size_t i = _residentLevel, len = _mipmaps.size(); i < len; ++i) {
+            assignImage(_mipmaps[i], i - _residentLevel);
         }
 
     } else {
@@ -55,6 +75,12 @@ void Texture2D::setMipmaps(const std::vector<SharedPtr<ImageAsset>> &value) {
                .height      = 0,
                .mipmapLevel = static_cast<uint32_t>(_mipmaps.size())});
     }
+
+    if (streamable) {
+        streamer->addTexture(this);
+    } else {
+        streamer->removeTexture(this);
+    }
 }
 
 void Texture2D::initialize() {
@@ -101,7 +127,9 @@ void Texture2D::updateMipmaps(uint32_t firstLevel, uint32_t count) {
 
     for (uint32_t i = 0; i < nUpdate; ++i) {
         uint32_t level = firstLevel + i;
-        assignImage(_mipmaps[level], level);
+        if (level >= _residentLevel) {
+            assignImage(_mipmaps[level], level - _residentLevel);
+        }
     }
 }
 
@@ -110,6 +138,11 @@ HTMLElement *Texture2D::getHtmlElementObj() { //NOLINT
 }
 
 bool Texture2D::destroy() {
+    if (TextureStreamer::hasInstance()) {
+        TextureStreamer::getInstance()->removeTexture(this);
+    }
+    cancelStreaming();
+    _residentLevel = 0;
     _mipmaps.clear();
     return Super::destroy();
 }
@@ -170,11 +203,11 @@ void Texture2D::deserialize(const cc::any &serializedData, const cc::any &handle
 gfx::TextureInfo Texture2D::getGfxTextureCreateInfo(gfx::TextureUsageBit usage, gfx::Format format, uint32_t levelCount, gfx::TextureFlagBit flags) {
     gfx::TextureInfo texInfo;
     texInfo.type       = gfx::TextureType::TEX2D;
-    texInfo.width      = _width;
-    texInfo.height     = _height;
+    texInfo.width      = std::max(_width >> _residentLevel, 1U);
+    texInfo.height     = std::max(_height >> _residentLevel, 1U);
     texInfo.usage      = usage;
     texInfo.format     = format;
-    texInfo.levelCount = levelCount;
+    texInfo.levelCount = levelCount > _residentLevel ? levelCount - _residentLevel : 1U;
     texInfo.flags      = flags;
     return texInfo;
 }
@@ -190,4 +223,86 @@ bool Texture2D::validate() const {
     return !_mipmaps.empty();
 }
 
+void Texture2D::streamToLevel(uint32_t level) {
+    auto *device = getGFXDevice();
+    if (!device || !_gfxTexture || _mipmaps.size() < 2) {
+        return;
+    }
+
+    level = std::min(level, static_cast<uint32_t>(_mipmaps.size()) - 1);
+    if (_streamingTexture && _streamingLevel == level) {
+        return;
+    }
+    cancelStreaming();
+    if (level == _residentLevel) {
+        return;
+    }
+
+    // every level has to be uploaded before the swap, keep the current texture if one can't be
+    std::vector<const uint8_t *>        buffers;
+    std::vector<gfx::BufferTextureCopy> regions;
+    for (uint32_t i = level; i < _mipmaps.size(); ++i) {
+        const uint8_t *data = _mipmaps[i]->getData();
+        if (!data) {
+            return;
+        }
+        gfx::BufferTextureCopy region;
+        region.texExtent.width    = std::max(_width >> i, 1U);
+        region.texExtent.height   = std::max(_height >> i, 1U);
+        region.texSubres.mipLevel = i - level;
+        regions.push_back(region);
+        buffers.push_back(data);
+    }
+
+    gfx::TextureInfo texInfo;
+    texInfo.type       = gfx::TextureType::TEX2D;
+    texInfo.width      = std::max(_width >> level, 1U);
+    texInfo.height     = std::max(_height >> level, 1U);
+    texInfo.usage      = gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST;
+    texInfo.format     = getGFXFormat();
+    texInfo.levelCount = static_cast<uint32_t>(_mipmaps.size()) - level;
+    texInfo.flags      = gfx::TextureFlagBit::IMMUTABLE;
+
+    _streamingTexture = device->createTexture(texInfo);
+    _streamingLevel   = level;
+
+    // the callback runs once the GPU has finished every level, so nothing is ever sampled half-uploaded.
+    // Destroying the streaming texture drops it, which cancelStreaming does before this texture goes away.
+    device->copyBuffersToTextureAsync(buffers.data(), _streamingTexture, regions.data(), static_cast<uint32_t>(regions.size()), [this]() {
+        finishStreaming();
+    });
+}
+
+uint32_t Texture2D::getStreamingSize(uint32_t level) const {
+    const gfx::Format format = getGFXFormat();
+
+    uint32_t size = 0;
+    for (uint32_t i = level; i < _mipmaps.size(); ++i) {
+        size += gfx::formatSize(format, std::max(_width >> i, 1U), std::max(_height >> i, 1U), 1);
+    }
+    return size;
+}
+
+void Texture2D::finishStreaming() {
+    SharedPtr<gfx::Texture> oldTexture = _gfxTexture;
+
+    _gfxTexture       = _streamingTexture;
+    _streamingTexture = nullptr;
+    _residentLevel    = _streamingLevel;
+    _textureWidth     = _gfxTexture->getWidth();
+    _textureHeight    = _gfxTexture->getHeight();
+
+    if (oldTexture) {
+        oldTexture->destroy();
+    }
+    notifyTextureUpdated();
+}
+
+void Texture2D::cancelStreaming() {
+    if (_streamingTexture) {
+        _streamingTexture->destroy(); // drops the pending upload as well
+        _streamingTexture = nullptr;
+    }
+}
+
 } // namespace cc
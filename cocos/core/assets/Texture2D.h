@@ -79,8 +79,8 @@ class Texture2D final : public SimpleTexture {
 public:
     using Super = SimpleTexture;
 
-    explicit Texture2D()  = default;
-    ~Texture2D() override = default;
+    explicit Texture2D() = default;
+    ~Texture2D() override;
 
     /**
      * @en All levels of mipmap images, be noted, automatically generated mipmaps are not included.
@@ -199,9 +199,38 @@ public:
 
     bool validate() const override;
 
+    // Mip streaming, driven by TextureStreamer
+
+    /**
+     * @en The first mipmap level resident on the GPU, levels above it are not uploaded.
+     * @zh 当前驻留在 GPU 上的最高 Mipmap 层级。
+     */
+    inline uint32_t getResidentLevel() const { return _residentLevel; }
+    inline bool     isStreaming() const { return _streamingTexture != nullptr; }
+
+    /**
+     * @en Asynchronously replace the GPU texture with one holding the mipmaps from the given level on.
+     * The previous texture remains in use until the upload is finished.
+     * @zh 异步地将 GPU 贴图替换为从指定层级开始的 Mipmap，上传完成前继续使用原贴图。
+     */
+    void streamToLevel(uint32_t level);
+
+    /**
+     * @en The GPU memory taken by the mipmaps from the given level on.
+     * @zh 从指定层级开始的所有 Mipmap 占用的显存大小。
+     */
+    uint32_t getStreamingSize(uint32_t level) const;
+
 private:
+    void finishStreaming();
+    void cancelStreaming();
+
     std::vector<SharedPtr<ImageAsset>> _mipmaps;
 
+    SharedPtr<gfx::Texture> _streamingTexture{nullptr};
+    uint32_t                _streamingLevel{0};
+    uint32_t                _residentLevel{0};
+
     std::vector<std::string> _mipmapsUuids; // TODO(xwx): temporary use _mipmaps as UUIDs string array
 
     friend class Texture2DDeserializer;
@@ -24,7 +24,10 @@
 ****************************************************************************/
 
 #include "core/assets/TextureBase.h"
+#include "2d/renderer/Batcher2d.h"
+#include "2d/renderer/DynamicAtlasManager.h"
 #include "base/StringUtil.h"
+#include "core/Root.h"
 #include "core/event/EventTypesToJS.h"
 #include "core/utils/IDGenerator.h"
 
@@ -45,6 +48,8 @@ TextureBase::TextureBase() {
     _gfxDevice   = getGFXDevice();
     _textureHash = murmurhash2::MurmurHash2(_id.data(), static_cast<int>(_id.length()), 666); //cjh TODO: How about using boost hash functionality?
     _samplerHash = pipeline::SamplerLib::genSamplerHash(_samplerInfo);
+    // retained by async uploads and the render thread
+    enableThreadSafeRefCount();
 }
 
 void TextureBase::setWrapMode(WrapMode wrapS, WrapMode wrapT, WrapMode wrapR /* = WrapMode::REPEAT*/) {
@@ -102,10 +107,15 @@ void TextureBase::setAnisotropy(uint32_t anisotropy) {
 }
 
 bool TextureBase::destroy() {
-    const bool destroyed = Super::destroy();
-    //cjh TODO:    if (destroyed && legacyCC.director.root?.batcher2D) {
-    //        legacyCC.director.root.batcher2D._releaseDescriptorSetCache(this._textureHash);
-    //    }
+    auto *     gfxTexture = getGFXTexture();
+    const bool destroyed  = Super::destroy();
+    auto *     root       = Root::getInstance();
+    if (destroyed && root && root->getBatcher2D()) {
+        root->getBatcher2D()->releaseDescriptorSetCache(gfxTexture);
+    }
+    if (destroyed && gfxTexture) {
+        DynamicAtlasManager::getInstance()->removeTexture(gfxTexture);
+    }
     return destroyed;
 }
 
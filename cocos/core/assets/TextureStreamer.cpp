@@ -0,0 +1,252 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/assets/TextureStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <vector>
+
+#include "core/assets/Texture2D.h"
+#include "core/geometry/AABB.h"
+#include "renderer/gfx-base/GFXDescriptorSet.h"
+#include "renderer/gfx-base/GFXDescriptorSetLayout.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+#include "scene/Pass.h"
+#include "scene/SubModel.h"
+
+namespace cc {
+
+namespace {
+TextureStreamer *instance = nullptr;
+}
+
+/* static */
+TextureStreamer *TextureStreamer::getInstance() {
+    if (instance == nullptr) {
+        instance = new TextureStreamer();
+    }
+    return instance;
+}
+
+/* static */
+void TextureStreamer::destroyInstance() {
+    CC_SAFE_DELETE(instance);
+}
+
+/* static */
+bool TextureStreamer::hasInstance() {
+    return instance != nullptr;
+}
+
+void TextureStreamer::setEnabled(bool enabled) {
+    if (_enabled == enabled) {
+        return;
+    }
+    _enabled = enabled;
+
+    // the textures stay tracked, so they are streamed again once re-enabled
+    for (auto &iter : _textures) {
+        iter.second = StreamingState();
+        if (!enabled) {
+            // bring everything back to full resolution
+            iter.first->streamToLevel(0);
+        }
+        iter.second.desiredLevel = iter.first->getResidentLevel();
+    }
+    _gfxTextures.clear();
+}
+
+uint64_t TextureStreamer::getResidentSize() const {
+    uint64_t size = 0;
+    for (const auto &iter : _textures) {
+        size += iter.first->getStreamingSize(iter.first->getResidentLevel());
+    }
+    return size;
+}
+
+uint32_t TextureStreamer::getInitialLevel(uint32_t width, uint32_t height, uint32_t levelCount) const {
+    uint32_t level = 0;
+    while (level + 1 < levelCount && std::max(width >> level, height >> level) > INITIAL_RESIDENT_SIZE) {
+        ++level;
+    }
+    return level;
+}
+
+void TextureStreamer::addTexture(Texture2D *texture) {
+    StreamingState &state = _textures[texture];
+    state                 = StreamingState();
+    state.desiredLevel    = texture->getResidentLevel();
+}
+
+void TextureStreamer::removeTexture(Texture2D *texture) {
+    if (_textures.erase(texture)) {
+        for (auto iter = _gfxTextures.begin(); iter != _gfxTextures.end(); ++iter) {
+            if (iter->second == texture) {
+                _gfxTextures.erase(iter);
+                break;
+            }
+        }
+    }
+}
+
+void TextureStreamer::updateModel(const scene::Camera *camera, const scene::Model *model) {
+    if (_gfxTextures.empty()) {
+        return;
+    }
+
+    // the projected diameter of the model bounds, in pixels
+    float screenSize = static_cast<float>(camera->getHeight());
+    if (const auto *bounds = model->getWorldBounds()) {
+        const float radius = bounds->getHalfExtents().length();
+        if (camera->getProjectionType() == scene::CameraProjection::PERSPECTIVE) {
+            const float distance = camera->getPosition().distance(bounds->getCenter()) - radius;
+            if (distance > camera->getNearClip()) {
+                screenSize *= radius / (distance * std::tan(camera->getFov() * 0.5F));
+            }
+        } else if (camera->getOrthoHeight() > 0.F) {
+            screenSize *= radius / camera->getOrthoHeight();
+        }
+    }
+
+    for (const auto &subModel : model->getSubModels()) {
+        for (const auto &pass : subModel->getPasses()) {
+            gfx::DescriptorSet *descriptorSet = pass->getDescriptorSet();
+            if (!descriptorSet || !descriptorSet->getLayout()) {
+                continue;
+            }
+            for (const auto &binding : descriptorSet->getLayout()->getBindings()) {
+                if (!hasFlag(binding.descriptorType, gfx::DescriptorType::SAMPLER_TEXTURE)) {
+                    continue;
+                }
+                for (uint32_t i = 0; i < binding.count; ++i) {
+                    requestLevel(descriptorSet->getTexture(binding.binding, i), screenSize);
+                }
+            }
+        }
+    }
+}
+
+void TextureStreamer::requestLevel(gfx::Texture *gfxTexture, float screenSize) {
+    auto iter = _gfxTextures.find(gfxTexture);
+    if (iter == _gfxTextures.end()) {
+        return;
+    }
+    Texture2D *texture = iter->second;
+
+    // assume the texture spans the model once, one texel per pixel is all it takes
+    const float texSize = static_cast<float>(std::max(texture->getWidth(), texture->getHeight()));
+    uint32_t    level   = 0;
+    if (screenSize > 0.F && texSize > screenSize) {
+        level = static_cast<uint32_t>(std::floor(std::log2(texSize / screenSize)));
+    }
+
+    StreamingState &state  = _textures[texture];
+    state.frameLevel       = std::min(state.frameLevel, level);
+    state.lastVisibleFrame = _frame;
+}
+
+void TextureStreamer::update() {
+    if (!_enabled) {
+        return;
+    }
+
+    // pick the level each texture wants, and the total memory it adds up to
+    uint64_t totalSize = 0;
+    for (auto &iter : _textures) {
+        Texture2D *     texture = iter.first;
+        StreamingState &state   = iter.second;
+
+        const uint32_t lowestLevel = texture->getMipmaps().empty() ? 0 : static_cast<uint32_t>(texture->getMipmaps().size()) - 1;
+        if (state.frameLevel != UINT32_MAX) {
+            state.visibleLevel = state.frameLevel;
+        }
+        state.frameLevel = UINT32_MAX;
+
+        if (state.visibleLevel == UINT32_MAX) {
+            // culling runs after the update, keep what is resident until the texture has been reported once
+            state.desiredLevel = std::min(texture->getResidentLevel(), lowestLevel);
+        } else if (_frame - state.lastVisibleFrame > EVICT_DELAY_FRAMES) {
+            state.desiredLevel = lowestLevel;
+        } else {
+            state.desiredLevel = std::min(state.visibleLevel, lowestLevel);
+        }
+        totalSize += texture->getStreamingSize(state.desiredLevel);
+    }
+
+    // over budget, drop a level from the largest textures first
+    if (totalSize > _budget) {
+        using Candidate = std::pair<uint32_t, Texture2D *>;
+        std::priority_queue<Candidate> candidates;
+        for (auto &iter : _textures) {
+            if (iter.second.desiredLevel + 1 < iter.first->getMipmaps().size()) {
+                candidates.emplace(iter.first->getStreamingSize(iter.second.desiredLevel), iter.first);
+            }
+        }
+        while (totalSize > _budget && !candidates.empty()) {
+            Texture2D *     texture = candidates.top().second;
+            StreamingState &state   = _textures[texture];
+            candidates.pop();
+
+            const uint32_t size = texture->getStreamingSize(state.desiredLevel);
+            ++state.desiredLevel;
+            const uint32_t reduced = texture->getStreamingSize(state.desiredLevel);
+            totalSize -= size - reduced;
+            if (state.desiredLevel + 1 < texture->getMipmaps().size()) {
+                candidates.emplace(reduced, texture);
+            }
+        }
+    }
+
+    // evictions go first so memory is released before more is taken
+    std::vector<std::pair<int32_t, Texture2D *>> requests;
+    for (auto &iter : _textures) {
+        const int32_t delta = static_cast<int32_t>(iter.second.desiredLevel) - static_cast<int32_t>(iter.first->getResidentLevel());
+        if (delta != 0 && !iter.first->isStreaming()) {
+            requests.emplace_back(delta, iter.first);
+        }
+    }
+    std::sort(requests.begin(), requests.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first > rhs.first;
+    });
+    for (size_t i = 0; i < std::min(requests.size(), static_cast<size_t>(MAX_REQUESTS_PER_FRAME)); ++i) {
+        Texture2D *texture = requests[i].second;
+        texture->streamToLevel(_textures[texture].desiredLevel);
+    }
+
+    // gfx textures are swapped once streamed, refresh the lookup used during culling
+    _gfxTextures.clear();
+    for (auto &iter : _textures) {
+        if (gfx::Texture *gfxTexture = iter.first->getGFXTexture()) {
+            _gfxTextures[gfxTexture] = iter.first;
+        }
+    }
+
+    ++_frame;
+}
+
+} // namespace cc
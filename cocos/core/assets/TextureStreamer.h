@@ -0,0 +1,105 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "base/Macros.h"
+
+namespace cc {
+
+namespace gfx {
+class Texture;
+}
+
+namespace scene {
+class Camera;
+class Model;
+} // namespace scene
+
+class Texture2D;
+
+/**
+ * Streams the mipmaps of Texture2D assets in and out under a GPU memory budget.
+ * Textures start from a low level, the level each one needs is estimated from the
+ * screen-space size of the visible models using it, which is reported during culling.
+ */
+class TextureStreamer final {
+public:
+    static TextureStreamer *getInstance();
+    static void             destroyInstance();
+    static bool             hasInstance();
+
+    static constexpr uint64_t DEFAULT_BUDGET         = 256 * 1024 * 1024;
+    static constexpr uint32_t INITIAL_RESIDENT_SIZE  = 64;  // in pixels, the size textures are first loaded at
+    static constexpr uint32_t EVICT_DELAY_FRAMES     = 120; // frames a texture stays detailed after leaving the screen
+    static constexpr uint32_t MAX_REQUESTS_PER_FRAME = 4;
+
+    explicit TextureStreamer() = default;
+    ~TextureStreamer()         = default;
+
+    void        setEnabled(bool enabled);
+    inline bool isEnabled() const { return _enabled; }
+
+    inline void     setBudget(uint64_t bytes) { _budget = bytes; }
+    inline uint64_t getBudget() const { return _budget; }
+    uint64_t        getResidentSize() const;
+    inline size_t   getTextureCount() const { return _textures.size(); }
+
+    uint32_t getInitialLevel(uint32_t width, uint32_t height, uint32_t levelCount) const;
+
+    // Textures with authored mipmaps register themselves, whether streaming is enabled or not
+    void addTexture(Texture2D *texture);
+    void removeTexture(Texture2D *texture);
+
+    // Invoked for every visible model during culling
+    void updateModel(const scene::Camera *camera, const scene::Model *model);
+    // Invoked once per frame, before culling
+    void update();
+
+private:
+    struct StreamingState {
+        uint32_t frameLevel{UINT32_MAX};   // finest level requested in the current frame
+        uint32_t visibleLevel{UINT32_MAX}; // finest level requested while last visible
+        uint32_t lastVisibleFrame{0};
+        uint32_t desiredLevel{0};
+    };
+
+    void requestLevel(gfx::Texture *gfxTexture, float screenSize);
+
+    std::unordered_map<Texture2D *, StreamingState> _textures;
+    std::unordered_map<gfx::Texture *, Texture2D *> _gfxTextures;
+
+    bool     _enabled{false};
+    uint64_t _budget{DEFAULT_BUDGET};
+    uint32_t _frame{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TextureStreamer);
+};
+
+} // namespace cc
@@ -34,6 +34,7 @@
 #include "base/Log.h"
 #include "base/Macros.h"
 #include "base/Utils.h"
+#include "base/memory/SlabAllocator.h"
 #include "core/data/Object.h"
 #include "core/memop/Pool.h"
 
@@ -51,6 +52,17 @@ struct CallbackInfoBase {
     CallbackInfoBase()          = default;
     virtual ~CallbackInfoBase() = default;
 
+    static SlabTypeStats &getSlabTypeStats() {
+        static SlabTypeStats stats{"CallbackInfo"};
+        return stats;
+    }
+
+    // through the slab allocator, infos of every signature are counted together
+    template <typename Info>
+    static std::shared_ptr<Info> create() {
+        return std::allocate_shared<Info>(SlabStlAllocator<Info>(&getSlabTypeStats()));
+    }
+
     virtual bool                 check() const       = 0;
     virtual void                 reset()             = 0;
     virtual FakeCallbackMemberFn getMemberFn() const = 0;
@@ -295,7 +307,7 @@ void CallbacksInvoker::on(const KeyType &key, void (Target::*memberFn)(Args...),
     static_assert(std::is_base_of_v<CCObject, Target>, "Target must be the subclass of CCObject");
     using CallbackInfoType    = CallbackInfo<Args...>;
     auto &list                = _callbackTable[key];
-    auto  info                = std::make_shared<CallbackInfoType>();
+    auto  info                = CallbackInfoBase::create<CallbackInfoType>();
     info->_id                 = ++cbIDCounter;
     CallbackInfoBase::ID cbID = info->_id;
     info->set(static_cast<typename CallbackInfoType::CallbackMemberFn>(memberFn), target, once);
@@ -305,7 +317,7 @@ void CallbacksInvoker::on(const KeyType &key, void (Target::*memberFn)(Args...),
 template <typename Target, typename... Args>
 void CallbacksInvoker::on(const KeyType &key, std::function<void(Args...)> &&callback, Target *target, CallbackInfoBase::ID &outCallbackID, bool once) {
     auto &list                = _callbackTable[key];
-    auto  info                = std::make_shared<CallbackInfo<Args...>>();
+    auto  info                = CallbackInfoBase::create<CallbackInfo<Args...>>();
     info->_id                 = ++cbIDCounter;
     CallbackInfoBase::ID cbID = info->_id;
     info->set(std::forward<std::function<void(Args...)>>(callback), target, once);
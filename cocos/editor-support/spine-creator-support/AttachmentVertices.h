@@ -30,6 +30,7 @@
 #pragma once
 
 #include "base/Macros.h"
+#include "base/memory/SlabAllocator.h"
 #include "middleware-adapter.h"
 
 namespace spine {
@@ -38,6 +39,8 @@ namespace spine {
      */
 class AttachmentVertices {
 public:
+    CC_SLAB_ALLOCATED(AttachmentVertices)
+
     AttachmentVertices(cc::middleware::Texture2D *texture, int verticesCount, unsigned short *triangles, int trianglesCount);
     virtual ~AttachmentVertices();
 
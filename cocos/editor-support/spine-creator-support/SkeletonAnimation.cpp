@@ -31,6 +31,7 @@
 #include <algorithm>
 #include "base/Log.h"
 #include "base/DeferredReleasePool.h"
+#include "base/memory/TaggedMemoryTracker.h"
 #include "spine-creator-support/spine-cocos2dx.h"
 #include "spine/Extension.h"
 
@@ -122,6 +123,7 @@ SkeletonAnimation::~SkeletonAnimation() {
 
 void SkeletonAnimation::update(float deltaTime) {
     if (!_skeleton) return;
+    CC_MEMORY_TAG_SCOPE(cc::MemoryTag::SPINE);
     if (!_paused) {
         deltaTime *= _timeScale * GlobalTimeScale;
         if (_ownsSkeleton) _skeleton->update(deltaTime);
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "IOBuffer.h"
+#include "base/memory/SlabAllocator.h"
 #include "SkeletonAnimation.h"
 #include "middleware-adapter.h"
 #include <vector>
@@ -40,6 +41,8 @@ public:
     struct SegmentData {
         friend class SkeletonCache;
 
+        CC_SLAB_ALLOCATED(SegmentData)
+
         SegmentData();
         ~SegmentData();
 
@@ -56,10 +59,14 @@ public:
     };
 
     struct BoneData {
+        CC_SLAB_ALLOCATED(BoneData)
+
         cc::Mat4 globalTransformMatrix;
     };
 
     struct ColorData {
+        CC_SLAB_ALLOCATED(ColorData)
+
         cc::middleware::Color4F finalColor;
         cc::middleware::Color4F darkColor;
         int vertexFloatOffset = 0;
@@ -68,6 +75,8 @@ public:
     struct FrameData {
         friend class SkeletonCache;
 
+        CC_SLAB_ALLOCATED(FrameData)
+
         FrameData();
         ~FrameData();
 
@@ -34,6 +34,7 @@
 #include "base/TypeDef.h"
 #include "base/memory/Memory.h"
 #include "base/DeferredReleasePool.h"
+#include "base/memory/TaggedMemoryTracker.h"
 #include "math/Math.h"
 #include "math/Vec3.h"
 #include "gfx-base/GFXDef.h"
@@ -262,6 +263,7 @@ void SkeletonRenderer::initWithBinaryFile(const std::string &skeletonDataFile, c
 
 void SkeletonRenderer::render(float /*deltaTime*/) {
     if (!_skeleton) return;
+    CC_MEMORY_TAG_SCOPE(MemoryTag::SPINE);
 
     _sharedBufferOffset->reset();
     _sharedBufferOffset->clear();
@@ -29,6 +29,7 @@
 #include <cstring>
 #include <sstream>
 #include "audio/include/AudioEngine.h"
+#include "base/DeferredReleasePool.h"
 #include "base/Scheduler.h"
 #include "cocos/bindings/event/EventDispatcher.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
@@ -111,6 +112,8 @@ Application::~Application() {
 }
 
 bool Application::init() {
+    DeferredReleasePool::setMainThread();
+
     se::ScriptEngine *se = se::ScriptEngine::getInstance();
     se->addRegisterCallback(setCanvasCallback);
 
@@ -31,6 +31,7 @@
 #include <sstream>
 
 #include "audio/include/AudioEngine.h"
+#include "base/DeferredReleasePool.h"
 #include "base/Scheduler.h"
 #include "bindings/event/EventDispatcher.h"
 #include "bindings/jswrapper/SeApi.h"
@@ -234,6 +235,8 @@ void Application::copyTextToClipboard(const std::string &text) {
 }
 
 bool Application::init() {
+    DeferredReleasePool::setMainThread();
+
     se::ScriptEngine *se = se::ScriptEngine::getInstance();
     se->addRegisterCallback(setCanvasCallback);
 
@@ -32,6 +32,7 @@
 #include <mutex>
 #include <sstream>
 
+#include "base/DeferredReleasePool.h"
 #include "base/Scheduler.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
 #include "platform/Application.h"
@@ -158,6 +159,8 @@ Application::~Application() {
 }
 
 bool Application::init() {
+    DeferredReleasePool::setMainThread();
+
     se::ScriptEngine *se = se::ScriptEngine::getInstance();
     se->addRegisterCallback(setCanvasCallback);
     [_timer start];
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include <string>
 
 #include "audio/include/AudioEngine.h"
+#include "base/DeferredReleasePool.h"
 #include "base/Scheduler.h"
 #include "cocos/bindings/event/EventDispatcher.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
@@ -97,6 +98,8 @@ Application::~Application() {
 }
 
 bool Application::init() {
+    DeferredReleasePool::setMainThread();
+
     se::ScriptEngine *se = se::ScriptEngine::getInstance();
     se->addRegisterCallback(setCanvasCallback);
 
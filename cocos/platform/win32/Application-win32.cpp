@@ -35,6 +35,7 @@
 #include <memory>
 #include <sstream>
 #include "audio/include/AudioEngine.h"
+#include "base/DeferredReleasePool.h"
 #include "base/Scheduler.h"
 #include "cocos/bindings/event/EventDispatcher.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
@@ -79,6 +80,8 @@ Application::~Application() {
 }
 
 bool Application::init() {
+    DeferredReleasePool::setMainThread();
+
     auto scheduler = Application::getInstance()->getScheduler();
     scheduler->removeAllFunctionsToBePerformedInCocosThread();
     scheduler->unscheduleAll();
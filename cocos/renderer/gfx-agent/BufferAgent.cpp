@@ -55,6 +55,8 @@ void BufferAgent::doInit(const BufferInfo &info) {
         }
     }
 
+    _actor->setMemoryTag(_memoryTag); // the tag scope lives on this thread
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         BufferInit,
@@ -37,6 +37,8 @@ namespace gfx {
 
 class CC_DLL BufferAgent final : public Agent<Buffer> {
 public:
+    CC_SLAB_ALLOCATED(BufferAgent)
+
     explicit BufferAgent(Buffer *actor);
     ~BufferAgent() override;
 
@@ -54,7 +54,7 @@ void CommandBufferAgent::flushCommands(uint count, CommandBufferAgent *const *cm
         JobGraph g(JobSystem::getInstance());
         g.createForEachIndexJob(workForThisThread, count, 1U, [cmdBuffs](uint i) {
             cmdBuffs[i]->getMessageQueue()->flushMessages();
-        });
+        }, "CommandBufferAgent::flushCommands");
         g.run();
 
         for (uint i = 0U; i < workForThisThread; ++i) {
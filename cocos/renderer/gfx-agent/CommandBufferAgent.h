@@ -36,6 +36,8 @@ namespace gfx {
 
 class CC_DLL CommandBufferAgent final : public Agent<CommandBuffer> {
 public:
+    CC_SLAB_ALLOCATED(CommandBufferAgent)
+
     explicit CommandBufferAgent(CommandBuffer *actor);
     ~CommandBufferAgent() override;
 
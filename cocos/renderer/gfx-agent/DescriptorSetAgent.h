@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL DescriptorSetAgent final : public Agent<DescriptorSet> {
 public:
+    CC_SLAB_ALLOCATED(DescriptorSetAgent)
+
     explicit DescriptorSetAgent(DescriptorSet *actor);
     ~DescriptorSetAgent() override;
 
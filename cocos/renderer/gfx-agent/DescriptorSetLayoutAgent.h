@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL DescriptorSetLayoutAgent final : public Agent<DescriptorSetLayout> {
 public:
+    CC_SLAB_ALLOCATED(DescriptorSetLayoutAgent)
+
     explicit DescriptorSetLayoutAgent(DescriptorSetLayout *actor);
     ~DescriptorSetLayoutAgent() override;
 
@@ -74,6 +74,7 @@ bool DeviceAgent::doInit(const DeviceInfo &info) {
     _renderer                                           = _actor->getRenderer();
     _vendor                                             = _actor->getVendor();
     _caps                                               = _actor->_caps;
+    _maxFramesInFlight                                  = _actor->_maxFramesInFlight + 1; // the render thread may be a frame behind
     memcpy(_features.data(), _actor->_features.data(), static_cast<uint>(Feature::COUNT) * sizeof(bool));
 
     _mainMessageQueue = CC_NEW(MessageQueue);
@@ -86,8 +87,9 @@ bool DeviceAgent::doInit(const DeviceInfo &info) {
 }
 
 void DeviceAgent::doDestroy() {
+    auto *queue = getMessageQueue();
     ENQUEUE_MESSAGE_1(
-        _mainMessageQueue, DeviceDestroy,
+        queue, DeviceDestroy,
         actor, _actor,
         {
             actor->destroy();
@@ -110,8 +112,9 @@ void DeviceAgent::doDestroy() {
 }
 
 void DeviceAgent::resize(uint width, uint height) {
+    auto *queue = getMessageQueue();
     ENQUEUE_MESSAGE_3(
-        _mainMessageQueue, DeviceResize,
+        queue, DeviceResize,
         actor, _actor,
         width, width,
         height, height,
@@ -121,8 +124,9 @@ void DeviceAgent::resize(uint width, uint height) {
 }
 
 void DeviceAgent::acquire() {
+    auto *queue = getMessageQueue();
     ENQUEUE_MESSAGE_1(
-        _mainMessageQueue, DeviceAcquire,
+        queue, DeviceAcquire,
         actor, _actor,
         {
             actor->acquire();
@@ -130,8 +134,9 @@ void DeviceAgent::acquire() {
 }
 
 void DeviceAgent::present() {
+    auto *queue = getMessageQueue();
     ENQUEUE_MESSAGE_2(
-        _mainMessageQueue, DevicePresent,
+        queue, DevicePresent,
         actor, _actor,
         frameBoundarySemaphore, &_frameBoundarySemaphore,
         {
@@ -139,8 +144,8 @@ void DeviceAgent::present() {
             frameBoundarySemaphore->signal();
         });
 
-    MessageQueue::freeChunksInFreeQueue(_mainMessageQueue);
-    _mainMessageQueue->finishWriting();
+    MessageQueue::freeChunksInFreeQueue(queue);
+    queue->finishWriting();
     _currentIndex = (_currentIndex + 1) % MAX_FRAME_INDEX;
     _frameBoundarySemaphore.wait();
 }
@@ -181,19 +186,21 @@ void DeviceAgent::setMultithreaded(bool multithreaded) {
 }
 
 void DeviceAgent::releaseSurface(uintptr_t windowHandle) {
+    auto *queue = getMessageQueue();
     ENQUEUE_MESSAGE_2(
-        _mainMessageQueue, DeviceReleaseSurface,
+        queue, DeviceReleaseSurface,
         actor, _actor,
         windowHandle, windowHandle,
         {
             actor->releaseSurface(windowHandle);
         });
-    _mainMessageQueue->kickAndWait();
+    queue->kickAndWait();
 }
 
 void DeviceAgent::acquireSurface(uintptr_t windowHandle) {
+    auto *queue = getMessageQueue();
     ENQUEUE_MESSAGE_2(
-        _mainMessageQueue, DeviceAcquireSurface,
+        queue, DeviceAcquireSurface,
         actor, _actor,
         windowHandle, windowHandle,
         {
@@ -275,6 +282,8 @@ TextureBarrier *DeviceAgent::createTextureBarrier() {
 }
 
 void DeviceAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) {
+    auto *queue = getMessageQueue();
+
     uint bufferCount = 0U;
     for (uint i = 0U; i < count; i++) {
         bufferCount += regions[i].texSubres.layerCount;
@@ -305,7 +314,7 @@ void DeviceAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *d
     }
 
     ENQUEUE_MESSAGE_6(
-        _mainMessageQueue, DeviceCopyBuffersToTexture,
+        queue, DeviceCopyBuffersToTexture,
         actor, _actor,
         buffers, actorBuffers,
         dst, static_cast<TextureAgent *>(dst)->getActor(),
@@ -319,8 +328,9 @@ void DeviceAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *d
 }
 
 void DeviceAgent::copyTextureToBuffers(Texture *srcTexture, uint8_t *const *buffers, const BufferTextureCopy *regions, uint count) {
+    auto *queue = getMessageQueue();
     ENQUEUE_MESSAGE_5(
-        _mainMessageQueue,
+        queue,
         DeviceCopyTextureToBuffers,
         actor, getActor(),
         src, static_cast<TextureAgent *>(srcTexture)->getActor(),
@@ -330,13 +340,14 @@ void DeviceAgent::copyTextureToBuffers(Texture *srcTexture, uint8_t *const *buff
         {
             actor->copyTextureToBuffers(src, buffers, regions, count);
         });
-    _mainMessageQueue->kickAndWait();
+    queue->kickAndWait();
 }
 
 void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint count) {
     if (!_multithreaded) return; // all command buffers are immediately executed
 
-    auto **agentCmdBuffs = _mainMessageQueue->allocate<CommandBufferAgent *>(count);
+    auto * queue         = getMessageQueue();
+    auto **agentCmdBuffs = queue->allocate<CommandBufferAgent *>(count);
 
     for (uint i = 0; i < count; ++i) {
         agentCmdBuffs[i] = static_cast<CommandBufferAgent *const>(cmdBuffs[i]);
@@ -345,7 +356,7 @@ void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint count) {
     }
 
     ENQUEUE_MESSAGE_3(
-        _mainMessageQueue, DeviceFlushCommands,
+        queue, DeviceFlushCommands,
         count, count,
         cmdBuffs, agentCmdBuffs,
         multiThreaded, _actor->_multithreadedSubmission,
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <functional>
 #include "base/Agent.h"
 #include "base/threading/Semaphore.h"
 #include "gfx-base/GFXDevice.h"
@@ -40,6 +41,8 @@ class CommandBufferAgent;
 
 class CC_DLL DeviceAgent final : public Agent<Device> {
 public:
+    CC_SLAB_ALLOCATED(DeviceAgent)
+
     static DeviceAgent *  getInstance();
     static constexpr uint MAX_CPU_FRAME_AHEAD = 1;
     static constexpr uint MAX_FRAME_INDEX     = MAX_CPU_FRAME_AHEAD + 1;
@@ -89,14 +92,24 @@ public:
     uint             getWidth() const override { return _actor->getWidth(); }
     uint             getHeight() const override { return _actor->getHeight(); }
     MemoryStatus &   getMemoryStatus() override { return _actor->getMemoryStatus(); }
+    MemoryTracker &  getMemoryTracker() override { return _actor->getMemoryTracker(); }
     uint             getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint             getNumInstances() const override { return _actor->getNumInstances(); }
     uint             getNumTris() const override { return _actor->getNumTris(); }
 
     uint getCurrentIndex() const { return _currentIndex; }
     void setMultithreaded(bool multithreaded);
+    bool isMultithreaded() const { return _multithreaded; }
+
+    // Runs before every message enqueued on the main queue, lets a second producer thread take turns with the first one
+    inline void setProducerFence(std::function<void()> fence) { _producerFence = std::move(fence); }
 
-    inline MessageQueue *getMessageQueue() const { return _mainMessageQueue; }
+    inline MessageQueue *getMessageQueue() const {
+        if (_producerFence) {
+            _producerFence();
+        }
+        return _mainMessageQueue;
+    }
 
 protected:
     static DeviceAgent *instance;
@@ -112,8 +125,9 @@ protected:
     void releaseSurface(uintptr_t windowHandle) override;
     void acquireSurface(uintptr_t windowHandle) override;
 
-    bool          _multithreaded{false};
-    MessageQueue *_mainMessageQueue{nullptr};
+    bool                  _multithreaded{false};
+    MessageQueue *        _mainMessageQueue{nullptr};
+    std::function<void()> _producerFence;
 
     uint      _currentIndex = 0U;
     Semaphore _frameBoundarySemaphore{MAX_CPU_FRAME_AHEAD};
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL FramebufferAgent final : public Agent<Framebuffer> {
 public:
+    CC_SLAB_ALLOCATED(FramebufferAgent)
+
     explicit FramebufferAgent(Framebuffer *actor);
     ~FramebufferAgent() override;
 
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL InputAssemblerAgent final : public Agent<InputAssembler> {
 public:
+    CC_SLAB_ALLOCATED(InputAssemblerAgent)
+
     explicit InputAssemblerAgent(InputAssembler *actor);
     ~InputAssemblerAgent() override;
 
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL PipelineLayoutAgent final : public Agent<PipelineLayout> {
 public:
+    CC_SLAB_ALLOCATED(PipelineLayoutAgent)
+
     explicit PipelineLayoutAgent(PipelineLayout *actor);
     ~PipelineLayoutAgent() override;
 
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL PipelineStateAgent final : public Agent<PipelineState> {
 public:
+    CC_SLAB_ALLOCATED(PipelineStateAgent)
+
     explicit PipelineStateAgent(PipelineState *actor);
     ~PipelineStateAgent() override;
 
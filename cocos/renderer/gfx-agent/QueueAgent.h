@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL QueueAgent final : public Agent<Queue> {
 public:
+    CC_SLAB_ALLOCATED(QueueAgent)
+
     using Queue::submit;
 
     explicit QueueAgent(Queue *actor);
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL RenderPassAgent final : public Agent<RenderPass> {
 public:
+    CC_SLAB_ALLOCATED(RenderPassAgent)
+
     explicit RenderPassAgent(RenderPass *actor);
     ~RenderPassAgent() override;
 
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL SamplerAgent final : public Agent<Sampler> {
 public:
+    CC_SLAB_ALLOCATED(SamplerAgent)
+
     explicit SamplerAgent(Sampler *actor);
     ~SamplerAgent() override;
 
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL ShaderAgent final : public Agent<Shader> {
 public:
+    CC_SLAB_ALLOCATED(ShaderAgent)
+
     explicit ShaderAgent(Shader *actor);
     ~ShaderAgent() override;
 
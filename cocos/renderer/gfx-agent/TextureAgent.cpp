@@ -48,6 +48,8 @@ TextureAgent::~TextureAgent() {
 }
 
 void TextureAgent::doInit(const TextureInfo &info) {
+    _actor->setMemoryTag(_memoryTag); // the tag scope lives on this thread
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         TextureInit,
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL TextureAgent final : public Agent<Texture> {
 public:
+    CC_SLAB_ALLOCATED(TextureAgent)
+
     explicit TextureAgent(Texture *actor);
     ~TextureAgent() override;
 
@@ -27,6 +27,7 @@
 
 #include "GFXBuffer.h"
 #include "GFXDevice.h"
+#include "GFXMemoryTracker.h"
 #include "GFXObject.h"
 
 namespace cc {
@@ -55,6 +56,10 @@ void Buffer::initialize(const BufferInfo &info) {
     _stride   = std::max(info.stride, 1U);
     _count    = _size / _stride;
 
+    if (_memoryTag == MemoryTag::DEFAULT) {
+        _memoryTag = TaggedMemoryTracker::getCurrentTag();
+    }
+
     doInit(info);
 }
 
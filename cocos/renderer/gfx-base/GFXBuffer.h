@@ -26,6 +26,7 @@
 #pragma once
 
 #include "GFXObject.h"
+#include "base/memory/TaggedMemoryTracker.h"
 
 namespace cc {
 namespace gfx {
@@ -54,6 +55,10 @@ public:
     inline BufferFlags getFlags() const { return _flags; }
     inline bool        isBufferView() const { return _isBufferView; }
 
+    // Owner tag for memory accounting, defaults to the tag of the current MemoryTagScope if not set before initialization
+    inline MemoryTag getMemoryTag() const { return _memoryTag; }
+    inline void      setMemoryTag(MemoryTag tag) { _memoryTag = tag; }
+
 protected:
     virtual void doInit(const BufferInfo &info)     = 0;
     virtual void doInit(const BufferViewInfo &info) = 0;
@@ -68,6 +73,7 @@ protected:
     uint        _offset       = 0U;
     BufferFlags _flags        = BufferFlagBit::NONE;
     bool        _isBufferView = false;
+    MemoryTag   _memoryTag    = MemoryTag::DEFAULT;
 };
 
 } // namespace gfx
@@ -25,6 +25,8 @@
 
 #include "base/CoreStd.h"
 
+#include <cstring>
+
 #include "GFXContext.h"
 #include "GFXDevice.h"
 #include "GFXObject.h"
@@ -81,6 +83,16 @@ bool Device::initialize(const DeviceInfo &info) {
 }
 
 void Device::destroy() {
+    {
+        std::lock_guard<std::mutex> lock(_textureUploadMutex);
+        for (auto *uploads : {&_textureUploads, &_issuedTextureUploads}) {
+            for (TextureUpload *upload : *uploads) {
+                CC_DELETE(upload);
+            }
+            uploads->clear();
+        }
+    }
+
     doDestroy();
 
     _bindingMappingInfo.bufferOffsets.clear();
@@ -89,5 +101,123 @@ void Device::destroy() {
     _pixelRatio                      = 1.0F;
 }
 
+void Device::copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const TextureUploadCallback &callback) {
+    auto *upload     = CC_NEW(TextureUpload);
+    upload->texture  = dst;
+    upload->callback = callback;
+    upload->regions.assign(regions, regions + count);
+    upload->regionSizes.resize(count);
+
+    uint totalSize = 0U;
+    for (uint i = 0U; i < count; i++) {
+        const BufferTextureCopy &region = regions[i];
+
+        uint size = formatSize(dst->getFormat(), region.texExtent.width, region.texExtent.height, region.texExtent.depth);
+        upload->regionSizes[i] = size * region.texSubres.layerCount;
+        totalSize += upload->regionSizes[i];
+    }
+
+    // the staging copy happens on the calling thread, outside of the lock
+    upload->data.resize(totalSize);
+    uint8_t *staging = upload->data.data();
+    for (uint i = 0U, n = 0U; i < count; i++) {
+        const BufferTextureCopy &region = regions[i];
+
+        uint size = upload->regionSizes[i] / std::max(region.texSubres.layerCount, 1U);
+        for (uint l = 0U; l < region.texSubres.layerCount; l++) {
+            memcpy(staging, buffers[n++], size);
+            staging += size;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_textureUploadMutex);
+    _textureUploads.push_back(upload);
+}
+
+void Device::cancelTextureUploads(Texture *dst) {
+    std::lock_guard<std::mutex> lock(_textureUploadMutex);
+    for (auto *uploads : {&_textureUploads, &_issuedTextureUploads}) {
+        for (auto iter = uploads->begin(); iter != uploads->end();) {
+            if ((*iter)->texture == dst) {
+                CC_DELETE(*iter);
+                iter = uploads->erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+}
+
+void Device::flushTextureUploads() {
+    deque<TextureUpload *> pending;
+    {
+        std::lock_guard<std::mutex> lock(_textureUploadMutex);
+        pending.swap(_textureUploads);
+    }
+    ++_textureUploadFrame;
+
+    // the copies are issued without the lock, producers are never blocked behind a transfer
+    vector<TextureUpload *> issued;
+    // whole mip levels are the unit of transfer, and at least one is issued per frame to guarantee progress
+    uint budget   = _textureUploadBudget ? _textureUploadBudget : std::numeric_limits<uint>::max();
+    uint consumed = 0U;
+    while (!pending.empty() && consumed < budget) {
+        TextureUpload *upload = pending.front();
+
+        uint first = upload->nextRegion;
+        uint last  = first;
+        uint bytes = 0U;
+        _textureUploadBuffers.clear();
+        while (last < upload->regions.size()) {
+            uint size = upload->regionSizes[last];
+            if (consumed + bytes > 0U && consumed + bytes + size > budget) break;
+
+            const BufferTextureCopy &region = upload->regions[last];
+            const uint8_t *          src    = upload->data.data() + upload->nextOffset + bytes;
+            uint                     stride = size / std::max(region.texSubres.layerCount, 1U);
+            for (uint l = 0U; l < region.texSubres.layerCount; l++) {
+                _textureUploadBuffers.push_back(src + stride * l);
+            }
+            bytes += size;
+            ++last;
+        }
+        if (last > first) {
+            copyBuffersToTexture(_textureUploadBuffers.data(), upload->texture, &upload->regions[first], last - first);
+            upload->nextRegion = last;
+            upload->nextOffset += bytes;
+            consumed += bytes;
+        }
+
+        if (last < upload->regions.size()) break;
+
+        // the backends copy the source data when the copy is recorded
+        vector<uint8_t>().swap(upload->data);
+        upload->retireFrame = _textureUploadFrame + _maxFramesInFlight;
+        issued.push_back(upload);
+        pending.pop_front();
+    }
+
+    vector<TextureUploadCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(_textureUploadMutex);
+        // unfinished uploads stay ahead of the ones queued in the meantime
+        _textureUploads.insert(_textureUploads.begin(), pending.begin(), pending.end());
+        _issuedTextureUploads.insert(_issuedTextureUploads.end(), issued.begin(), issued.end());
+
+        // acquire() has waited for the frame which issued these, so the GPU is done with them
+        while (!_issuedTextureUploads.empty() && _issuedTextureUploads.front()->retireFrame <= _textureUploadFrame) {
+            TextureUpload *upload = _issuedTextureUploads.front();
+            if (upload->callback) callbacks.push_back(std::move(upload->callback));
+            CC_DELETE(upload);
+            _issuedTextureUploads.pop_front();
+        }
+    }
+
+    // callbacks may queue further uploads
+    for (auto &callback : callbacks) {
+        callback();
+    }
+}
+
 } // namespace gfx
 } // namespace cc
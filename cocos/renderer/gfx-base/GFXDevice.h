@@ -26,6 +26,8 @@
 #pragma once
 
 #include <array>
+#include <functional>
+#include <mutex>
 #include "GFXBuffer.h"
 #include "GFXCommandBuffer.h"
 #include "GFXDescriptorSet.h"
@@ -33,6 +35,7 @@
 #include "GFXFramebuffer.h"
 #include "GFXGlobalBarrier.h"
 #include "GFXInputAssembler.h"
+#include "GFXMemoryTracker.h"
 #include "GFXObject.h"
 #include "GFXPipelineLayout.h"
 #include "GFXPipelineState.h"
@@ -46,10 +49,15 @@
 namespace cc {
 namespace gfx {
 
+using TextureUploadCallback = std::function<void()>;
+
 class CC_DLL Device : public Object {
 public:
     static Device *getInstance();
 
+    static constexpr uint DEFAULT_TEXTURE_UPLOAD_BUDGET = 4 * 1024 * 1024;
+    static constexpr uint DEFAULT_MAX_FRAMES_IN_FLIGHT  = 3;
+
     ~Device() override;
 
     bool initialize(const DeviceInfo &info);
@@ -66,6 +74,7 @@ public:
     virtual uint             getHeight() const { return _height; }
     virtual float            devicePixelRatio() const { return _pixelRatio; }
     virtual MemoryStatus &   getMemoryStatus() { return _memoryStatus; }
+    virtual MemoryTracker &  getMemoryTracker() { return _memoryTracker; }
     virtual uint             getNumDrawCalls() const { return _numDrawCalls; }
     virtual uint             getNumInstances() const { return _numInstances; }
     virtual uint             getNumTris() const { return _numTriangles; }
@@ -92,6 +101,20 @@ public:
     virtual void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint count) = 0;
 
     inline void copyBuffersToTexture(const BufferDataList &buffers, Texture *dst, const BufferTextureCopyList &regions);
+
+    // Asynchronous texture uploads: the data is staged on the calling thread (which can be any thread),
+    // and the transfer is spread over the following frames within the per-frame byte budget.
+    // flushTextureUploads is called once a frame after acquire, on the thread which also destroys textures.
+    // Callbacks are invoked on that thread once the GPU has finished the copy, i.e. getMaxFramesInFlight()
+    // frames after the last region was issued. Cancelling drops the callbacks as well.
+    void copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const TextureUploadCallback &callback = nullptr);
+    void cancelTextureUploads(Texture *dst);
+    void flushTextureUploads();
+
+    inline void setTextureUploadBudget(uint bytesPerFrame) { _textureUploadBudget = bytesPerFrame; }
+    inline uint getTextureUploadBudget() const { return _textureUploadBudget; }
+    // frames the GPU may lag behind the frame being recorded
+    inline uint getMaxFramesInFlight() const { return _maxFramesInFlight; }
     inline void flushCommands(const vector<CommandBuffer *> &cmdBuffs);
     inline void flushCommandsForJS(const vector<CommandBuffer *> &cmdBuffs);
 
@@ -147,6 +170,17 @@ protected:
 
     inline Context *getContext() const { return _context; }
 
+    struct TextureUpload {
+        Texture *                 texture{nullptr};
+        vector<BufferTextureCopy> regions;
+        vector<uint>              regionSizes; // staged bytes of each region, all layers included
+        vector<uint8_t>           data;
+        uint                      nextRegion{0U};
+        uint                      nextOffset{0U};
+        uint64_t                  retireFrame{0U}; // when the GPU is done with every region
+        TextureUploadCallback     callback;
+    };
+
     API                _api       = API::UNKNOWN;
     SurfaceTransform   _transform = SurfaceTransform::IDENTITY;
     String             _deviceName;
@@ -158,6 +192,7 @@ protected:
     uint               _height{0};
     float              _pixelRatio{1.0F};
     MemoryStatus       _memoryStatus;
+    MemoryTracker      _memoryTracker{&_memoryStatus};
     uintptr_t          _windowHandle{0};
     Context *          _context{nullptr};
     Queue *            _queue{nullptr};
@@ -168,6 +203,14 @@ protected:
     BindingMappingInfo _bindingMappingInfo;
     DeviceCaps         _caps;
 
+    std::mutex              _textureUploadMutex;
+    deque<TextureUpload *>  _textureUploads;
+    deque<TextureUpload *>  _issuedTextureUploads; // waiting for the GPU, to invoke the callbacks
+    vector<const uint8_t *> _textureUploadBuffers; // flushing thread only
+    uint64_t                _textureUploadFrame{0U};
+    uint                    _textureUploadBudget{DEFAULT_TEXTURE_UPLOAD_BUDGET};
+    uint                    _maxFramesInFlight{DEFAULT_MAX_FRAMES_IN_FLIGHT};
+
     std::array<bool, static_cast<size_t>(Feature::COUNT)> _features;
 };
 
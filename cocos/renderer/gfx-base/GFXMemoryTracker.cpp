@@ -0,0 +1,203 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CoreStd.h"
+
+#include "GFXBuffer.h"
+#include "GFXMemoryTracker.h"
+#include "GFXTexture.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+const char *categoryNames[] = {
+    "vertex buffer",
+    "index buffer",
+    "uniform buffer",
+    "storage buffer",
+    "indirect buffer",
+    "transfer buffer",
+    "sampled texture",
+    "color attachment",
+    "depth stencil attachment",
+};
+
+void add(MemoryCounter *counter, int64_t delta) {
+    counter->current += delta;
+    if (delta > 0) {
+        ++counter->count;
+    } else {
+        --counter->count;
+    }
+    counter->frameHighWater = std::max(counter->frameHighWater, counter->current);
+    counter->peak           = std::max(counter->peak, counter->current);
+}
+
+void finishFrame(MemoryCounter *counter) {
+    counter->lastFrameHighWater = counter->frameHighWater;
+    counter->frameHighWater     = counter->current;
+}
+} // namespace
+
+MemoryCategory MemoryTracker::getCategory(const Buffer *buffer) {
+    BufferUsage usage = buffer->getUsage();
+    if (hasFlag(usage, BufferUsageBit::INDIRECT)) return MemoryCategory::INDIRECT_BUFFER;
+    if (hasFlag(usage, BufferUsageBit::VERTEX)) return MemoryCategory::VERTEX_BUFFER;
+    if (hasFlag(usage, BufferUsageBit::INDEX)) return MemoryCategory::INDEX_BUFFER;
+    if (hasFlag(usage, BufferUsageBit::UNIFORM)) return MemoryCategory::UNIFORM_BUFFER;
+    if (hasFlag(usage, BufferUsageBit::STORAGE)) return MemoryCategory::STORAGE_BUFFER;
+    return MemoryCategory::TRANSFER_BUFFER;
+}
+
+MemoryCategory MemoryTracker::getCategory(const Texture *texture) {
+    TextureUsage usage = texture->getUsage();
+    if (hasFlag(usage, TextureUsageBit::DEPTH_STENCIL_ATTACHMENT)) return MemoryCategory::DEPTH_STENCIL_ATTACHMENT;
+    if (hasFlag(usage, TextureUsageBit::COLOR_ATTACHMENT)) return MemoryCategory::COLOR_ATTACHMENT;
+    return MemoryCategory::SAMPLED_TEXTURE;
+}
+
+void MemoryTracker::allocate(const Buffer *buffer, uint size) {
+    _status->bufferSize += size;
+    record(getCategory(buffer), buffer->getMemoryTag(), size);
+}
+
+void MemoryTracker::release(const Buffer *buffer, uint size) {
+    _status->bufferSize -= size;
+    record(getCategory(buffer), buffer->getMemoryTag(), -static_cast<int64_t>(size));
+}
+
+void MemoryTracker::allocate(const Texture *texture, uint size) {
+    _status->textureSize += size;
+    record(getCategory(texture), texture->getMemoryTag(), size);
+}
+
+void MemoryTracker::release(const Texture *texture, uint size) {
+    _status->textureSize -= size;
+    record(getCategory(texture), texture->getMemoryTag(), -static_cast<int64_t>(size));
+}
+
+void MemoryTracker::record(MemoryCategory category, MemoryTag tag, int64_t delta) {
+    if (!delta) return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    add(&_total, delta);
+    add(&_categories[static_cast<uint>(category)], delta);
+    add(&_tags[static_cast<uint>(tag)].counter, delta);
+}
+
+void MemoryTracker::nextFrame() {
+    struct Exceeded {
+        MemoryTag tag;
+        uint64_t  usage;
+        uint64_t  budget;
+    };
+    vector<Exceeded>     exceeded;
+    MemoryBudgetCallback callback;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // budgets are checked against the high-water marks so short-lived spikes are reported too
+        bool overBudget = _budget && _total.frameHighWater > _budget;
+        if (overBudget && !_overBudget) exceeded.push_back({ALL_MEMORY_TAGS, _total.frameHighWater, _budget});
+        _overBudget = overBudget;
+
+        for (uint i = 0U; i < _tags.size(); ++i) {
+            TagState &state = _tags[i];
+            overBudget      = state.budget && state.counter.frameHighWater > state.budget;
+            if (overBudget && !state.overBudget) exceeded.push_back({static_cast<MemoryTag>(i), state.counter.frameHighWater, state.budget});
+            state.overBudget = overBudget;
+
+            finishFrame(&state.counter);
+        }
+        finishFrame(&_total);
+        for (auto &counter : _categories) {
+            finishFrame(&counter);
+        }
+        if (!exceeded.empty()) callback = _budgetCallback;
+    }
+
+    // invoked outside the lock so the callback may query the tracker or release resources
+    if (callback) {
+        for (const auto &info : exceeded) {
+            callback(info.tag, info.usage, info.budget);
+        }
+    }
+}
+
+MemoryCounter MemoryTracker::getTotalUsage() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _total;
+}
+
+MemoryCounter MemoryTracker::getCategoryUsage(MemoryCategory category) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _categories[static_cast<uint>(category)];
+}
+
+MemoryCounter MemoryTracker::getTagUsage(MemoryTag tag) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return tag < MemoryTag::COUNT ? _tags[static_cast<uint>(tag)].counter : MemoryCounter();
+}
+
+void MemoryTracker::setBudget(MemoryTag tag, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (tag == ALL_MEMORY_TAGS) {
+        _budget     = bytes;
+        _overBudget = false;
+        return;
+    }
+    TagState &state  = _tags[static_cast<uint>(tag)];
+    state.budget     = bytes;
+    state.overBudget = false;
+}
+
+void MemoryTracker::setBudgetCallback(const MemoryBudgetCallback &callback) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _budgetCallback = callback;
+}
+
+void MemoryTracker::printStatistics() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    CC_LOG_INFO("GPU memory: %llu bytes in %u allocations, peak %llu bytes",
+                static_cast<unsigned long long>(_total.current), _total.count, static_cast<unsigned long long>(_total.peak));
+    for (uint i = 0U; i < _categories.size(); ++i) {
+        const MemoryCounter &counter = _categories[i];
+        if (!counter.peak) continue;
+        CC_LOG_INFO("    [%s] %llu bytes in %u allocations, peak %llu bytes", categoryNames[i],
+                    static_cast<unsigned long long>(counter.current), counter.count, static_cast<unsigned long long>(counter.peak));
+    }
+    for (uint i = 0U; i < _tags.size(); ++i) {
+        const MemoryCounter &counter = _tags[i].counter;
+        if (!counter.peak) continue;
+        CC_LOG_INFO("    <%s> %llu bytes in %u allocations, peak %llu bytes", TaggedMemoryTracker::getTagName(static_cast<MemoryTag>(i)),
+                    static_cast<unsigned long long>(counter.current), counter.count, static_cast<unsigned long long>(counter.peak));
+    }
+}
+
+} // namespace gfx
+} // namespace cc
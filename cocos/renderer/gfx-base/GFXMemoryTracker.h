@@ -0,0 +1,118 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include "GFXDef.h"
+#include "base/memory/TaggedMemoryTracker.h"
+
+namespace cc {
+namespace gfx {
+
+class Buffer;
+class Texture;
+
+enum class MemoryCategory : uint {
+    VERTEX_BUFFER,
+    INDEX_BUFFER,
+    UNIFORM_BUFFER,
+    STORAGE_BUFFER,
+    INDIRECT_BUFFER,
+    TRANSFER_BUFFER,
+    SAMPLED_TEXTURE,
+    COLOR_ATTACHMENT,
+    DEPTH_STENCIL_ATTACHMENT,
+    COUNT,
+};
+
+struct MemoryCounter {
+    uint64_t current            = 0U;
+    uint64_t frameHighWater     = 0U; // highest usage reached so far in the current frame
+    uint64_t lastFrameHighWater = 0U; // highest usage reached during the last finished frame
+    uint64_t peak               = 0U;
+    uint     count              = 0U; // live allocations
+};
+
+// tag is ALL_MEMORY_TAGS when the device-wide budget is exceeded
+using MemoryBudgetCallback = std::function<void(MemoryTag tag, uint64_t usage, uint64_t budget)>;
+
+/**
+ * Accounts the buffer and texture memory of a device by usage category and by owner tag.
+ * Resources are tagged with the cc::MemoryTag of the MemoryTagScope they are created in.
+ * Backends report allocations here, the frame boundary is marked from Device::present,
+ * which is also where budget callbacks are invoked, on the device thread.
+ */
+class CC_DLL MemoryTracker {
+public:
+    static constexpr MemoryTag ALL_MEMORY_TAGS = MemoryTag::COUNT;
+
+    explicit MemoryTracker(MemoryStatus *status) : _status(status) {}
+
+    void allocate(const Buffer *buffer, uint size);
+    void release(const Buffer *buffer, uint size);
+    void allocate(const Texture *texture, uint size);
+    void release(const Texture *texture, uint size);
+
+    void nextFrame();
+
+    MemoryCounter getTotalUsage();
+    MemoryCounter getCategoryUsage(MemoryCategory category);
+    MemoryCounter getTagUsage(MemoryTag tag);
+
+    // the budget of a tag covers its own allocations, ALL_MEMORY_TAGS sets the device-wide one, 0 disables
+    void setBudget(MemoryTag tag, uint64_t bytes);
+    void setBudgetCallback(const MemoryBudgetCallback &callback);
+
+    void printStatistics();
+
+protected:
+    static MemoryCategory getCategory(const Buffer *buffer);
+    static MemoryCategory getCategory(const Texture *texture);
+
+    void record(MemoryCategory category, MemoryTag tag, int64_t delta);
+
+    struct TagState {
+        MemoryCounter counter;
+        uint64_t      budget{0U};
+        bool          overBudget{false};
+    };
+
+    std::mutex    _mutex;
+    MemoryStatus *_status{nullptr};
+
+    MemoryCounter                                                         _total;
+    std::array<MemoryCounter, static_cast<size_t>(MemoryCategory::COUNT)> _categories;
+    std::array<TagState, static_cast<size_t>(MemoryTag::COUNT)>           _tags;
+
+    uint64_t             _budget{0U};
+    bool                 _overBudget{false};
+    MemoryBudgetCallback _budgetCallback;
+};
+
+} // namespace gfx
+} // namespace cc
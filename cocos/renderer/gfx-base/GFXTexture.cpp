@@ -26,6 +26,7 @@
 #include "base/CoreStd.h"
 
 #include "GFXDevice.h"
+#include "GFXMemoryTracker.h"
 #include "GFXObject.h"
 #include "GFXTexture.h"
 
@@ -66,6 +67,10 @@ void Texture::initialize(const TextureInfo &info) {
     _flags      = info.flags;
     _size       = formatSize(_format, _width, _height, _depth);
 
+    if (_memoryTag == MemoryTag::DEFAULT) {
+        _memoryTag = TaggedMemoryTracker::getCurrentTag();
+    }
+
     doInit(info);
 }
 
@@ -91,6 +96,10 @@ void Texture::initialize(const TextureViewInfo &info) {
 }
 
 void Texture::destroy() {
+    if (Device::getInstance()) {
+        Device::getInstance()->cancelTextureUploads(this);
+    }
+
     doDestroy();
 
     _format = Format::UNKNOWN;
@@ -99,6 +108,10 @@ void Texture::destroy() {
 
 void Texture::resize(uint width, uint height) {
     if (_width != width || _height != height) {
+        if (Device::getInstance()) {
+            Device::getInstance()->cancelTextureUploads(this);
+        }
+
         uint size = formatSize(_format, width, height, _depth);
         doResize(width, height, size);
 
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "GFXObject.h"
+#include "base/memory/TaggedMemoryTracker.h"
 
 namespace cc {
 namespace gfx {
@@ -55,6 +56,10 @@ public:
     inline TextureFlags getFlags() const { return _flags; }
     inline bool         isTextureView() const { return _isTextureView; }
 
+    // Owner tag for memory accounting, defaults to the tag of the current MemoryTagScope if not set before initialization
+    inline MemoryTag getMemoryTag() const { return _memoryTag; }
+    inline void      setMemoryTag(MemoryTag tag) { _memoryTag = tag; }
+
 protected:
     virtual void doInit(const TextureInfo &info)              = 0;
     virtual void doInit(const TextureViewInfo &info)          = 0;
@@ -75,6 +80,7 @@ protected:
     SampleCount  _samples       = SampleCount::X1;
     TextureFlags _flags         = TextureFlagBit::NONE;
     bool         _isTextureView = false;
+    MemoryTag    _memoryTag     = MemoryTag::DEFAULT;
 };
 
 } // namespace gfx
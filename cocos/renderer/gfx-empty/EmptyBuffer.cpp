@@ -24,20 +24,27 @@
 ****************************************************************************/
 
 #include "EmptyBuffer.h"
+#include "EmptyDevice.h"
 
 namespace cc {
 namespace gfx {
 
 void EmptyBuffer::doInit(const BufferInfo &info) {
+    EmptyDevice::getInstance()->getMemoryTracker().allocate(this, _size);
 }
 
 void EmptyBuffer::doInit(const BufferViewInfo &info) {
 }
 
 void EmptyBuffer::doResize(uint size, uint count) {
+    EmptyDevice::getInstance()->getMemoryTracker().release(this, _size);
+    EmptyDevice::getInstance()->getMemoryTracker().allocate(this, size);
 }
 
 void EmptyBuffer::doDestroy() {
+    if (!_isBufferView) {
+        EmptyDevice::getInstance()->getMemoryTracker().release(this, _size);
+    }
 }
 
 void EmptyBuffer::update(const void *buffer, uint size) {
@@ -98,6 +98,7 @@ void EmptyDevice::acquire() {
 }
 
 void EmptyDevice::present() {
+    _memoryTracker.nextFrame();
     std::this_thread::sleep_for(std::chrono::milliseconds(16));
 }
 
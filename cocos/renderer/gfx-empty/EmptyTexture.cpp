@@ -23,21 +23,28 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include "EmptyDevice.h"
 #include "EmptyTexture.h"
 
 namespace cc {
 namespace gfx {
 
 void EmptyTexture::doInit(const TextureInfo &info) {
+    EmptyDevice::getInstance()->getMemoryTracker().allocate(this, _size);
 }
 
 void EmptyTexture::doInit(const TextureViewInfo &info) {
 }
 
 void EmptyTexture::doDestroy() {
+    if (!_isTextureView) {
+        EmptyDevice::getInstance()->getMemoryTracker().release(this, _size);
+    }
 }
 
 void EmptyTexture::doResize(uint width, uint height, uint size) {
+    EmptyDevice::getInstance()->getMemoryTracker().release(this, _size);
+    EmptyDevice::getInstance()->getMemoryTracker().allocate(this, size);
 }
 
 } // namespace gfx
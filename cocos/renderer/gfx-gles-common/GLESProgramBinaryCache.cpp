@@ -0,0 +1,154 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "GLESProgramBinaryCache.h"
+#include <cstring>
+#include "base/Data.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+constexpr uint32_t PROGRAM_BINARY_MAGIC   = 0x50424343; // 'CCBP'
+constexpr uint32_t PROGRAM_BINARY_VERSION = 2U;
+constexpr char     DRIVER_ID_FILE[]       = "driver.id";
+
+struct ProgramBinaryHeader {
+    uint32_t magic      = PROGRAM_BINARY_MAGIC;
+    uint32_t version    = PROGRAM_BINARY_VERSION;
+    uint64_t driverHash = 0U;
+    uint64_t keyHash    = 0U;
+    uint64_t checksum   = 0U;
+    uint32_t format     = 0U;
+    uint32_t keySize    = 0U; // the full key follows the header, hashes alone may collide
+    uint32_t size       = 0U;
+};
+
+// FNV-1a, needs to be stable across runs and platforms, unlike std::hash
+uint64_t hashBytes(const void *data, size_t size) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    uint64_t    hash  = 0xcbf29ce484222325ULL;
+    for (size_t i = 0U; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+} // namespace
+
+void GLESProgramBinaryCache::initialize(const String &backend, const String &driverID) {
+    FileUtils *fileUtils = FileUtils::getInstance();
+
+    _cacheDir   = fileUtils->getWritablePath() + "program-cache/" + backend + "/";
+    _driverHash = hashBytes(driverID.data(), driverID.size());
+
+    // invalidate everything on driver change, stale binaries would be rejected anyway
+    const String driverIDPath = _cacheDir + DRIVER_ID_FILE;
+    if (!fileUtils->isFileExist(driverIDPath) || fileUtils->getStringFromFile(driverIDPath) != driverID) {
+        if (fileUtils->isDirectoryExist(_cacheDir)) {
+            fileUtils->removeDirectory(_cacheDir);
+            CC_LOG_INFO("Program binary cache invalidated: driver changed.");
+        }
+        _enabled = fileUtils->createDirectory(_cacheDir) && fileUtils->writeStringToFile(driverID, driverIDPath);
+    } else {
+        _enabled = true;
+    }
+
+    if (!_enabled) {
+        CC_LOG_WARNING("Program binary cache disabled: %s is not writable.", _cacheDir.c_str());
+    }
+}
+
+bool GLESProgramBinaryCache::load(const String &key, uint32_t *format, vector<uint8_t> *binary) const {
+    if (!_enabled) return false;
+
+    const uint64_t keyHash = hashBytes(key.data(), key.size());
+    const String   path    = getEntryPath(keyHash);
+
+    FileUtils *fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(path)) return false;
+
+    Data data = fileUtils->getDataFromFile(path);
+    if (static_cast<size_t>(data.getSize()) < sizeof(ProgramBinaryHeader)) return false;
+
+    ProgramBinaryHeader header;
+    memcpy(&header, data.getBytes(), sizeof(header));
+    const uint8_t *storedKey = data.getBytes() + sizeof(header);
+    const uint8_t *payload   = storedKey + header.keySize;
+
+    if (header.magic != PROGRAM_BINARY_MAGIC || header.version != PROGRAM_BINARY_VERSION ||
+        header.driverHash != _driverHash || header.keyHash != keyHash ||
+        static_cast<size_t>(header.keySize) + header.size != static_cast<size_t>(data.getSize()) - sizeof(header) ||
+        header.checksum != hashBytes(payload, header.size)) {
+        CC_LOG_WARNING("Corrupted or outdated program binary %s discarded.", path.c_str());
+        fileUtils->removeFile(path);
+        return false;
+    }
+
+    // a different program whose key hashes to the same entry, leave it to be overwritten
+    if (header.keySize != key.size() || memcmp(storedKey, key.data(), key.size()) != 0) {
+        return false;
+    }
+
+    *format = header.format;
+    binary->assign(payload, payload + header.size);
+    return true;
+}
+
+void GLESProgramBinaryCache::store(const String &key, uint32_t format, const uint8_t *binary, uint32_t size) const {
+    if (!_enabled || !size) return;
+
+    ProgramBinaryHeader header;
+    header.driverHash = _driverHash;
+    header.keyHash    = hashBytes(key.data(), key.size());
+    header.checksum   = hashBytes(binary, size);
+    header.format     = format;
+    header.keySize    = static_cast<uint32_t>(key.size());
+    header.size       = size;
+
+    const size_t totalSize = sizeof(header) + key.size() + size;
+    auto *       bytes     = static_cast<unsigned char *>(malloc(totalSize));
+    memcpy(bytes, &header, sizeof(header));
+    memcpy(bytes + sizeof(header), key.data(), key.size());
+    memcpy(bytes + sizeof(header) + key.size(), binary, size);
+
+    Data data;
+    data.fastSet(bytes, static_cast<ssize_t>(totalSize));
+    FileUtils::getInstance()->writeDataToFile(data, getEntryPath(header.keyHash));
+}
+
+void GLESProgramBinaryCache::remove(const String &key) const {
+    if (!_enabled) return;
+
+    FileUtils::getInstance()->removeFile(getEntryPath(hashBytes(key.data(), key.size())));
+}
+
+String GLESProgramBinaryCache::getEntryPath(uint64_t keyHash) const {
+    return _cacheDir + StringUtil::format("%016llx.bin", static_cast<unsigned long long>(keyHash));
+}
+
+} // namespace gfx
+} // namespace cc
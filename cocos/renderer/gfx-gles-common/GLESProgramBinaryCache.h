@@ -0,0 +1,60 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/CoreStd.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * On-disk cache of linked program binaries, shared by the GLES backends.
+ * Entries are stored under a hash of the shader sources together with the full sources, which are
+ * compared on load. They are tagged with the driver identity, the whole cache is discarded as soon
+ * as the driver identity changes.
+ */
+class GLESProgramBinaryCache final {
+public:
+    // driverID should uniquely identify the driver build, e.g. vendor, renderer and GL version strings
+    void initialize(const String &backend, const String &driverID);
+
+    bool load(const String &key, uint32_t *format, vector<uint8_t> *binary) const;
+    void store(const String &key, uint32_t format, const uint8_t *binary, uint32_t size) const;
+    void remove(const String &key) const;
+
+    inline bool isEnabled() const { return _enabled; }
+
+private:
+    String getEntryPath(uint64_t keyHash) const;
+
+    String   _cacheDir;
+    uint64_t _driverHash = 0U;
+    bool     _enabled    = false;
+};
+
+} // namespace gfx
+} // namespace cc
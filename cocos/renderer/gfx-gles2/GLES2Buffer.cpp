@@ -53,7 +53,7 @@ void GLES2Buffer::doInit(const BufferInfo & /*info*/) {
     }
 
     cmdFuncGLES2CreateBuffer(GLES2Device::getInstance(), _gpuBuffer);
-    GLES2Device::getInstance()->getMemoryStatus().bufferSize += _size;
+    GLES2Device::getInstance()->getMemoryTracker().allocate(this, _size);
 }
 
 void GLES2Buffer::doInit(const BufferViewInfo &info) {
@@ -66,7 +66,7 @@ void GLES2Buffer::doInit(const BufferViewInfo &info) {
 
 void GLES2Buffer::doDestroy() {
     if (_gpuBuffer) {
-        GLES2Device::getInstance()->getMemoryStatus().bufferSize -= _size;
+        GLES2Device::getInstance()->getMemoryTracker().release(this, _size);
         cmdFuncGLES2DestroyBuffer(GLES2Device::getInstance(), _gpuBuffer);
         CC_DELETE(_gpuBuffer);
         _gpuBuffer = nullptr;
@@ -76,11 +76,11 @@ void GLES2Buffer::doDestroy() {
 }
 
 void GLES2Buffer::doResize(uint size, uint count) {
-    GLES2Device::getInstance()->getMemoryStatus().bufferSize -= _size;
+    GLES2Device::getInstance()->getMemoryTracker().release(this, _size);
     _gpuBuffer->size  = size;
     _gpuBuffer->count = count;
     cmdFuncGLES2ResizeBuffer(GLES2Device::getInstance(), _gpuBuffer);
-    GLES2Device::getInstance()->getMemoryStatus().bufferSize += size;
+    GLES2Device::getInstance()->getMemoryTracker().allocate(this, size);
 }
 
 void GLES2Buffer::update(const void *buffer, uint size) {
@@ -29,6 +29,7 @@
 #include "GLES2Device.h"
 #include "cocos/renderer/gfx-base/GFXDef.h"
 #include "gfx-gles-common/GLESCommandPool.h"
+#include "gfx-gles-common/GLESProgramBinaryCache.h"
 
 #define BUFFER_OFFSET(idx) (static_cast<char *>(0) + (idx))
 
@@ -854,91 +855,140 @@ void cmdFuncGLES2CreateSampler(GLES2Device * /*device*/, GLES2GPUSampler *gpuSam
 void cmdFuncGLES2DestroySampler(GLES2Device *device, GLES2GPUSampler *gpuSampler) {
 }
 
+namespace {
+bool loadProgramBinary(GLESProgramBinaryCache *binaryCache, const String &binaryKey, GLES2GPUShader *gpuShader) {
+    uint32_t        format = 0U;
+    vector<uint8_t> binary;
+    if (!binaryCache->load(binaryKey, &format, &binary)) return false;
+
+    GL_CHECK(gpuShader->glProgram = glCreateProgram());
+    // not wrapped in GL_CHECK: a rejected binary is an expected outcome, handled through the link status
+    glProgramBinaryOES(gpuShader->glProgram, format, binary.data(), static_cast<GLsizei>(binary.size()));
+    glGetError();
+
+    GLint status = GL_FALSE;
+    GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        CC_LOG_WARNING("Program binary of shader '%s' rejected by driver, recompiling.", gpuShader->name.c_str());
+        GL_CHECK(glDeleteProgram(gpuShader->glProgram));
+        gpuShader->glProgram = 0;
+        binaryCache->remove(binaryKey);
+        return false;
+    }
+    return true;
+}
+
+void storeProgramBinary(GLESProgramBinaryCache *binaryCache, const String &binaryKey, GLES2GPUShader *gpuShader) {
+    GLint length = 0;
+    GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_PROGRAM_BINARY_LENGTH_OES, &length));
+    if (length <= 0) return;
+
+    GLenum          format = GL_NONE;
+    vector<uint8_t> binary(length);
+    GL_CHECK(glGetProgramBinaryOES(gpuShader->glProgram, length, nullptr, &format, binary.data()));
+    binaryCache->store(binaryKey, format, binary.data(), static_cast<uint32_t>(length));
+}
+} // namespace
+
 void cmdFuncGLES2CreateShader(GLES2Device *device, GLES2GPUShader *gpuShader) {
     GLenum glShaderType = 0;
     String shaderTypeStr;
     GLint  status;
 
-    for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
-        GLES2GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
+    GLESProgramBinaryCache *binaryCache = device->programBinaryCache();
+    String                  binaryKey;
+    if (binaryCache) {
+        for (const auto &gpuStage : gpuShader->gpuStages) {
+            binaryKey += StringUtil::format("#stage %u\n", static_cast<uint>(gpuStage.type)) + gpuStage.source;
+        }
+    }
 
-        switch (gpuStage.type) {
-            case ShaderStageFlagBit::VERTEX: {
-                glShaderType  = GL_VERTEX_SHADER;
-                shaderTypeStr = "Vertex Shader";
-                break;
-            }
-            case ShaderStageFlagBit::FRAGMENT: {
-                glShaderType  = GL_FRAGMENT_SHADER;
-                shaderTypeStr = "Fragment Shader";
-                break;
-            }
-            default: {
-                CCASSERT(false, "Unsupported ShaderStageFlagBit");
-                return;
+    if (binaryCache && loadProgramBinary(binaryCache, binaryKey, gpuShader)) {
+        CC_LOG_DEBUG("Shader '%s' loaded from program binary cache.", gpuShader->name.c_str());
+    } else {
+        for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
+            GLES2GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
+
+            switch (gpuStage.type) {
+                case ShaderStageFlagBit::VERTEX: {
+                    glShaderType  = GL_VERTEX_SHADER;
+                    shaderTypeStr = "Vertex Shader";
+                    break;
+                }
+                case ShaderStageFlagBit::FRAGMENT: {
+                    glShaderType  = GL_FRAGMENT_SHADER;
+                    shaderTypeStr = "Fragment Shader";
+                    break;
+                }
+                default: {
+                    CCASSERT(false, "Unsupported ShaderStageFlagBit");
+                    return;
+                }
             }
-        }
 
-        GL_CHECK(gpuStage.glShader = glCreateShader(glShaderType));
-        const char *shaderSrc = gpuStage.source.c_str();
-        GL_CHECK(glShaderSource(gpuStage.glShader, 1, (const GLchar **)&shaderSrc, nullptr));
-        GL_CHECK(glCompileShader(gpuStage.glShader));
+            GL_CHECK(gpuStage.glShader = glCreateShader(glShaderType));
+            const char *shaderSrc = gpuStage.source.c_str();
+            GL_CHECK(glShaderSource(gpuStage.glShader, 1, (const GLchar **)&shaderSrc, nullptr));
+            GL_CHECK(glCompileShader(gpuStage.glShader));
 
-        GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_COMPILE_STATUS, &status));
-        if (status != 1) {
-            GLint logSize = 0;
-            GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_INFO_LOG_LENGTH, &logSize));
+            GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_COMPILE_STATUS, &status));
+            if (status != 1) {
+                GLint logSize = 0;
+                GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_INFO_LOG_LENGTH, &logSize));
 
-            ++logSize;
-            auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
-            GL_CHECK(glGetShaderInfoLog(gpuStage.glShader, logSize, nullptr, logs));
+                ++logSize;
+                auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
+                GL_CHECK(glGetShaderInfoLog(gpuStage.glShader, logSize, nullptr, logs));
 
-            CC_LOG_ERROR("%s in %s compilation failed.", shaderTypeStr.c_str(), gpuShader->name.c_str());
-            CC_LOG_ERROR(logs);
-            CC_FREE(logs);
-            GL_CHECK(glDeleteShader(gpuStage.glShader));
-            gpuStage.glShader = 0;
-            return;
+                CC_LOG_ERROR("%s in %s compilation failed.", shaderTypeStr.c_str(), gpuShader->name.c_str());
+                CC_LOG_ERROR(logs);
+                CC_FREE(logs);
+                GL_CHECK(glDeleteShader(gpuStage.glShader));
+                gpuStage.glShader = 0;
+                return;
+            }
         }
-    }
 
-    GL_CHECK(gpuShader->glProgram = glCreateProgram());
+        GL_CHECK(gpuShader->glProgram = glCreateProgram());
 
-    // link program
-    for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
-        GLES2GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
-        GL_CHECK(glAttachShader(gpuShader->glProgram, gpuStage.glShader));
-    }
+        // link program
+        for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
+            GLES2GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
+            GL_CHECK(glAttachShader(gpuShader->glProgram, gpuStage.glShader));
+        }
 
-    GL_CHECK(glLinkProgram(gpuShader->glProgram));
+        GL_CHECK(glLinkProgram(gpuShader->glProgram));
 
-    // detach & delete immediately
-    for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
-        GLES2GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
-        if (gpuStage.glShader) {
-            GL_CHECK(glDetachShader(gpuShader->glProgram, gpuStage.glShader));
-            GL_CHECK(glDeleteShader(gpuStage.glShader));
-            gpuStage.glShader = 0;
+        // detach & delete immediately
+        for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
+            GLES2GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
+            if (gpuStage.glShader) {
+                GL_CHECK(glDetachShader(gpuShader->glProgram, gpuStage.glShader));
+                GL_CHECK(glDeleteShader(gpuStage.glShader));
+                gpuStage.glShader = 0;
+            }
         }
-    }
 
-    GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_LINK_STATUS, &status));
-    if (status != 1) {
-        CC_LOG_ERROR("Failed to link Shader [%s].", gpuShader->name.c_str());
-        GLint logSize = 0;
-        GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_INFO_LOG_LENGTH, &logSize));
-        if (logSize) {
-            ++logSize;
-            auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
-            GL_CHECK(glGetProgramInfoLog(gpuShader->glProgram, logSize, nullptr, logs));
-
-            CC_LOG_ERROR(logs);
-            CC_FREE(logs);
-            return;
+        GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_LINK_STATUS, &status));
+        if (status != 1) {
+            CC_LOG_ERROR("Failed to link Shader [%s].", gpuShader->name.c_str());
+            GLint logSize = 0;
+            GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_INFO_LOG_LENGTH, &logSize));
+            if (logSize) {
+                ++logSize;
+                auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
+                GL_CHECK(glGetProgramInfoLog(gpuShader->glProgram, logSize, nullptr, logs));
+
+                CC_LOG_ERROR(logs);
+                CC_FREE(logs);
+                return;
+            }
         }
-    }
 
-    CC_LOG_INFO("Shader '%s' compilation succeeded.", gpuShader->name.c_str());
+        if (binaryCache && status == GL_TRUE) storeProgramBinary(binaryCache, binaryKey, gpuShader);
+
+        CC_LOG_INFO("Shader '%s' compilation succeeded.", gpuShader->name.c_str());
+    }
 
     GLint attrMaxLength = 0;
     GLint attrCount     = 0;
@@ -41,6 +41,7 @@
 #include "GLES2Sampler.h"
 #include "GLES2Shader.h"
 #include "GLES2Texture.h"
+#include "gfx-gles-common/GLESProgramBinaryCache.h"
 
 // when capturing GLES commands (RENDERDOC_HOOK_EGL=1, default value)
 // renderdoc doesn't support this extension during replay
@@ -211,6 +212,15 @@ bool GLES2Device::doInit(const DeviceInfo &info) {
     _vendor   = reinterpret_cast<const char *>(glGetString(GL_VENDOR));
     _version  = reinterpret_cast<const char *>(glGetString(GL_VERSION));
 
+    if (checkExtension("get_program_binary")) {
+        GLint binaryFormatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &binaryFormatCount);
+        if (binaryFormatCount > 0) {
+            _programBinaryCache = CC_NEW(GLESProgramBinaryCache);
+            _programBinaryCache->initialize("gles2", _vendor + "|" + _renderer + "|" + _version);
+        }
+    }
+
     CC_LOG_INFO("GLES2 device initialized.");
     CC_LOG_INFO("RENDERER: %s", _renderer.c_str());
     CC_LOG_INFO("VENDOR: %s", _vendor.c_str());
@@ -219,6 +229,7 @@ bool GLES2Device::doInit(const DeviceInfo &info) {
     CC_LOG_INFO("COMPRESSED_FORMATS: %s", compressedFmts.c_str());
     CC_LOG_INFO("USE_VAO: %s", _gpuConstantRegistry->useVAO ? "true" : "false");
     CC_LOG_INFO("FRAMEBUFFER_FETCH: %s", fbfLevelStr.c_str());
+    CC_LOG_INFO("PROGRAM_BINARY_CACHE: %s", _programBinaryCache && _programBinaryCache->isEnabled() ? "true" : "false");
     CC_LOG_DEBUG("EXTENSIONS: %s", extStr.c_str());
 
     glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, reinterpret_cast<GLint *>(&_caps.maxVertexAttributes));
@@ -240,6 +251,7 @@ bool GLES2Device::doInit(const DeviceInfo &info) {
 void GLES2Device::doDestroy() {
     _gpuBlitManager->destroy();
 
+    CC_SAFE_DELETE(_programBinaryCache)
     CC_SAFE_DELETE(_gpuFramebufferCacheMap)
     CC_SAFE_DELETE(_gpuConstantRegistry)
     CC_SAFE_DELETE(_gpuStagingBufferPool)
@@ -284,6 +296,8 @@ void GLES2Device::present() {
     queue->_numDrawCalls = 0;
     queue->_numInstances = 0;
     queue->_numTriangles = 0;
+
+    _memoryTracker.nextFrame();
 }
 
 void GLES2Device::bindRenderContext(bool bound) {
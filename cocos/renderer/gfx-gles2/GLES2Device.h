@@ -45,6 +45,7 @@ class GLES2GPUStateCache;
 class GLES2GPUBlitManager;
 class GLES2GPUStagingBufferPool;
 class GLES2GPUConstantRegistry;
+class GLESProgramBinaryCache;
 class GLES2GPUFramebufferCacheMap;
 
 class CC_GLES2_API GLES2Device final : public Device {
@@ -79,6 +80,7 @@ public:
     inline GLES2GPUStagingBufferPool *  stagingBufferPool() const { return _gpuStagingBufferPool; }
     inline GLES2GPUConstantRegistry *   constantRegistry() const { return _gpuConstantRegistry; }
     inline GLES2GPUFramebufferCacheMap *framebufferCacheMap() const { return _gpuFramebufferCacheMap; }
+    inline GLESProgramBinaryCache *     programBinaryCache() const { return _programBinaryCache; }
 
     inline bool checkExtension(const String &extension) const {
         return std::any_of(_extensions.begin(), _extensions.end(), [&extension](auto &ext) {
@@ -129,6 +131,7 @@ protected:
     GLES2GPUStagingBufferPool *  _gpuStagingBufferPool   = nullptr;
     GLES2GPUConstantRegistry *   _gpuConstantRegistry    = nullptr;
     GLES2GPUFramebufferCacheMap *_gpuFramebufferCacheMap = nullptr;
+    GLESProgramBinaryCache *     _programBinaryCache     = nullptr;
 
     StringArray _extensions;
 };
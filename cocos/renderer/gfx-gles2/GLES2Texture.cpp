@@ -57,7 +57,7 @@ void GLES2Texture::doInit(const TextureInfo& /*info*/) {
 
     cmdFuncGLES2CreateTexture(GLES2Device::getInstance(), _gpuTexture);
 
-    GLES2Device::getInstance()->getMemoryStatus().textureSize += _size;
+    GLES2Device::getInstance()->getMemoryTracker().allocate(this, _size);
 }
 
 void GLES2Texture::doInit(const TextureViewInfo& /*info*/) {
@@ -65,7 +65,7 @@ void GLES2Texture::doInit(const TextureViewInfo& /*info*/) {
 }
 
 void GLES2Texture::doDestroy() {
-    GLES2Device::getInstance()->getMemoryStatus().textureSize -= _size;
+    GLES2Device::getInstance()->getMemoryTracker().release(this, _size);
 
     if (_gpuTexture) {
         cmdFuncGLES2DestroyTexture(GLES2Device::getInstance(), _gpuTexture);
@@ -75,14 +75,14 @@ void GLES2Texture::doDestroy() {
 }
 
 void GLES2Texture::doResize(uint width, uint height, uint size) {
-    GLES2Device::getInstance()->getMemoryStatus().textureSize -= _size;
+    GLES2Device::getInstance()->getMemoryTracker().release(this, _size);
 
     _gpuTexture->width  = width;
     _gpuTexture->height = height;
     _gpuTexture->size   = size;
     cmdFuncGLES2ResizeTexture(GLES2Device::getInstance(), _gpuTexture);
 
-    GLES2Device::getInstance()->getMemoryStatus().textureSize += size;
+    GLES2Device::getInstance()->getMemoryTracker().allocate(this, size);
 }
 
 } // namespace gfx
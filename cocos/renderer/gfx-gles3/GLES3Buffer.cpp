@@ -53,7 +53,7 @@ void GLES3Buffer::doInit(const BufferInfo & /*info*/) {
     }
 
     cmdFuncGLES3CreateBuffer(GLES3Device::getInstance(), _gpuBuffer);
-    GLES3Device::getInstance()->getMemoryStatus().bufferSize += _size;
+    GLES3Device::getInstance()->getMemoryTracker().allocate(this, _size);
 }
 
 void GLES3Buffer::doInit(const BufferViewInfo &info) {
@@ -75,7 +75,7 @@ void GLES3Buffer::doDestroy() {
     if (_gpuBuffer) {
         if (!_isBufferView) {
             cmdFuncGLES3DestroyBuffer(GLES3Device::getInstance(), _gpuBuffer);
-            GLES3Device::getInstance()->getMemoryStatus().bufferSize -= _size;
+            GLES3Device::getInstance()->getMemoryTracker().release(this, _size);
         }
         CC_DELETE(_gpuBuffer);
         _gpuBuffer = nullptr;
@@ -83,13 +83,13 @@ void GLES3Buffer::doDestroy() {
 }
 
 void GLES3Buffer::doResize(uint size, uint count) {
-    GLES3Device::getInstance()->getMemoryStatus().bufferSize -= _size;
+    GLES3Device::getInstance()->getMemoryTracker().release(this, _size);
 
     _gpuBuffer->size  = size;
     _gpuBuffer->count = count;
     cmdFuncGLES3ResizeBuffer(GLES3Device::getInstance(), _gpuBuffer);
 
-    GLES3Device::getInstance()->getMemoryStatus().bufferSize += size;
+    GLES3Device::getInstance()->getMemoryTracker().allocate(this, size);
 }
 
 void GLES3Buffer::update(const void *buffer, uint size) {
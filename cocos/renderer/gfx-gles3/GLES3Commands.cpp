@@ -28,6 +28,7 @@
 #include "GLES3Commands.h"
 #include "GLES3Device.h"
 #include "gfx-gles-common/GLESCommandPool.h"
+#include "gfx-gles-common/GLESProgramBinaryCache.h"
 
 #define BUFFER_OFFSET(idx) (static_cast<char *>(0) + (idx))
 
@@ -1140,99 +1141,151 @@ void cmdFuncGLES3DestroySampler(GLES3Device *device, GLES3GPUSampler *gpuSampler
     }
 }
 
+namespace {
+bool loadProgramBinary(GLESProgramBinaryCache *binaryCache, const String &binaryKey, GLES3GPUShader *gpuShader) {
+    uint32_t        format = 0U;
+    vector<uint8_t> binary;
+    if (!binaryCache->load(binaryKey, &format, &binary)) return false;
+
+    GL_CHECK(gpuShader->glProgram = glCreateProgram());
+    // not wrapped in GL_CHECK: a rejected binary is an expected outcome, handled through the link status
+    glProgramBinary(gpuShader->glProgram, format, binary.data(), static_cast<GLsizei>(binary.size()));
+    glGetError();
+
+    GLint status = GL_FALSE;
+    GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        CC_LOG_WARNING("Program binary of shader '%s' rejected by driver, recompiling.", gpuShader->name.c_str());
+        GL_CHECK(glDeleteProgram(gpuShader->glProgram));
+        gpuShader->glProgram = 0;
+        binaryCache->remove(binaryKey);
+        return false;
+    }
+    return true;
+}
+
+void storeProgramBinary(GLESProgramBinaryCache *binaryCache, const String &binaryKey, GLES3GPUShader *gpuShader) {
+    GLint length = 0;
+    GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0) return;
+
+    GLenum          format = GL_NONE;
+    vector<uint8_t> binary(length);
+    GL_CHECK(glGetProgramBinary(gpuShader->glProgram, length, nullptr, &format, binary.data()));
+    binaryCache->store(binaryKey, format, binary.data(), static_cast<uint32_t>(length));
+}
+} // namespace
+
 void cmdFuncGLES3CreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
     GLenum glShaderStage = 0;
     String shaderStageStr;
     GLint  status;
 
-    for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
-        GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
-        uint                 version  = 300;
+    GLESProgramBinaryCache *binaryCache = device->programBinaryCache();
+    String                  binaryKey;
+    if (binaryCache) {
+        for (const auto &gpuStage : gpuShader->gpuStages) {
+            binaryKey += StringUtil::format("#stage %u\n", static_cast<uint>(gpuStage.type)) + gpuStage.source;
+        }
+    }
 
-        switch (gpuStage.type) {
-            case ShaderStageFlagBit::VERTEX: {
-                glShaderStage  = GL_VERTEX_SHADER;
-                shaderStageStr = "Vertex Shader";
-                break;
-            }
-            case ShaderStageFlagBit::FRAGMENT: {
-                glShaderStage  = GL_FRAGMENT_SHADER;
-                shaderStageStr = "Fragment Shader";
-                break;
-            }
-            case ShaderStageFlagBit::COMPUTE: {
-                glShaderStage  = GL_COMPUTE_SHADER;
-                shaderStageStr = "Compute Shader";
-                version        = 310;
-                break;
-            }
-            default: {
-                CCASSERT(false, "Unsupported ShaderStageFlagBit");
-                return;
+    if (binaryCache && loadProgramBinary(binaryCache, binaryKey, gpuShader)) {
+        CC_LOG_DEBUG("Shader '%s' loaded from program binary cache.", gpuShader->name.c_str());
+    } else {
+        for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
+            GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
+            uint                 version  = 300;
+
+            switch (gpuStage.type) {
+                case ShaderStageFlagBit::VERTEX: {
+                    glShaderStage  = GL_VERTEX_SHADER;
+                    shaderStageStr = "Vertex Shader";
+                    break;
+                }
+                case ShaderStageFlagBit::FRAGMENT: {
+                    glShaderStage  = GL_FRAGMENT_SHADER;
+                    shaderStageStr = "Fragment Shader";
+                    break;
+                }
+                case ShaderStageFlagBit::COMPUTE: {
+                    glShaderStage  = GL_COMPUTE_SHADER;
+                    shaderStageStr = "Compute Shader";
+                    version        = 310;
+                    break;
+                }
+                default: {
+                    CCASSERT(false, "Unsupported ShaderStageFlagBit");
+                    return;
+                }
             }
-        }
 
-        GL_CHECK(gpuStage.glShader = glCreateShader(glShaderStage));
-        String      shaderSource = StringUtil::format("#version %u es\n", version) + gpuStage.source;
-        const char *source       = shaderSource.c_str();
-        GL_CHECK(glShaderSource(gpuStage.glShader, 1, (const GLchar **)&source, nullptr));
-        GL_CHECK(glCompileShader(gpuStage.glShader));
+            GL_CHECK(gpuStage.glShader = glCreateShader(glShaderStage));
+            String      shaderSource = StringUtil::format("#version %u es\n", version) + gpuStage.source;
+            const char *source       = shaderSource.c_str();
+            GL_CHECK(glShaderSource(gpuStage.glShader, 1, (const GLchar **)&source, nullptr));
+            GL_CHECK(glCompileShader(gpuStage.glShader));
 
-        GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_COMPILE_STATUS, &status));
-        if (status != GL_TRUE) {
-            GLint logSize = 0;
-            GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_INFO_LOG_LENGTH, &logSize));
+            GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_COMPILE_STATUS, &status));
+            if (status != GL_TRUE) {
+                GLint logSize = 0;
+                GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_INFO_LOG_LENGTH, &logSize));
 
-            ++logSize;
-            auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
-            GL_CHECK(glGetShaderInfoLog(gpuStage.glShader, logSize, nullptr, logs));
+                ++logSize;
+                auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
+                GL_CHECK(glGetShaderInfoLog(gpuStage.glShader, logSize, nullptr, logs));
 
-            CC_LOG_ERROR("%s in %s compilation failed.", shaderStageStr.c_str(), gpuShader->name.c_str());
-            CC_LOG_ERROR(logs);
-            CC_FREE(logs);
-            GL_CHECK(glDeleteShader(gpuStage.glShader));
-            gpuStage.glShader = 0;
-            return;
+                CC_LOG_ERROR("%s in %s compilation failed.", shaderStageStr.c_str(), gpuShader->name.c_str());
+                CC_LOG_ERROR(logs);
+                CC_FREE(logs);
+                GL_CHECK(glDeleteShader(gpuStage.glShader));
+                gpuStage.glShader = 0;
+                return;
+            }
         }
-    }
 
-    GL_CHECK(gpuShader->glProgram = glCreateProgram());
+        GL_CHECK(gpuShader->glProgram = glCreateProgram());
 
-    // link program
-    for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
-        GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
-        GL_CHECK(glAttachShader(gpuShader->glProgram, gpuStage.glShader));
-    }
+        // link program
+        for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
+            GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
+            GL_CHECK(glAttachShader(gpuShader->glProgram, gpuStage.glShader));
+        }
 
-    GL_CHECK(glLinkProgram(gpuShader->glProgram));
+        if (binaryCache) {
+            GL_CHECK(glProgramParameteri(gpuShader->glProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+        }
+        GL_CHECK(glLinkProgram(gpuShader->glProgram));
 
-    // detach & delete immediately
-    for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
-        GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
-        if (gpuStage.glShader) {
-            GL_CHECK(glDetachShader(gpuShader->glProgram, gpuStage.glShader));
-            GL_CHECK(glDeleteShader(gpuStage.glShader));
-            gpuStage.glShader = 0;
+        // detach & delete immediately
+        for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
+            GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
+            if (gpuStage.glShader) {
+                GL_CHECK(glDetachShader(gpuShader->glProgram, gpuStage.glShader));
+                GL_CHECK(glDeleteShader(gpuStage.glShader));
+                gpuStage.glShader = 0;
+            }
         }
-    }
 
-    GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_LINK_STATUS, &status));
-    if (status != 1) {
-        CC_LOG_ERROR("Failed to link Shader [%s].", gpuShader->name.c_str());
-        GLint logSize = 0;
-        GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_INFO_LOG_LENGTH, &logSize));
-        if (logSize) {
-            ++logSize;
-            auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
-            GL_CHECK(glGetProgramInfoLog(gpuShader->glProgram, logSize, nullptr, logs));
-
-            CC_LOG_ERROR(logs);
-            CC_FREE(logs);
-            return;
+        GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_LINK_STATUS, &status));
+        if (status != 1) {
+            CC_LOG_ERROR("Failed to link Shader [%s].", gpuShader->name.c_str());
+            GLint logSize = 0;
+            GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_INFO_LOG_LENGTH, &logSize));
+            if (logSize) {
+                ++logSize;
+                auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
+                GL_CHECK(glGetProgramInfoLog(gpuShader->glProgram, logSize, nullptr, logs));
+
+                CC_LOG_ERROR(logs);
+                CC_FREE(logs);
+                return;
+            }
         }
-    }
 
-    CC_LOG_INFO("Shader '%s' compilation succeeded.", gpuShader->name.c_str());
+        if (binaryCache && status == GL_TRUE) storeProgramBinary(binaryCache, binaryKey, gpuShader);
+
+        CC_LOG_INFO("Shader '%s' compilation succeeded.", gpuShader->name.c_str());
+    }
 
     GLint attrMaxLength = 0;
     GLint attrCount     = 0;
@@ -2608,6 +2661,12 @@ void cmdFuncGLES3UpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, co
     } else if (hasFlag(gpuBuffer->usage, BufferUsageBit::TRANSFER_SRC)) {
         memcpy(gpuBuffer->buffer + offset, buffer, size);
     } else {
+        // dynamic buffers are streamed through the ring buffer, the GPU-side copy doesn't stall on buffers still in flight
+        if (hasFlag(gpuBuffer->memUsage, MemoryUsageBit::HOST) && gpuBuffer->glTarget != GL_NONE &&
+            device->ringBuffer()->upload(gpuBuffer->glBuffer, offset, buffer, size)) {
+            return;
+        }
+
         switch (gpuBuffer->glTarget) {
             case GL_ARRAY_BUFFER: {
                 if (device->stateCache()->glVAO) {
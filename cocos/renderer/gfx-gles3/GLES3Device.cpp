@@ -44,6 +44,7 @@
 #include "GLES3Texture.h"
 #include "base/Utils.h"
 #include "gfx-gles-common/GLESCommandPool.h"
+#include "gfx-gles-common/GLESProgramBinaryCache.h"
 
 // when capturing GLES commands (RENDERDOC_HOOK_EGL=1, default value)
 // renderdoc doesn't support this extension during replay
@@ -181,6 +182,9 @@ bool GLES3Device::doInit(const DeviceInfo &info) {
     }
 #endif
 
+    _gpuRingBuffer = CC_NEW(GLES3GPURingBuffer);
+    _gpuRingBuffer->initialize(checkExtension("buffer_storage"));
+
     _gpuConstantRegistry->glMinorVersion     = _renderContext->minorVer();
     _gpuConstantRegistry->defaultFramebuffer = _renderContext->getDefaultFramebuffer();
 
@@ -209,6 +213,13 @@ bool GLES3Device::doInit(const DeviceInfo &info) {
     _vendor   = reinterpret_cast<const char *>(glGetString(GL_VENDOR));
     _version  = reinterpret_cast<const char *>(glGetString(GL_VERSION));
 
+    GLint binaryFormatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+    if (binaryFormatCount > 0) {
+        _programBinaryCache = CC_NEW(GLESProgramBinaryCache);
+        _programBinaryCache->initialize("gles3", _vendor + "|" + _renderer + "|" + _version);
+    }
+
     CC_LOG_INFO("GLES3 device initialized.");
     CC_LOG_INFO("RENDERER: %s", _renderer.c_str());
     CC_LOG_INFO("VENDOR: %s", _vendor.c_str());
@@ -217,6 +228,7 @@ bool GLES3Device::doInit(const DeviceInfo &info) {
     CC_LOG_INFO("COMPRESSED_FORMATS: %s", compressedFmts.c_str());
     CC_LOG_INFO("PIXEL_LOCAL_STORAGE: level %d, size %d", _gpuConstantRegistry->mPLS, _gpuConstantRegistry->mPLSsize);
     CC_LOG_INFO("FRAMEBUFFER_FETCH: %s", fbfLevelStr.c_str());
+    CC_LOG_INFO("PROGRAM_BINARY_CACHE: %s", _programBinaryCache && _programBinaryCache->isEnabled() ? "true" : "false");
 
     glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, reinterpret_cast<GLint *>(&_caps.maxVertexAttributes));
     glGetIntegerv(GL_MAX_VERTEX_UNIFORM_VECTORS, reinterpret_cast<GLint *>(&_caps.maxVertexUniformVectors));
@@ -252,9 +264,11 @@ bool GLES3Device::doInit(const DeviceInfo &info) {
 }
 
 void GLES3Device::doDestroy() {
+    CC_SAFE_DELETE(_programBinaryCache)
     CC_SAFE_DELETE(_gpuFramebufferCacheMap)
     CC_SAFE_DELETE(_gpuConstantRegistry)
     CC_SAFE_DELETE(_gpuStagingBufferPool)
+    CC_SAFE_DELETE(_gpuRingBuffer)
     CC_SAFE_DELETE(_gpuStateCache)
 
     CCASSERT(!_memoryStatus.bufferSize, "Buffer memory leaked");
@@ -289,12 +303,15 @@ void GLES3Device::present() {
     _numInstances = queue->_numInstances;
     _numTriangles = queue->_numTriangles;
 
+    _gpuRingBuffer->fence();
     _context->present();
 
     // Clear queue stats
     queue->_numDrawCalls = 0;
     queue->_numInstances = 0;
     queue->_numTriangles = 0;
+
+    _memoryTracker.nextFrame();
 }
 
 void GLES3Device::bindRenderContext(bool bound) {
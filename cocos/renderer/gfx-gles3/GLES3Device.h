@@ -35,8 +35,10 @@ namespace gfx {
 class GLES3Context;
 class GLES3GPUStateCache;
 class GLES3GPUStagingBufferPool;
+class GLES3GPURingBuffer;
 class GLES3GPUFramebufferCacheMap;
 class GLES3GPUConstantRegistry;
+class GLESProgramBinaryCache;
 
 class CC_GLES3_API GLES3Device final : public Device {
 public:
@@ -67,8 +69,10 @@ public:
 
     inline GLES3GPUStateCache *         stateCache() const { return _gpuStateCache; }
     inline GLES3GPUStagingBufferPool *  stagingBufferPool() const { return _gpuStagingBufferPool; }
+    inline GLES3GPURingBuffer *         ringBuffer() const { return _gpuRingBuffer; }
     inline GLES3GPUConstantRegistry *   constantRegistry() const { return _gpuConstantRegistry; }
     inline GLES3GPUFramebufferCacheMap *framebufferCacheMap() const { return _gpuFramebufferCacheMap; }
+    inline GLESProgramBinaryCache *     programBinaryCache() const { return _programBinaryCache; }
 
     inline bool checkExtension(const String &extension) const {
         return std::any_of(_extensions.begin(), _extensions.end(), [&extension](auto &ext) {
@@ -114,8 +118,10 @@ protected:
     GLES3Context *               _deviceContext          = nullptr;
     GLES3GPUStateCache *         _gpuStateCache          = nullptr;
     GLES3GPUStagingBufferPool *  _gpuStagingBufferPool   = nullptr;
+    GLES3GPURingBuffer *         _gpuRingBuffer          = nullptr;
     GLES3GPUConstantRegistry *   _gpuConstantRegistry    = nullptr;
     GLES3GPUFramebufferCacheMap *_gpuFramebufferCacheMap = nullptr;
+    GLESProgramBinaryCache *     _programBinaryCache     = nullptr;
 
     StringArray _extensions;
 };
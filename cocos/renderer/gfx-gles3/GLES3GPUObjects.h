@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <cstring>
 #include <utility>
 
 #include "gfx-base/GFXDef.h"
@@ -534,5 +535,135 @@ private:
     vector<Buffer> _pool;
 };
 
+constexpr size_t RING_BUFFER_SIZE      = 8 * 1024 * 1024; // 8M streaming ring by default
+constexpr size_t RING_BUFFER_ALIGNMENT = 16U;
+class GLES3GPURingBuffer final : public Object {
+public:
+    ~GLES3GPURingBuffer() override {
+        destroy();
+    }
+
+    // persistent mapping needs EXT_buffer_storage, otherwise each upload maps its range unsynchronized
+    void initialize(bool persistent, size_t capacity = RING_BUFFER_SIZE) {
+        _capacity   = capacity;
+        _persistent = persistent && glBufferStorageEXT;
+
+        GL_CHECK(glGenBuffers(1, &_glBuffer));
+        GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, _glBuffer));
+        if (_persistent) {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT_EXT | GL_MAP_COHERENT_BIT_EXT;
+            GL_CHECK(glBufferStorageEXT(GL_COPY_READ_BUFFER, static_cast<GLsizeiptr>(_capacity), nullptr, flags));
+            GL_CHECK(_mappedData = static_cast<uint8_t *>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, static_cast<GLsizeiptr>(_capacity), flags)));
+            if (!_mappedData) _persistent = false;
+        }
+        if (!_persistent) {
+            GL_CHECK(glBufferData(GL_COPY_READ_BUFFER, static_cast<GLsizeiptr>(_capacity), nullptr, GL_STREAM_DRAW));
+        }
+        GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+    }
+
+    void destroy() {
+        for (const Segment &segment : _segments) {
+            GL_CHECK(glDeleteSync(segment.glFence));
+        }
+        _segments.clear();
+
+        if (_glBuffer) {
+            if (_mappedData) {
+                GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, _glBuffer));
+                GL_CHECK(glUnmapBuffer(GL_COPY_READ_BUFFER));
+                GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+                _mappedData = nullptr;
+            }
+            GL_CHECK(glDeleteBuffers(1, &_glBuffer));
+            _glBuffer = 0U;
+        }
+        _head = _tail = _fencedHead = 0U;
+    }
+
+    // stages the data in the ring and issues a GPU-side copy into the destination,
+    // returns false if the ring has no room left so the caller can fall back to glBufferSubData
+    bool upload(GLuint glDstBuffer, uint dstOffset, const void *data, uint size) {
+        if (!_glBuffer || !size) return false;
+
+        size_t offset = 0U;
+        if (!alloc(size, &offset)) return false;
+
+        GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, _glBuffer));
+        if (_persistent) {
+            memcpy(_mappedData + offset, data, size);
+        } else {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+            void *           dst   = nullptr;
+            GL_CHECK(dst = glMapBufferRange(GL_COPY_READ_BUFFER, static_cast<GLintptr>(offset), size, flags));
+            if (!dst) {
+                GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+                return false;
+            }
+            memcpy(dst, data, size);
+            GL_CHECK(glUnmapBuffer(GL_COPY_READ_BUFFER));
+        }
+        GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, glDstBuffer));
+        GL_CHECK(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), dstOffset, size));
+        GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+        GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+        return true;
+    }
+
+    // called once per frame, everything staged so far is reclaimed once the GPU passes this fence
+    void fence() {
+        if (!_glBuffer || _head == _fencedHead) return;
+
+        GLsync glFence = nullptr;
+        GL_CHECK(glFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        _segments.push_back({glFence, _head});
+        _fencedHead = _head;
+    }
+
+private:
+    struct Segment {
+        GLsync   glFence = nullptr;
+        uint64_t head    = 0U;
+    };
+
+    void reclaim() {
+        while (!_segments.empty()) {
+            const Segment &segment = _segments.front();
+            GLenum         status  = GL_TIMEOUT_EXPIRED;
+            GL_CHECK(status = glClientWaitSync(segment.glFence, 0, 0));
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+
+            GL_CHECK(glDeleteSync(segment.glFence));
+            _tail = segment.head;
+            _segments.pop_front();
+        }
+    }
+
+    bool alloc(size_t size, size_t *offset) {
+        size = (size + RING_BUFFER_ALIGNMENT - 1) & ~(RING_BUFFER_ALIGNMENT - 1);
+        if (size > _capacity / 4) return false; // large uploads would starve the ring
+
+        reclaim();
+
+        size_t cur   = _head % _capacity;
+        size_t waste = cur + size > _capacity ? _capacity - cur : 0U; // skip the tail end on wrap around
+        if (_capacity - (_head - _tail) < waste + size) return false;
+
+        _head += waste;
+        *offset = _head % _capacity;
+        _head += size;
+        return true;
+    }
+
+    GLuint         _glBuffer   = 0U;
+    uint8_t *      _mappedData = nullptr;
+    bool           _persistent = false;
+    size_t         _capacity   = 0U;
+    uint64_t       _head       = 0U; // monotonic, in bytes
+    uint64_t       _tail       = 0U;
+    uint64_t       _fencedHead = 0U;
+    deque<Segment> _segments;
+};
+
 } // namespace gfx
 } // namespace cc
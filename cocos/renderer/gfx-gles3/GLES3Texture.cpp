@@ -58,7 +58,7 @@ void GLES3Texture::doInit(const TextureInfo& /*info*/) {
     cmdFuncGLES3CreateTexture(GLES3Device::getInstance(), _gpuTexture);
 
     if (!_gpuTexture->memoryless) {
-        GLES3Device::getInstance()->getMemoryStatus().textureSize += _size;
+        GLES3Device::getInstance()->getMemoryTracker().allocate(this, _size);
     }
 }
 
@@ -69,7 +69,7 @@ void GLES3Texture::doInit(const TextureViewInfo& /*info*/) {
 void GLES3Texture::doDestroy() {
     if (_gpuTexture) {
         if (!_gpuTexture->memoryless) {
-            GLES3Device::getInstance()->getMemoryStatus().textureSize -= _size;
+            GLES3Device::getInstance()->getMemoryTracker().release(this, _size);
         }
         cmdFuncGLES3DestroyTexture(GLES3Device::getInstance(), _gpuTexture);
         CC_DELETE(_gpuTexture);
@@ -79,7 +79,7 @@ void GLES3Texture::doDestroy() {
 
 void GLES3Texture::doResize(uint width, uint height, uint size) {
     if (!_gpuTexture->memoryless) {
-        GLES3Device::getInstance()->getMemoryStatus().textureSize -= _size;
+        GLES3Device::getInstance()->getMemoryTracker().release(this, _size);
     }
 
     _gpuTexture->width  = width;
@@ -88,7 +88,7 @@ void GLES3Texture::doResize(uint width, uint height, uint size) {
     cmdFuncGLES3ResizeTexture(GLES3Device::getInstance(), _gpuTexture);
 
     if (!_gpuTexture->memoryless) {
-        GLES3Device::getInstance()->getMemoryStatus().textureSize += size;
+        GLES3Device::getInstance()->getMemoryTracker().allocate(this, size);
     }
 }
 
@@ -78,7 +78,7 @@ void CCMTLBuffer::doInit(const BufferInfo &info) {
             _drawInfos.resize(_count);
         }
     }
-    CCMTLDevice::getInstance()->getMemoryStatus().bufferSize += _size;
+    CCMTLDevice::getInstance()->getMemoryTracker().allocate(this, _size);
 }
 
 void CCMTLBuffer::doInit(const BufferViewInfo &info) {
@@ -124,7 +124,7 @@ void CCMTLBuffer::doDestroy() {
         return;
     }
 
-    CCMTLDevice::getInstance()->getMemoryStatus().bufferSize -= _size;
+    CCMTLDevice::getInstance()->getMemoryTracker().release(this, _size);
 
     if (!_indexedPrimitivesIndirectArguments.empty()) {
         _indexedPrimitivesIndirectArguments.clear();
@@ -162,8 +162,8 @@ void CCMTLBuffer::doResize(uint size, uint count) {
         createMTLBuffer(size, _memUsage);
     }
 
-    CCMTLDevice::getInstance()->getMemoryStatus().bufferSize -= _size;
-    CCMTLDevice::getInstance()->getMemoryStatus().bufferSize += size;
+    CCMTLDevice::getInstance()->getMemoryTracker().release(this, _size);
+    CCMTLDevice::getInstance()->getMemoryTracker().allocate(this, size);
 
     _size = size;
     _count = count;
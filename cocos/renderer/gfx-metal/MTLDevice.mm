@@ -269,6 +269,8 @@ void CCMTLDevice::present() {
         [(NSAutoreleasePool*)_autoreleasePool drain];
         _autoreleasePool = nullptr;
     }
+
+    _memoryTracker.nextFrame();
 }
 
 void CCMTLDevice::onPresentCompleted() {
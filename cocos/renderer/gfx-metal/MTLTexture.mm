@@ -57,7 +57,7 @@ void CCMTLTexture::doInit(const TextureInfo &info) {
         return;
     }
 
-    CCMTLDevice::getInstance()->getMemoryStatus().textureSize += _size;
+    CCMTLDevice::getInstance()->getMemoryTracker().allocate(this, _size);
 }
 
 void CCMTLTexture::doInit(const TextureViewInfo &info) {
@@ -140,7 +140,7 @@ void CCMTLTexture::doDestroy() {
         return;
     }
 
-    CCMTLDevice::getInstance()->getMemoryStatus().textureSize -= _size;
+    CCMTLDevice::getInstance()->getMemoryTracker().release(this, _size);
 
     id<MTLTexture> mtlTexure = _mtlTexture;
     _mtlTexture = nil;
@@ -173,7 +173,7 @@ void CCMTLTexture::doResize(uint width, uint height, uint size) {
         return;
     }
 
-    CCMTLDevice::getInstance()->getMemoryStatus().textureSize += size;
+    CCMTLDevice::getInstance()->getMemoryTracker().allocate(this, size);
 
     if (oldMTLTexture) {
         std::function<void(void)> destroyFunc = [=]() {
@@ -184,7 +184,7 @@ void CCMTLTexture::doResize(uint width, uint height, uint size) {
         };
         //gpu object only
         CCMTLGPUGarbageCollectionPool::getInstance()->collect(destroyFunc);
-        CCMTLDevice::getInstance()->getMemoryStatus().textureSize -= oldSize;
+        CCMTLDevice::getInstance()->getMemoryTracker().release(this, oldSize);
     }
 }
 
@@ -54,6 +54,7 @@ void BufferValidator::doInit(const BufferInfo &info) {
 
     /////////// execute ///////////
 
+    _actor->setMemoryTag(_memoryTag);
     _actor->initialize(info);
 }
 
@@ -87,18 +88,22 @@ void BufferValidator::update(const void *buffer, uint size) {
     CCASSERT(size && size <= _size, "invalid size");
     CCASSERT(buffer, "invalid buffer data");
 
-    if (hasFlag(_usage, BufferUsageBit::INDIRECT)) {
-        const auto * drawInfo      = static_cast<const DrawInfo *>(buffer);
-        const size_t drawInfoCount = size / sizeof(DrawInfo);
-        const bool   isIndexed     = drawInfoCount > 0 && drawInfo->indexCount > 0;
-        for (size_t i = 1U; i < drawInfoCount; ++i) {
-            if ((++drawInfo)->indexCount > 0 != isIndexed) {
-                CCASSERT(false, "inconsistent indirect draw infos on using index buffer");
+    DeviceValidator *device = DeviceValidator::getInstance();
+    ++device->_statistics->bufferUpdates;
+    if (device->isFrameValidated()) {
+        if (hasFlag(_usage, BufferUsageBit::INDIRECT)) {
+            const auto * drawInfo      = static_cast<const DrawInfo *>(buffer);
+            const size_t drawInfoCount = size / sizeof(DrawInfo);
+            const bool   isIndexed     = drawInfoCount > 0 && drawInfo->indexCount > 0;
+            for (size_t i = 1U; i < drawInfoCount; ++i) {
+                if ((++drawInfo)->indexCount > 0 != isIndexed) {
+                    CCASSERT(false, "inconsistent indirect draw infos on using index buffer");
+                }
             }
         }
-    }
 
-    sanityCheck(buffer, size);
+        sanityCheck(buffer, size);
+    }
 
     /////////// execute ///////////
 
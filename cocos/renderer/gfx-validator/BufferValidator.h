@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL BufferValidator final : public Agent<Buffer> {
 public:
+    CC_SLAB_ALLOCATED(BufferValidator)
+
     explicit BufferValidator(Buffer *actor);
     ~BufferValidator() override;
 
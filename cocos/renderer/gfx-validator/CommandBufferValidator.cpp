@@ -68,16 +68,22 @@ void CommandBufferValidator::doDestroy() {
 }
 
 void CommandBufferValidator::begin(RenderPass *renderPass, uint subpass, Framebuffer *framebuffer) {
-    CCASSERT(!_insideRenderPass, "Already inside a render pass?");
-    CCASSERT(_type != CommandBufferType::PRIMARY || !renderPass, "Primary command buffer cannot inherit render passes");
+    // the sampling decision holds for everything recorded until the next begin
+    _validating = DeviceValidator::getInstance()->isCommandBufferValidated(this);
+    _statistics = ValidationStatistics();
+
+    if (_validating) {
+        CCASSERT(!_insideRenderPass, "Already inside a render pass?");
+        CCASSERT(_type != CommandBufferType::PRIMARY || !renderPass, "Primary command buffer cannot inherit render passes");
+
+        _recorder.clear();
+        _curStates.descriptorSets.assign(_curStates.descriptorSets.size(), nullptr);
+    }
 
     // secondary command buffers enter the render pass right here
     _insideRenderPass = !!renderPass;
     _commandsFlushed  = false;
 
-    _recorder.clear();
-    _curStates.descriptorSets.assign(_curStates.descriptorSets.size(), nullptr);
-
     /////////// execute ///////////
 
     RenderPass * renderPassActor  = renderPass ? static_cast<RenderPassValidator *>(renderPass)->getActor() : nullptr;
@@ -87,7 +93,9 @@ void CommandBufferValidator::begin(RenderPass *renderPass, uint subpass, Framebu
 }
 
 void CommandBufferValidator::end() {
-    CCASSERT(_type != CommandBufferType::PRIMARY || !_insideRenderPass, "Still inside a render pass?");
+    if (_validating) {
+        CCASSERT(_type != CommandBufferType::PRIMARY || !_insideRenderPass, "Still inside a render pass?");
+    }
     _insideRenderPass = false;
 
     /////////// execute ///////////
@@ -96,28 +104,32 @@ void CommandBufferValidator::end() {
 }
 
 void CommandBufferValidator::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint stencil, CommandBuffer *const *secondaryCBs, uint secondaryCBCount) {
-    CCASSERT(renderPass, "invalid render pass");
-    CCASSERT(fbo, "invalid framebuffer");
+    ++_statistics.renderPasses;
+
+    if (_validating) {
+        CCASSERT(renderPass, "invalid render pass");
+        CCASSERT(fbo, "invalid framebuffer");
+
+        CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'endRenderPass' must be recorded in primary command buffers.");
+        CCASSERT(!_insideRenderPass, "Already inside a render pass?");
+
+        _curStates.renderPass   = renderPass;
+        _curStates.framebuffer  = fbo;
+        _curStates.renderArea   = renderArea;
+        _curStates.clearDepth   = depth;
+        _curStates.clearStencil = stencil;
+        size_t clearColorCount  = renderPass->getColorAttachments().size();
+        if (clearColorCount) {
+            _curStates.clearColors.assign(colors, colors + clearColorCount);
+        }
 
-    CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'endRenderPass' must be recorded in primary command buffers.");
-    CCASSERT(!_insideRenderPass, "Already inside a render pass?");
+        if (DeviceValidator::getInstance()->isRecording()) {
+            _recorder.recordBeginRenderPass(_curStates);
+        }
+    }
     _insideRenderPass = true;
     _curSubpass       = 0U;
 
-    _curStates.renderPass   = renderPass;
-    _curStates.framebuffer  = fbo;
-    _curStates.renderArea   = renderArea;
-    _curStates.clearDepth   = depth;
-    _curStates.clearStencil = stencil;
-    size_t clearColorCount  = renderPass->getColorAttachments().size();
-    if (clearColorCount) {
-        _curStates.clearColors.assign(colors, colors + clearColorCount);
-    }
-
-    if (DeviceValidator::getInstance()->isRecording()) {
-        _recorder.recordBeginRenderPass(_curStates);
-    }
-
     /////////// execute ///////////
 
     static vector<CommandBuffer *> secondaryCBActors;
@@ -146,13 +158,15 @@ void CommandBufferValidator::nextSubpass() {
 }
 
 void CommandBufferValidator::endRenderPass() {
-    CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'endRenderPass' must be recorded in primary command buffers.");
-    CCASSERT(_insideRenderPass, "No render pass to end?");
-    _insideRenderPass = false;
+    if (_validating) {
+        CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'endRenderPass' must be recorded in primary command buffers.");
+        CCASSERT(_insideRenderPass, "No render pass to end?");
 
-    if (DeviceValidator::getInstance()->isRecording()) {
-        _recorder.recordEndRenderPass();
+        if (DeviceValidator::getInstance()->isRecording()) {
+            _recorder.recordEndRenderPass();
+        }
     }
+    _insideRenderPass = false;
 
     /////////// execute ///////////
 
@@ -161,7 +175,9 @@ void CommandBufferValidator::endRenderPass() {
 
 void CommandBufferValidator::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
     if (!count) return; // be more lenient on this for now
-    CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'execute' must be recorded in primary command buffers.");
+    if (_validating) {
+        CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'execute' must be recorded in primary command buffers.");
+    }
 
     /////////// execute ///////////
 
@@ -169,14 +185,18 @@ void CommandBufferValidator::execute(CommandBuffer *const *cmdBuffs, uint32_t co
     cmdBuffActors.resize(count);
 
     for (uint i = 0U; i < count; ++i) {
-        cmdBuffActors[i] = static_cast<CommandBufferValidator *>(cmdBuffs[i])->getActor();
+        auto *cmdBuff    = static_cast<CommandBufferValidator *>(cmdBuffs[i]);
+        cmdBuffActors[i] = cmdBuff->getActor();
+        _statistics.accumulate(cmdBuff->_statistics);
     }
 
     _actor->execute(cmdBuffActors.data(), count);
 }
 
 void CommandBufferValidator::bindPipelineState(PipelineState *pso) {
-    _curStates.pipelineState = pso;
+    if (_validating) {
+        _curStates.pipelineState = pso;
+    }
 
     /////////// execute ///////////
 
@@ -184,12 +204,14 @@ void CommandBufferValidator::bindPipelineState(PipelineState *pso) {
 }
 
 void CommandBufferValidator::bindDescriptorSet(uint set, DescriptorSet *descriptorSet, uint dynamicOffsetCount, const uint *dynamicOffsets) {
-    CCASSERT(set < DeviceValidator::getInstance()->bindingMappingInfo().bufferOffsets.size(), "invalid set index");
-    CCASSERT(descriptorSet, "invalid descriptor set");
-    //CCASSERT(descriptorSet->getLayout()->getDynamicBindings().size() == dynamicOffsetCount, "wrong number of dynamic offsets"); // be more lenient on this
+    if (_validating) {
+        CCASSERT(set < DeviceValidator::getInstance()->bindingMappingInfo().bufferOffsets.size(), "invalid set index");
+        CCASSERT(descriptorSet, "invalid descriptor set");
+        //CCASSERT(descriptorSet->getLayout()->getDynamicBindings().size() == dynamicOffsetCount, "wrong number of dynamic offsets"); // be more lenient on this
 
-    _curStates.descriptorSets[set] = descriptorSet;
-    _curStates.dynamicOffsets[set].assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
+        _curStates.descriptorSets[set] = descriptorSet;
+        _curStates.dynamicOffsets[set].assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
+    }
 
     /////////// execute ///////////
 
@@ -197,7 +219,9 @@ void CommandBufferValidator::bindDescriptorSet(uint set, DescriptorSet *descript
 }
 
 void CommandBufferValidator::bindInputAssembler(InputAssembler *ia) {
-    _curStates.inputAssembler = ia;
+    if (_validating) {
+        _curStates.inputAssembler = ia;
+    }
 
     /////////// execute ///////////
 
@@ -284,18 +308,22 @@ void CommandBufferValidator::setStencilCompareMask(StencilFace face, uint ref, u
 }
 
 void CommandBufferValidator::draw(const DrawInfo &info) {
-    CCASSERT(_insideRenderPass, "Command 'draw' must be recorded inside render passes.");
+    ++_statistics.drawCalls;
 
-    if (DeviceValidator::getInstance()->isRecording()) {
-        _recorder.recordDrawcall(_curStates);
-    }
+    if (_validating) {
+        CCASSERT(_insideRenderPass, "Command 'draw' must be recorded inside render passes.");
+
+        if (DeviceValidator::getInstance()->isRecording()) {
+            _recorder.recordDrawcall(_curStates);
+        }
 
-    const auto &psoLayouts = _curStates.pipelineState->getPipelineLayout()->getSetLayouts();
-    for (size_t i = 0; i < psoLayouts.size(); ++i) {
-        if (!_curStates.descriptorSets[i]) continue; // there may be inactive sets
-        const auto &dsBindings  = _curStates.descriptorSets[i]->getLayout()->getBindings();
-        const auto &psoBindings = psoLayouts[i]->getBindings();
-        CCASSERT(psoBindings.size() == dsBindings.size(), "Descriptor set layout mismatch");
+        const auto &psoLayouts = _curStates.pipelineState->getPipelineLayout()->getSetLayouts();
+        for (size_t i = 0; i < psoLayouts.size(); ++i) {
+            if (!_curStates.descriptorSets[i]) continue; // there may be inactive sets
+            const auto &dsBindings  = _curStates.descriptorSets[i]->getLayout()->getBindings();
+            const auto &psoBindings = psoLayouts[i]->getBindings();
+            CCASSERT(psoBindings.size() == dsBindings.size(), "Descriptor set layout mismatch");
+        }
     }
 
     /////////// execute ///////////
@@ -304,11 +332,15 @@ void CommandBufferValidator::draw(const DrawInfo &info) {
 }
 
 void CommandBufferValidator::updateBuffer(Buffer *buff, const void *data, uint size) {
-    CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'updateBuffer' must be recorded in primary command buffers.");
-    CCASSERT(!_insideRenderPass, "Command 'updateBuffer' must be recorded outside render passes.");
+    ++_statistics.bufferUpdates;
 
     auto *bufferValidator = static_cast<BufferValidator *>(buff);
-    bufferValidator->sanityCheck(data, size);
+    if (_validating) {
+        CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'updateBuffer' must be recorded in primary command buffers.");
+        CCASSERT(!_insideRenderPass, "Command 'updateBuffer' must be recorded outside render passes.");
+
+        bufferValidator->sanityCheck(data, size);
+    }
 
     /////////// execute ///////////
 
@@ -316,11 +348,15 @@ void CommandBufferValidator::updateBuffer(Buffer *buff, const void *data, uint s
 }
 
 void CommandBufferValidator::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint count) {
-    CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'copyBuffersToTexture' must be recorded in primary command buffers.");
-    CCASSERT(!_insideRenderPass, "Command 'copyBuffersToTexture' must be recorded outside render passes.");
+    ++_statistics.textureCopies;
 
     auto *textureValidator = static_cast<TextureValidator *>(texture);
-    textureValidator->sanityCheck();
+    if (_validating) {
+        CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'copyBuffersToTexture' must be recorded in primary command buffers.");
+        CCASSERT(!_insideRenderPass, "Command 'copyBuffersToTexture' must be recorded outside render passes.");
+
+        textureValidator->sanityCheck();
+    }
 
     /////////// execute ///////////
 
@@ -328,7 +364,9 @@ void CommandBufferValidator::copyBuffersToTexture(const uint8_t *const *buffers,
 }
 
 void CommandBufferValidator::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint count, Filter filter) {
-    CCASSERT(!_insideRenderPass, "Command 'blitTexture' must be recorded outside render passes.");
+    if (_validating) {
+        CCASSERT(!_insideRenderPass, "Command 'blitTexture' must be recorded outside render passes.");
+    }
 
     /////////// execute ///////////
 
@@ -341,7 +379,11 @@ void CommandBufferValidator::blitTexture(Texture *srcTexture, Texture *dstTextur
 }
 
 void CommandBufferValidator::dispatch(const DispatchInfo &info) {
-    CCASSERT(!_insideRenderPass, "Command 'dispatch' must be recorded outside render passes.");
+    ++_statistics.dispatches;
+
+    if (_validating) {
+        CCASSERT(!_insideRenderPass, "Command 'dispatch' must be recorded outside render passes.");
+    }
 
     /////////// execute ///////////
 
@@ -35,6 +35,8 @@ namespace gfx {
 
 class CC_DLL CommandBufferValidator final : public Agent<CommandBuffer> {
 public:
+    CC_SLAB_ALLOCATED(CommandBufferValidator)
+
     using Agent::Agent;
     ~CommandBufferValidator() override;
 
@@ -80,7 +82,10 @@ protected:
 
     bool _insideRenderPass{false};
     bool _commandsFlushed{false};
+    bool _validating{true};
     uint _curSubpass{0U};
+
+    ValidationStatistics _statistics;
 };
 
 } // namespace gfx
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL DescriptorSetLayoutValidator final : public Agent<DescriptorSetLayout> {
 public:
+    CC_SLAB_ALLOCATED(DescriptorSetLayoutValidator)
+
     explicit DescriptorSetLayoutValidator(DescriptorSetLayout *actor);
     ~DescriptorSetLayoutValidator() override;
 
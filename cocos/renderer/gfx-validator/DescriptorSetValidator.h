@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL DescriptorSetValidator final : public Agent<DescriptorSet> {
 public:
+    CC_SLAB_ALLOCATED(DescriptorSetValidator)
+
     explicit DescriptorSetValidator(DescriptorSet *actor);
     ~DescriptorSetValidator() override;
 
@@ -52,10 +52,12 @@ DeviceValidator *DeviceValidator::getInstance() {
 
 DeviceValidator::DeviceValidator(Device *device) : Agent(device) {
     DeviceValidator::instance = this;
+    _statistics               = CC_NEW(ValidationStatistics);
 }
 
 DeviceValidator::~DeviceValidator() {
     CC_SAFE_DELETE(_actor);
+    CC_SAFE_DELETE(_statistics);
     DeviceValidator::instance = nullptr;
 }
 
@@ -74,6 +76,7 @@ bool DeviceValidator::doInit(const DeviceInfo &info) {
     _renderer                = _actor->getRenderer();
     _vendor                  = _actor->getVendor();
     _caps                    = _actor->_caps;
+    _maxFramesInFlight       = _actor->_maxFramesInFlight;
 
     memcpy(_features.data(), _actor->_features.data(), static_cast<uint>(Feature::COUNT) * sizeof(bool));
     cmdBuffValidator->initValidator();
@@ -126,6 +129,41 @@ void DeviceValidator::acquire() {
 void DeviceValidator::present() {
     _actor->present();
     ++_currentFrame;
+
+    ++_statistics->frames;
+    if (_frameValidated) ++_statistics->validatedFrames;
+    updateFrameValidated();
+}
+
+void DeviceValidator::setValidationMode(ValidationMode mode) {
+    _mode = mode;
+    updateFrameValidated();
+}
+
+void DeviceValidator::updateFrameValidated() {
+    switch (_mode) {
+        case ValidationMode::FULL: _frameValidated = true; break;
+        case ValidationMode::SAMPLED: _frameValidated = _currentFrame % _sampleInterval == 0U; break;
+        case ValidationMode::STATISTICS: _frameValidated = false; break;
+    }
+    // captured frames need every command
+    _frameValidated = _frameValidated || _recording;
+}
+
+bool DeviceValidator::isCommandBufferValidated(const CommandBuffer *cmdBuff) const {
+    if (!_frameValidated) return false;
+    if (_mode != ValidationMode::SAMPLED || _recording || _sampleRatio >= 1.F) return true;
+
+    // stable within a frame, different across frames, and safe to call from any recording thread
+    auto hash = static_cast<uint>(reinterpret_cast<uintptr_t>(cmdBuff) >> 4U) ^ (_currentFrame * 0x9e3779b9U);
+    hash ^= hash >> 16U;
+    hash *= 0x7feb352dU;
+    hash ^= hash >> 15U;
+    return static_cast<float>(hash & 0xffffU) < _sampleRatio * 65536.F;
+}
+
+void DeviceValidator::resetStatistics() {
+    *_statistics = ValidationStatistics();
 }
 
 CommandBuffer *DeviceValidator::createCommandBuffer(const CommandBufferInfo &info, bool hasAgent) {
@@ -231,7 +269,12 @@ TextureBarrier *DeviceValidator::createTextureBarrier() {
 
 void DeviceValidator::copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) {
     auto *textureValidator = static_cast<TextureValidator *>(dst);
-    textureValidator->sanityCheck();
+    ++_statistics->textureCopies;
+    if (_frameValidated) {
+        textureValidator->sanityCheck();
+    }
+
+    /////////// execute ///////////
 
     _actor->copyBuffersToTexture(buffers, textureValidator->getActor(), regions, count);
 }
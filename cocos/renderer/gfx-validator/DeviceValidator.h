@@ -31,8 +31,18 @@
 namespace cc {
 namespace gfx {
 
+struct ValidationStatistics;
+
+enum class ValidationMode {
+    FULL,       // every call is validated
+    SAMPLED,    // every Nth frame is validated, and only a share of the command buffers recorded in it
+    STATISTICS, // nothing is validated, calls are only counted
+};
+
 class CC_DLL DeviceValidator final : public Agent<Device> {
 public:
+    CC_SLAB_ALLOCATED(DeviceValidator)
+
     static DeviceValidator *getInstance();
 
     ~DeviceValidator() override;
@@ -81,6 +91,7 @@ public:
     uint             getWidth() const override { return _actor->getWidth(); }
     uint             getHeight() const override { return _actor->getHeight(); }
     MemoryStatus &   getMemoryStatus() override { return _actor->getMemoryStatus(); }
+    MemoryTracker &  getMemoryTracker() override { return _actor->getMemoryTracker(); }
     uint             getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint             getNumInstances() const override { return _actor->getNumInstances(); }
     uint             getNumTris() const override { return _actor->getNumTris(); }
@@ -89,6 +100,21 @@ public:
     inline bool isRecording() const { return _recording; }
     inline uint currentFrame() const { return _currentFrame; }
 
+    void                  setValidationMode(ValidationMode mode);
+    inline ValidationMode getValidationMode() const { return _mode; }
+    inline void           setSampleInterval(uint frames) { _sampleInterval = std::max(frames, 1U); }
+    inline uint           getSampleInterval() const { return _sampleInterval; }
+    inline void           setSampleRatio(float ratio) { _sampleRatio = std::min(std::max(ratio, 0.F), 1.F); }
+    inline float          getSampleRatio() const { return _sampleRatio; }
+
+    // whether the calls of the current frame are validated at all
+    inline bool isFrameValidated() const { return _frameValidated; }
+    // whether the commands of the given command buffer, about to be recorded, are validated
+    bool isCommandBufferValidated(const CommandBuffer *cmdBuff) const;
+
+    inline const ValidationStatistics &getStatistics() const { return *_statistics; }
+    void                               resetStatistics();
+
 protected:
     static DeviceValidator *instance;
 
@@ -105,8 +131,19 @@ protected:
     void bindRenderContext(bool bound) override { _actor->bindRenderContext(bound); }
     void bindDeviceContext(bool bound) override { _actor->bindDeviceContext(bound); }
 
+    void updateFrameValidated();
+
     bool _recording{false};
     uint _currentFrame{1U};
+
+    ValidationMode        _mode{ValidationMode::FULL};
+    uint                  _sampleInterval{60U};
+    float                 _sampleRatio{1.F};
+    bool                  _frameValidated{true};
+    ValidationStatistics *_statistics{nullptr};
+
+    friend class QueueValidator;
+    friend class BufferValidator;
 };
 
 } // namespace gfx
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL FramebufferValidator final : public Agent<Framebuffer> {
 public:
+    CC_SLAB_ALLOCATED(FramebufferValidator)
+
     explicit FramebufferValidator(Framebuffer *actor);
     ~FramebufferValidator() override;
 
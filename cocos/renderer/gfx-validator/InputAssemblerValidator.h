@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL InputAssemblerValidator final : public Agent<InputAssembler> {
 public:
+    CC_SLAB_ALLOCATED(InputAssemblerValidator)
+
     explicit InputAssemblerValidator(InputAssembler *actor);
     ~InputAssemblerValidator() override;
 
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL PipelineLayoutValidator final : public Agent<PipelineLayout> {
 public:
+    CC_SLAB_ALLOCATED(PipelineLayoutValidator)
+
     explicit PipelineLayoutValidator(PipelineLayout *actor);
     ~PipelineLayoutValidator() override;
 
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL PipelineStateValidator final : public Agent<PipelineState> {
 public:
+    CC_SLAB_ALLOCATED(PipelineStateValidator)
+
     explicit PipelineStateValidator(PipelineState *actor);
     ~PipelineStateValidator() override;
 
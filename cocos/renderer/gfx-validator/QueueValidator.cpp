@@ -57,10 +57,15 @@ void QueueValidator::submit(CommandBuffer *const *cmdBuffs, uint count) {
     static vector<CommandBuffer *> cmdBuffActors;
     cmdBuffActors.resize(count);
 
+    ValidationStatistics *statistics = DeviceValidator::getInstance()->_statistics;
     for (uint i = 0U; i < count; ++i) {
         auto *cmdBuff = static_cast<CommandBufferValidator *>(cmdBuffs[i]);
-        CCASSERT(cmdBuff->_commandsFlushed, "command buffers must be flushed before submit");
+        CCASSERT(!cmdBuff->_validating || cmdBuff->_commandsFlushed, "command buffers must be flushed before submit");
         cmdBuffActors[i] = cmdBuff->getActor();
+
+        statistics->accumulate(cmdBuff->_statistics);
+        ++statistics->commandBuffers;
+        if (cmdBuff->_validating) ++statistics->validatedCommandBuffers;
     }
 
     _actor->submit(cmdBuffActors.data(), count);
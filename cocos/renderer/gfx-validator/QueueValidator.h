@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL QueueValidator final : public Agent<Queue> {
 public:
+    CC_SLAB_ALLOCATED(QueueValidator)
+
     using Queue::submit;
 
     explicit QueueValidator(Queue *actor);
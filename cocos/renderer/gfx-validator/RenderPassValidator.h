@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL RenderPassValidator final : public Agent<RenderPass> {
 public:
+    CC_SLAB_ALLOCATED(RenderPassValidator)
+
     explicit RenderPassValidator(RenderPass *actor);
     ~RenderPassValidator() override;
 
@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL SamplerValidator final : public Agent<Sampler> {
 public:
+    CC_SLAB_ALLOCATED(SamplerValidator)
+
     explicit SamplerValidator(Sampler *actor);
     ~SamplerValidator() override;
 
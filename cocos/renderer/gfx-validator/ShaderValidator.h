@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL ShaderValidator final : public Agent<Shader> {
 public:
+    CC_SLAB_ALLOCATED(ShaderValidator)
+
     explicit ShaderValidator(Shader *actor);
     ~ShaderValidator() override;
 
@@ -56,6 +56,9 @@ void TextureValidator::doInit(const TextureInfo &info) {
     static const TextureUsageBit INEFFICIENT_MASK{TextureUsageBit::INPUT_ATTACHMENT | TextureUsageBit::SAMPLED};
     CCASSERT((info.usage & INEFFICIENT_MASK) != INEFFICIENT_MASK, "Both SAMPLED and INPUT_ATTACHMENT are specified?");
 
+    /////////// execute ///////////
+
+    _actor->setMemoryTag(_memoryTag);
     _actor->initialize(info);
 }
 
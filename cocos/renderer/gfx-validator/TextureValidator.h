@@ -33,6 +33,8 @@ namespace gfx {
 
 class CC_DLL TextureValidator final : public Agent<Texture> {
 public:
+    CC_SLAB_ALLOCATED(TextureValidator)
+
     explicit TextureValidator(Texture *actor);
     ~TextureValidator() override;
 
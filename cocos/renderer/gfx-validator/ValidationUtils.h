@@ -57,6 +57,26 @@ struct DrawcallSnapshot {
 
 struct CommandBufferStorage : public DynamicStates, RenderPassSnapshot, DrawcallSnapshot {};
 
+struct ValidationStatistics {
+    uint frames                  = 0U;
+    uint validatedFrames         = 0U;
+    uint commandBuffers          = 0U;
+    uint validatedCommandBuffers = 0U;
+    uint renderPasses            = 0U;
+    uint drawCalls               = 0U;
+    uint dispatches              = 0U;
+    uint bufferUpdates           = 0U;
+    uint textureCopies           = 0U;
+
+    void accumulate(const ValidationStatistics &other) {
+        renderPasses += other.renderPasses;
+        drawCalls += other.drawCalls;
+        dispatches += other.dispatches;
+        bufferUpdates += other.bufferUpdates;
+        textureCopies += other.textureCopies;
+    }
+};
+
 class CommandRecorder {
 public:
     void recordBeginRenderPass(const RenderPassSnapshot &renderPass);
@@ -54,7 +54,7 @@ void CCVKBuffer::doInit(const BufferInfo & /*info*/) {
     }
 
     cmdFuncCCVKCreateBuffer(CCVKDevice::getInstance(), _gpuBuffer);
-    CCVKDevice::getInstance()->getMemoryStatus().bufferSize += _size;
+    CCVKDevice::getInstance()->getMemoryTracker().allocate(this, _size);
 
     _gpuBufferView = CC_NEW(CCVKGPUBufferView);
     createBufferView();
@@ -87,7 +87,7 @@ void CCVKBuffer::doDestroy() {
             CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuBuffer);
             CCVKDevice::getInstance()->gpuBarrierManager()->cancel(_gpuBuffer);
             CC_DELETE(_gpuBuffer);
-            CCVKDevice::getInstance()->getMemoryStatus().bufferSize -= _size;
+            CCVKDevice::getInstance()->getMemoryTracker().release(this, _size);
         }
         _gpuBuffer = nullptr;
     }
@@ -96,7 +96,7 @@ void CCVKBuffer::doDestroy() {
 void CCVKBuffer::doResize(uint size, uint count) {
     VkDeviceSize oldStartOffset = _gpuBuffer->startOffset;
 
-    CCVKDevice::getInstance()->getMemoryStatus().bufferSize -= _size;
+    CCVKDevice::getInstance()->getMemoryTracker().release(this, _size);
     CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuBuffer);
 
     _gpuBuffer->size  = size;
@@ -111,7 +111,7 @@ void CCVKBuffer::doResize(uint size, uint count) {
         _gpuBuffer->indexedIndirectCmds.resize(drawInfoCount);
         _gpuBuffer->indirectCmds.resize(drawInfoCount);
     }
-    CCVKDevice::getInstance()->getMemoryStatus().bufferSize += size;
+    CCVKDevice::getInstance()->getMemoryTracker().allocate(this, size);
 }
 
 void CCVKBuffer::update(const void *buffer, uint size) {
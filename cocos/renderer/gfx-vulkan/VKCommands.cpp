@@ -31,7 +31,9 @@
 #include "VKDevice.h"
 #include "VKQueue.h"
 #include "VKSPIRV.h"
+#include "base/Data.h"
 #include "gfx-base/GFXSampler.h"
+#include "platform/FileUtils.h"
 #include "vulkan/vulkan_core.h"
 
 #include <algorithm>
@@ -41,6 +43,15 @@ namespace gfx {
 
 namespace {
 constexpr bool ENABLE_LAZY_ALLOCATION = true;
+
+constexpr uint32_t PIPELINE_CACHE_MAGIC         = 0x43504B56; // 'VKPC'
+constexpr size_t   PIPELINE_CACHE_MAX_SIZE      = 32 * 1024 * 1024;
+constexpr uint     PIPELINE_CACHE_SAVE_INTERVAL = 1800U; // in frames
+
+struct PipelineCachePrefix {
+    uint32_t magic    = PIPELINE_CACHE_MAGIC;
+    uint32_t dataSize = 0U; // guards against truncated writes
+};
 } // namespace
 
 CCVKGPUCommandBufferPool *CCVKGPUDevice::getCommandBufferPool() {
@@ -756,6 +767,7 @@ void cmdFuncCCVKCreateComputePipelineState(CCVKDevice *device, CCVKGPUPipelineSt
 
     VK_CHECK(vkCreateComputePipelines(device->gpuDevice()->vkDevice, device->gpuDevice()->vkPipelineCache,
                                       1, &createInfo, nullptr, &gpuPipelineState->vkPipeline));
+    device->gpuPipelineCache()->setDirty();
 }
 
 void cmdFuncCCVKCreateGraphicsPipelineState(CCVKDevice *device, CCVKGPUPipelineState *gpuPipelineState) {
@@ -962,6 +974,7 @@ void cmdFuncCCVKCreateGraphicsPipelineState(CCVKDevice *device, CCVKGPUPipelineS
 
     VK_CHECK(vkCreateGraphicsPipelines(device->gpuDevice()->vkDevice, device->gpuDevice()->vkPipelineCache,
                                        1, &createInfo, nullptr, &gpuPipelineState->vkPipeline));
+    device->gpuPipelineCache()->setDirty();
 }
 
 void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const void *buffer, uint size, const CCVKGPUCommandBuffer *cmdBuffer) {
@@ -1524,5 +1537,92 @@ void CCVKGPUBufferHub::flush(CCVKGPUTransportHub *transportHub) {
     buffers.clear();
 }
 
+void CCVKGPUPipelineCache::init() {
+    _path = FileUtils::getInstance()->getWritablePath() + "pipeline-cache/vulkan.bin";
+
+    Data data;
+    if (FileUtils::getInstance()->isFileExist(_path)) {
+        data = FileUtils::getInstance()->getDataFromFile(_path);
+    }
+
+    VkPipelineCacheCreateInfo pipelineCacheInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    if (validate(data.getBytes(), data.getSize())) {
+        pipelineCacheInfo.initialDataSize = data.getSize() - sizeof(PipelineCachePrefix);
+        pipelineCacheInfo.pInitialData    = data.getBytes() + sizeof(PipelineCachePrefix);
+        CC_LOG_INFO("Pipeline cache loaded: %u bytes.", static_cast<uint>(pipelineCacheInfo.initialDataSize));
+    } else if (!data.isNull()) {
+        CC_LOG_INFO("Pipeline cache discarded: produced by a different device or driver.");
+        FileUtils::getInstance()->removeFile(_path);
+    }
+
+    if (vkCreatePipelineCache(_device->vkDevice, &pipelineCacheInfo, nullptr, &_device->vkPipelineCache) != VK_SUCCESS) {
+        // the driver may still reject data it doesn't like, start over with an empty cache then
+        pipelineCacheInfo.initialDataSize = 0U;
+        pipelineCacheInfo.pInitialData    = nullptr;
+        VK_CHECK(vkCreatePipelineCache(_device->vkDevice, &pipelineCacheInfo, nullptr, &_device->vkPipelineCache));
+    }
+}
+
+void CCVKGPUPipelineCache::update() {
+    if (++_framesSinceSave < PIPELINE_CACHE_SAVE_INTERVAL) return;
+    save();
+}
+
+void CCVKGPUPipelineCache::save() {
+    _framesSinceSave = 0U;
+    if (!_dirty || !_device->vkPipelineCache) return;
+    _dirty = false;
+
+    size_t size = 0U;
+    VK_CHECK(vkGetPipelineCacheData(_device->vkDevice, _device->vkPipelineCache, &size, nullptr));
+    if (!size) return;
+    if (size > PIPELINE_CACHE_MAX_SIZE) {
+        CC_LOG_WARNING("Pipeline cache exceeds %u bytes, not persisted.", static_cast<uint>(PIPELINE_CACHE_MAX_SIZE));
+        FileUtils::getInstance()->removeFile(_path);
+        return;
+    }
+
+    PipelineCachePrefix prefix;
+    auto *              bytes = static_cast<uint8_t *>(malloc(sizeof(prefix) + size));
+    if (vkGetPipelineCacheData(_device->vkDevice, _device->vkPipelineCache, &size, bytes + sizeof(prefix)) != VK_SUCCESS) {
+        free(bytes);
+        return;
+    }
+    prefix.dataSize = static_cast<uint32_t>(size);
+    memcpy(bytes, &prefix, sizeof(prefix));
+
+    Data data;
+    data.fastSet(bytes, static_cast<ssize_t>(sizeof(prefix) + size));
+
+    FileUtils *fileUtils = FileUtils::getInstance();
+    String     dir       = fileUtils->getWritablePath() + "pipeline-cache/";
+    if (!fileUtils->isDirectoryExist(dir)) fileUtils->createDirectory(dir);
+    fileUtils->writeDataToFile(data, _path);
+}
+
+void CCVKGPUPipelineCache::destroy() {
+    if (_device->vkPipelineCache) {
+        save();
+        vkDestroyPipelineCache(_device->vkDevice, _device->vkPipelineCache, nullptr);
+        _device->vkPipelineCache = VK_NULL_HANDLE;
+    }
+}
+
+bool CCVKGPUPipelineCache::validate(const uint8_t *data, size_t size) const {
+    if (!data || size < sizeof(PipelineCachePrefix) + sizeof(VkPipelineCacheHeaderVersionOne)) return false;
+
+    PipelineCachePrefix prefix;
+    memcpy(&prefix, data, sizeof(prefix));
+    if (prefix.magic != PIPELINE_CACHE_MAGIC || prefix.dataSize != size - sizeof(prefix)) return false;
+
+    VkPipelineCacheHeaderVersionOne header;
+    memcpy(&header, data + sizeof(prefix), sizeof(header));
+    return header.headerSize >= sizeof(header) &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == _properties.vendorID &&
+           header.deviceID == _properties.deviceID &&
+           !memcmp(header.pipelineCacheUUID, _properties.pipelineCacheUUID, VK_UUID_SIZE);
+}
+
 } // namespace gfx
 } // namespace cc
@@ -167,13 +167,13 @@ void CCVKDescriptorSet::doDestroy() {
 
                 CCVKDescriptorInfo &descriptorInfo = instance.descriptorInfos[i];
                 if (binding.gpuBufferView) {
-                    descriptorHub->disengage(binding.gpuBufferView, &descriptorInfo.buffer);
+                    descriptorHub->disengage(_gpuDescriptorSet, binding.gpuBufferView, &descriptorInfo.buffer);
                 }
                 if (binding.gpuTextureView) {
-                    descriptorHub->disengage(binding.gpuTextureView, &descriptorInfo.image);
+                    descriptorHub->disengage(_gpuDescriptorSet, binding.gpuTextureView, &descriptorInfo.image);
                 }
                 if (binding.gpuSampler) {
-                    descriptorHub->disengage(binding.gpuSampler, &descriptorInfo.image);
+                    descriptorHub->disengage(_gpuDescriptorSet, binding.gpuSampler, &descriptorInfo.image);
                 }
             }
 
@@ -244,7 +244,7 @@ void CCVKDescriptorSet::update() {
                                 descriptorHub->disengage(binding.gpuSampler, &descriptorInfo.image);
                             }
                             if (sampler) {
-                                descriptorHub->connect(sampler, &descriptorInfo.image);
+                                descriptorHub->connect(_gpuDescriptorSet, sampler, &descriptorInfo.image);
                                 descriptorHub->update(sampler, &descriptorInfo.image);
                             }
                         }
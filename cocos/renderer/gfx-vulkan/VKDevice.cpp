@@ -343,6 +343,7 @@ bool CCVKDevice::doInit(const DeviceInfo &info) {
     VK_CHECK(vmaCreateAllocator(&allocatorInfo, &_gpuDevice->memoryAllocator));
 
     uint backBufferCount = gpuContext->swapchainCreateInfo.minImageCount;
+    _maxFramesInFlight   = backBufferCount;
     for (uint i = 0U; i < backBufferCount; i++) {
         _gpuFencePools.push_back(CC_NEW(CCVKGPUFencePool(_gpuDevice)));
         _gpuRecycleBins.push_back(CC_NEW(CCVKGPURecycleBin(_gpuDevice)));
@@ -390,8 +391,8 @@ bool CCVKDevice::doInit(const DeviceInfo &info) {
     _gpuDevice->defaultBuffer.count                                   = 1U;
     cmdFuncCCVKCreateBuffer(this, &_gpuDevice->defaultBuffer);
 
-    VkPipelineCacheCreateInfo pipelineCacheInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
-    VK_CHECK(vkCreatePipelineCache(_gpuDevice->vkDevice, &pipelineCacheInfo, nullptr, &_gpuDevice->vkPipelineCache));
+    _gpuPipelineCache = CC_NEW(CCVKGPUPipelineCache(_gpuDevice, gpuContext->physicalDeviceProperties));
+    _gpuPipelineCache->init();
 
     for (uint i = 0U; i < gpuContext->swapchainCreateInfo.minImageCount; i++) {
         TextureInfo depthStencilTexInfo;
@@ -484,9 +485,10 @@ void CCVKDevice::doDestroy() {
     }
 
     if (_gpuDevice) {
-        if (_gpuDevice->vkPipelineCache) {
-            vkDestroyPipelineCache(_gpuDevice->vkDevice, _gpuDevice->vkPipelineCache, nullptr);
-            _gpuDevice->vkPipelineCache = VK_NULL_HANDLE;
+        if (_gpuPipelineCache) {
+            _gpuPipelineCache->destroy();
+            CC_DELETE(_gpuPipelineCache);
+            _gpuPipelineCache = nullptr;
         }
 
         if (_gpuDevice->defaultBuffer.vkBuffer) {
@@ -596,6 +598,9 @@ void CCVKDevice::present() {
         gpuRecycleBin()->clear();
         gpuStagingBufferPool()->reset();
     }
+
+    _gpuPipelineCache->update();
+    _memoryTracker.nextFrame();
 }
 
 CCVKGPUFencePool *        CCVKDevice::gpuFencePool() { return _gpuFencePools[_gpuDevice->curBackBufferIndex]; }
@@ -43,6 +43,7 @@ class CCVKGPUDescriptorHub;
 class CCVKGPUSemaphorePool;
 class CCVKGPUBarrierManager;
 class CCVKGPUDescriptorSetHub;
+class CCVKGPUPipelineCache;
 
 class CCVKGPUFencePool;
 class CCVKGPURecycleBin;
@@ -92,6 +93,7 @@ public:
     inline CCVKGPUSemaphorePool *   gpuSemaphorePool() { return _gpuSemaphorePool; }
     inline CCVKGPUBarrierManager *  gpuBarrierManager() { return _gpuBarrierManager; }
     inline CCVKGPUDescriptorSetHub *gpuDescriptorSetHub() { return _gpuDescriptorSetHub; }
+    inline CCVKGPUPipelineCache *   gpuPipelineCache() { return _gpuPipelineCache; }
 
     CCVKGPUFencePool *        gpuFencePool();
     CCVKGPURecycleBin *       gpuRecycleBin();
@@ -145,6 +147,7 @@ protected:
     CCVKGPUSemaphorePool *   _gpuSemaphorePool    = nullptr;
     CCVKGPUDescriptorSetHub *_gpuDescriptorSetHub = nullptr;
     CCVKGPUBarrierManager *  _gpuBarrierManager   = nullptr;
+    CCVKGPUPipelineCache *   _gpuPipelineCache    = nullptr;
 
     vector<const char *> _layers;
     vector<const char *> _extensions;
@@ -806,7 +806,10 @@ public:
         }
     }
 
-    void record(const CCVKGPUDescriptorSet *gpuDescriptorSet) {
+    // forceUpdate should be set when the underlying resources are recreated,
+    // as the new handles may alias the old ones, and thus the cached contents
+    void record(const CCVKGPUDescriptorSet *gpuDescriptorSet, bool forceUpdate = false) {
+        if (forceUpdate) invalidate(gpuDescriptorSet);
         update(gpuDescriptorSet);
         for (uint i = 0U; i < _device->backBufferCount; ++i) {
             if (i == _device->curBackBufferIndex) {
@@ -823,6 +826,14 @@ public:
                 _setsToBeUpdated[i].erase(gpuDescriptorSet);
             }
         }
+        invalidate(gpuDescriptorSet);
+    }
+
+    // drops the cached contents, the next record or flush rewrites the whole set
+    void invalidate(const CCVKGPUDescriptorSet *gpuDescriptorSet) {
+        for (const auto &instance : gpuDescriptorSet->instances) {
+            _contents.erase(instance.vkDescriptorSet);
+        }
     }
 
     void flush() {
@@ -836,6 +847,14 @@ public:
 private:
     void update(const CCVKGPUDescriptorSet *gpuDescriptorSet) {
         const CCVKGPUDescriptorSet::Instance &instance = gpuDescriptorSet->instances[_device->curBackBufferIndex];
+
+        // skip the write entirely if the set already holds exactly these descriptors
+        vector<CCVKDescriptorInfo> &contents = _contents[instance.vkDescriptorSet];
+        if (isSameContents(gpuDescriptorSet, contents, instance.descriptorInfos)) {
+            return;
+        }
+        contents = instance.descriptorInfos;
+
         if (gpuDescriptorSet->gpuLayout->vkDescriptorUpdateTemplate) {
             _updateFn(_device->vkDevice, instance.vkDescriptorSet,
                       gpuDescriptorSet->gpuLayout->vkDescriptorUpdateTemplate, instance.descriptorInfos.data());
@@ -845,11 +864,36 @@ private:
         }
     }
 
+    // only the union member in use is compared, the others hold stale bytes
+    static bool isSameContents(const CCVKGPUDescriptorSet *gpuDescriptorSet, const vector<CCVKDescriptorInfo> &lhs, const vector<CCVKDescriptorInfo> &rhs) {
+        if (lhs.size() != rhs.size()) return false;
+        for (size_t i = 0U; i < lhs.size(); ++i) {
+            const DescriptorType type = gpuDescriptorSet->gpuDescriptors[i].type;
+            if (hasFlag(DESCRIPTOR_BUFFER_TYPE, type)) {
+                if (lhs[i].buffer.buffer != rhs[i].buffer.buffer || lhs[i].buffer.offset != rhs[i].buffer.offset ||
+                    lhs[i].buffer.range != rhs[i].buffer.range) {
+                    return false;
+                }
+            } else if (hasFlag(DESCRIPTOR_TEXTURE_TYPE, type)) {
+                if (lhs[i].image.sampler != rhs[i].image.sampler || lhs[i].image.imageView != rhs[i].image.imageView ||
+                    lhs[i].image.imageLayout != rhs[i].image.imageLayout) {
+                    return false;
+                }
+            } else if (lhs[i].texelBufferView != rhs[i].texelBufferView) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     using DescriptorSetList = unordered_set<const CCVKGPUDescriptorSet *>;
 
     CCVKGPUDevice *                       _device = nullptr;
     vector<DescriptorSetList>             _setsToBeUpdated;
     PFN_vkUpdateDescriptorSetWithTemplate _updateFn = nullptr;
+
+    // last written contents of each descriptor set
+    unordered_map<VkDescriptorSet, vector<CCVKDescriptorInfo>> _contents;
 };
 
 /**
@@ -874,8 +918,9 @@ public:
         _textures[texture].sets.insert(set);
         _textures[texture].descriptors.push(descriptor);
     }
-    void connect(const CCVKGPUSampler *sampler, VkDescriptorImageInfo *descriptor) {
-        _samplers[sampler].push(descriptor);
+    void connect(const CCVKGPUDescriptorSet *set, const CCVKGPUSampler *sampler, VkDescriptorImageInfo *descriptor) {
+        _samplers[sampler].sets.insert(set);
+        _samplers[sampler].descriptors.push(descriptor);
     }
 
     void update(const CCVKGPUBufferView *buffer) {
@@ -886,7 +931,7 @@ public:
                 doUpdate(buffer, info.descriptors[i]);
             }
             for (const auto *set : info.sets) {
-                _descriptorSetHub->record(set);
+                _descriptorSetHub->record(set, true);
             }
         }
     }
@@ -909,7 +954,7 @@ public:
                 doUpdate(texture, info.descriptors[i]);
             }
             for (const auto *set : info.sets) {
-                _descriptorSetHub->record(set);
+                _descriptorSetHub->record(set, true);
             }
         }
     }
@@ -927,7 +972,7 @@ public:
     void update(const CCVKGPUSampler *sampler, VkDescriptorImageInfo *descriptor) {
         auto it = _samplers.find(sampler);
         if (it == _samplers.end()) return;
-        auto &descriptors = it->second;
+        auto &descriptors = it->second.descriptors;
         for (uint i = 0U; i < descriptors.size(); ++i) {
             if (descriptors[i] == descriptor) {
                 doUpdate(sampler, descriptor);
@@ -945,17 +990,20 @@ public:
                 info.descriptors[i]->offset += buffer->startOffset - oldStartOffset;
             }
             for (const auto *set : info.sets) {
-                _descriptorSetHub->record(set);
+                _descriptorSetHub->record(set, true);
             }
         }
     }
 
+    // the resource is destroyed: sets still referring to it must be rewritten,
+    // as a new resource may be created with the same handle
     void disengage(const CCVKGPUBufferView *buffer) {
         auto it = _buffers.find(buffer);
         if (it == _buffers.end()) return;
         for (uint i = 0; i < it->second.descriptors.size(); ++i) {
             _bufferInstanceIndices.erase(it->second.descriptors[i]);
         }
+        invalidate(it->second.sets);
         _buffers.erase(it);
     }
     void disengage(const CCVKGPUBufferView *buffer, VkDescriptorBufferInfo *descriptor) {
@@ -968,6 +1016,7 @@ public:
     void disengage(const CCVKGPUTextureView *texture) {
         auto it = _textures.find(texture);
         if (it == _textures.end()) return;
+        invalidate(it->second.sets);
         _textures.erase(it);
     }
     void disengage(const CCVKGPUTextureView *texture, VkDescriptorImageInfo *descriptor) {
@@ -979,15 +1028,33 @@ public:
     void disengage(const CCVKGPUSampler *sampler) {
         auto it = _samplers.find(sampler);
         if (it == _samplers.end()) return;
+        invalidate(it->second.sets);
         _samplers.erase(it);
     }
     void disengage(const CCVKGPUSampler *sampler, VkDescriptorImageInfo *descriptor) {
         auto it = _samplers.find(sampler);
         if (it == _samplers.end()) return;
-        auto &descriptors = it->second;
+        auto &descriptors = it->second.descriptors;
         descriptors.fastRemove(descriptors.indexOf(descriptor));
     }
 
+    // the set is destroyed, stop tracking it so resource events don't reach it any more
+    void disengage(const CCVKGPUDescriptorSet *set, const CCVKGPUBufferView *buffer, VkDescriptorBufferInfo *descriptor) {
+        disengage(buffer, descriptor);
+        auto it = _buffers.find(buffer);
+        if (it != _buffers.end()) it->second.sets.erase(set);
+    }
+    void disengage(const CCVKGPUDescriptorSet *set, const CCVKGPUTextureView *texture, VkDescriptorImageInfo *descriptor) {
+        disengage(texture, descriptor);
+        auto it = _textures.find(texture);
+        if (it != _textures.end()) it->second.sets.erase(set);
+    }
+    void disengage(const CCVKGPUDescriptorSet *set, const CCVKGPUSampler *sampler, VkDescriptorImageInfo *descriptor) {
+        disengage(sampler, descriptor);
+        auto it = _samplers.find(sampler);
+        if (it != _samplers.end()) it->second.sets.erase(set);
+    }
+
 private:
     void doUpdate(const CCVKGPUBufferView *buffer, VkDescriptorBufferInfo *descriptor) {
         VkDeviceSize instanceOffset = _bufferInstanceIndices[descriptor] * buffer->gpuBuffer->instanceSize;
@@ -1009,6 +1076,12 @@ private:
         descriptor->sampler = sampler->vkSampler;
     }
 
+    void invalidate(const unordered_set<const CCVKGPUDescriptorSet *> &sets) {
+        for (const auto *set : sets) {
+            _descriptorSetHub->invalidate(set);
+        }
+    }
+
     template <typename T>
     struct DescriptorInfo {
         unordered_set<const CCVKGPUDescriptorSet *> sets;
@@ -1018,7 +1091,7 @@ private:
     unordered_map<const VkDescriptorBufferInfo *, uint>                              _bufferInstanceIndices;
     unordered_map<const CCVKGPUBufferView *, DescriptorInfo<VkDescriptorBufferInfo>> _buffers;
     unordered_map<const CCVKGPUTextureView *, DescriptorInfo<VkDescriptorImageInfo>> _textures;
-    unordered_map<const CCVKGPUSampler *, CachedArray<VkDescriptorImageInfo *>>      _samplers;
+    unordered_map<const CCVKGPUSampler *, DescriptorInfo<VkDescriptorImageInfo>>     _samplers;
 
     CCVKGPUDescriptorSetHub *_descriptorSetHub = nullptr;
 };
@@ -1255,5 +1328,33 @@ private:
     CCVKGPUDevice *_device = nullptr;
 };
 
+/**
+ * Persists the driver pipeline cache to writable storage across launches.
+ */
+class CCVKGPUPipelineCache final : public Object {
+public:
+    explicit CCVKGPUPipelineCache(CCVKGPUDevice *device, const VkPhysicalDeviceProperties &properties)
+    : _device(device),
+      _properties(properties) {}
+
+    // creates the device pipeline cache, seeded with the saved blob if it was produced by the same device and driver
+    void init();
+    // saves periodically, only if new pipelines were added since the last save
+    void update();
+    void save();
+    void destroy();
+
+    inline void setDirty() { _dirty = true; }
+
+private:
+    bool validate(const uint8_t *data, size_t size) const;
+
+    CCVKGPUDevice *            _device = nullptr;
+    VkPhysicalDeviceProperties _properties{};
+    String                     _path;
+    uint                       _framesSinceSave = 0U;
+    bool                       _dirty           = false;
+};
+
 } // namespace gfx
 } // namespace cc
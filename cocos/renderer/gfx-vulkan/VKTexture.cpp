@@ -56,7 +56,7 @@ void CCVKTexture::doInit(const TextureInfo & /*info*/) {
     cmdFuncCCVKCreateTexture(CCVKDevice::getInstance(), _gpuTexture);
 
     if (!_gpuTexture->memoryless) {
-        CCVKDevice::getInstance()->getMemoryStatus().textureSize += _size;
+        CCVKDevice::getInstance()->getMemoryTracker().allocate(this, _size);
     }
 
     _gpuTextureView = CC_NEW(CCVKGPUTextureView);
@@ -92,7 +92,7 @@ void CCVKTexture::doDestroy() {
     if (_gpuTexture) {
         if (!_isTextureView) {
             if (!_gpuTexture->memoryless) {
-                CCVKDevice::getInstance()->getMemoryStatus().textureSize -= _size;
+                CCVKDevice::getInstance()->getMemoryTracker().release(this, _size);
             }
             CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuTexture);
             CCVKDevice::getInstance()->gpuBarrierManager()->cancel(_gpuTexture);
@@ -104,7 +104,7 @@ void CCVKTexture::doDestroy() {
 
 void CCVKTexture::doResize(uint width, uint height, uint size) {
     if (!_gpuTexture->memoryless) {
-        CCVKDevice::getInstance()->getMemoryStatus().textureSize -= _size;
+        CCVKDevice::getInstance()->getMemoryTracker().release(this, _size);
     }
 
     CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuTextureView);
@@ -116,7 +116,7 @@ void CCVKTexture::doResize(uint width, uint height, uint size) {
     cmdFuncCCVKCreateTexture(CCVKDevice::getInstance(), _gpuTexture);
 
     if (!_gpuTexture->memoryless) {
-        CCVKDevice::getInstance()->getMemoryStatus().textureSize += size;
+        CCVKDevice::getInstance()->getMemoryTracker().allocate(this, size);
     }
 
     cmdFuncCCVKCreateTextureView(CCVKDevice::getInstance(), _gpuTextureView);
@@ -138,7 +138,7 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint passIdx, const s
 
                 // update world matrix
                 const auto  offset      = UBOLocalBatched::MAT_WORLDS_OFFSET + batch.mergeCount * 16;
-                const auto &worldMatrix = model->getTransform()->getWorldMatrix();
+                const auto &worldMatrix = model->getWorldMatrix();
                 memcpy(batch.uboData.data() + offset, worldMatrix.m, sizeof(worldMatrix));
 
                 if (!batch.mergeCount) {
@@ -214,7 +214,7 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint passIdx, const s
     descriptorSet->update();
 
     std::array<float, UBOLocalBatched::COUNT> uboData;
-    const auto &                              worldMatrix = model->getTransform()->getWorldMatrix();
+    const auto &                              worldMatrix = model->getWorldMatrix();
     memcpy(uboData.data() + UBOLocalBatched::MAT_WORLDS_OFFSET, worldMatrix.m, sizeof(worldMatrix));
     BatchedItem item = {
         std::move(vbs),                  //vbs
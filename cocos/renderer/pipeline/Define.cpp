@@ -387,6 +387,86 @@ const gfx::UniformSamplerTexture SPOTLIGHTINGMAP::LAYOUT = {
     1,
 };
 
+const String                          CLUSTERLIGHTS::NAME       = "cc_clusterLights";
+const gfx::DescriptorSetLayoutBinding CLUSTERLIGHTS::DESCRIPTOR = {
+    CLUSTERLIGHTS::BINDING,
+    gfx::DescriptorType::SAMPLER_TEXTURE,
+    1,
+    gfx::ShaderStageFlagBit::FRAGMENT,
+    {},
+};
+const gfx::UniformSamplerTexture CLUSTERLIGHTS::LAYOUT = {
+    globalSet,
+    CLUSTERLIGHTS::BINDING,
+    CLUSTERLIGHTS::NAME,
+    gfx::Type::SAMPLER2D,
+    1,
+};
+
+const String                          CLUSTERLIGHTGRID::NAME       = "cc_clusterLightGrid";
+const gfx::DescriptorSetLayoutBinding CLUSTERLIGHTGRID::DESCRIPTOR = {
+    CLUSTERLIGHTGRID::BINDING,
+    gfx::DescriptorType::SAMPLER_TEXTURE,
+    1,
+    gfx::ShaderStageFlagBit::FRAGMENT,
+    {},
+};
+const gfx::UniformSamplerTexture CLUSTERLIGHTGRID::LAYOUT = {
+    globalSet,
+    CLUSTERLIGHTGRID::BINDING,
+    CLUSTERLIGHTGRID::NAME,
+    gfx::Type::SAMPLER2D,
+    1,
+};
+
+const String                          CLUSTERLIGHTINDICES::NAME       = "cc_clusterLightIndices";
+const gfx::DescriptorSetLayoutBinding CLUSTERLIGHTINDICES::DESCRIPTOR = {
+    CLUSTERLIGHTINDICES::BINDING,
+    gfx::DescriptorType::SAMPLER_TEXTURE,
+    1,
+    gfx::ShaderStageFlagBit::FRAGMENT,
+    {},
+};
+const gfx::UniformSamplerTexture CLUSTERLIGHTINDICES::LAYOUT = {
+    globalSet,
+    CLUSTERLIGHTINDICES::BINDING,
+    CLUSTERLIGHTINDICES::NAME,
+    gfx::Type::SAMPLER2D,
+    1,
+};
+
+const String                          TILEDLIGHTGRID::NAME       = "cc_tiledLightGrid";
+const gfx::DescriptorSetLayoutBinding TILEDLIGHTGRID::DESCRIPTOR = {
+    TILEDLIGHTGRID::BINDING,
+    gfx::DescriptorType::SAMPLER_TEXTURE,
+    1,
+    gfx::ShaderStageFlagBit::FRAGMENT,
+    {},
+};
+const gfx::UniformSamplerTexture TILEDLIGHTGRID::LAYOUT = {
+    globalSet,
+    TILEDLIGHTGRID::BINDING,
+    TILEDLIGHTGRID::NAME,
+    gfx::Type::SAMPLER2D,
+    1,
+};
+
+const String                          TILEDLIGHTINDICES::NAME       = "cc_tiledLightIndices";
+const gfx::DescriptorSetLayoutBinding TILEDLIGHTINDICES::DESCRIPTOR = {
+    TILEDLIGHTINDICES::BINDING,
+    gfx::DescriptorType::SAMPLER_TEXTURE,
+    1,
+    gfx::ShaderStageFlagBit::FRAGMENT,
+    {},
+};
+const gfx::UniformSamplerTexture TILEDLIGHTINDICES::LAYOUT = {
+    globalSet,
+    TILEDLIGHTINDICES::BINDING,
+    TILEDLIGHTINDICES::NAME,
+    gfx::Type::SAMPLER2D,
+    1,
+};
+
 const String                          JOINTTEXTURE::NAME       = "cc_jointTexture";
 const gfx::DescriptorSetLayoutBinding JOINTTEXTURE::DESCRIPTOR = {
     JOINTTEXTURE::BINDING,
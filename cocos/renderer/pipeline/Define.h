@@ -29,6 +29,7 @@
 
 #include "base/Object.h"
 #include "base/Value.h"
+#include "base/memory/FrameArena.h"
 #include "gfx-base/GFXDef-common.h"
 #include "renderer/gfx-base/GFXDef.h"
 #include "scene/Light.h"
@@ -59,7 +60,8 @@ struct CC_DLL RenderObject {
     float               depth = 0;
     const scene::Model *model = nullptr;
 };
-using RenderObjectList = vector<struct RenderObject>;
+// rebuilt by every culling pass, so it lives in the frame arena
+using RenderObjectList = FrameVector<struct RenderObject>;
 
 struct CC_DLL RenderTargetInfo {
     uint width  = 0;
@@ -67,11 +69,11 @@ struct CC_DLL RenderTargetInfo {
 };
 
 struct CC_DLL RenderPass {
-    uint                   hash      = 0;
-    float                  depth     = 0;
-    uint                   shaderID  = 0;
-    uint                   passIndex = 0;
-    const scene::SubModel *subModel  = nullptr;
+    uint             hash      = 0;
+    float            depth     = 0;
+    uint             shaderID  = 0;
+    uint             passIndex = 0;
+    scene::SubModel *subModel  = nullptr;
 };
 using RenderPassList = vector<RenderPass>;
 
@@ -223,6 +225,13 @@ enum class CC_DLL PipelineGlobalBindings {
     SAMPLER_GBUFFER_EMISSIVEMAP,
     SAMPLER_LIGHTING_RESULTMAP,
 
+    // optional, only part of the global layout while the pipeline feature using them is on, see GlobalDSManager
+    SAMPLER_CLUSTER_LIGHTS,
+    SAMPLER_CLUSTER_LIGHT_GRID,
+    SAMPLER_CLUSTER_LIGHT_INDICES,
+    SAMPLER_TILED_LIGHT_GRID,
+    SAMPLER_TILED_LIGHT_INDICES,
+
     COUNT,
 };
 
@@ -303,7 +312,9 @@ struct CC_DLL UBOForwardLight {
 };
 
 struct CC_DLL UBODeferredLight {
-    static constexpr uint LIGHTS_PER_PASS = 10;
+    static constexpr uint LIGHTS_PER_PASS     = 10;
+    static constexpr uint TILE_SIZE           = 16; // pixels per screen tile side, tiles are counted from NDC (-1, -1)
+    static constexpr uint INDEX_TEXTURE_WIDTH = 256;
 };
 
 struct CC_DLL UBOSkinningTexture {
@@ -435,6 +446,23 @@ struct CC_DLL UBOShadow : public Object {
     static const String                          NAME;
 };
 
+// clustered forward lighting:
+// the view frustum is split into CLUSTERS_X * CLUSTERS_Y screen tiles, counted from NDC (-1, -1),
+// and CLUSTERS_Z exponential depth slices, slice = floor(log(-viewZ) * scale + bias)
+struct CC_DLL ForwardCluster : public Object {
+    static constexpr uint CLUSTERS_X          = 16;
+    static constexpr uint CLUSTERS_Y          = 9;
+    static constexpr uint CLUSTERS_Z          = 24;
+    static constexpr uint CLUSTER_COUNT       = CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z;
+    static constexpr uint LIGHT_TEXELS        = 4; // position, color, size-range-angle, direction
+    static constexpr uint INDEX_TEXTURE_WIDTH = 1024;
+    // the grid parameters are stored in one extra row of cc_clusterLightGrid, one vec4 per texel
+    static constexpr uint PARAMS_ROW             = CLUSTERS_Z;
+    static constexpr uint PARAMS_SIZE_TEXEL      = 0; // x, y, z, light count
+    static constexpr uint PARAMS_Z_TEXEL         = 1; // near, far, scale, bias
+    static constexpr uint PARAMS_TILE_SIZE_TEXEL = 2; // tile width, tile height, index texture width, unused
+};
+
 class CC_DLL SamplerLib : public Object {
 public:
     static gfx::Sampler *getSampler(uint hash);
@@ -537,6 +565,41 @@ struct CC_DLL SPOTLIGHTINGMAP : public Object {
     static const String                          NAME;
 };
 
+struct CC_DLL CLUSTERLIGHTS : public Object {
+    static constexpr uint                        BINDING = static_cast<uint>(PipelineGlobalBindings::SAMPLER_CLUSTER_LIGHTS);
+    static const gfx::DescriptorSetLayoutBinding DESCRIPTOR;
+    static const gfx::UniformSamplerTexture      LAYOUT;
+    static const String                          NAME;
+};
+
+struct CC_DLL CLUSTERLIGHTGRID : public Object {
+    static constexpr uint                        BINDING = static_cast<uint>(PipelineGlobalBindings::SAMPLER_CLUSTER_LIGHT_GRID);
+    static const gfx::DescriptorSetLayoutBinding DESCRIPTOR;
+    static const gfx::UniformSamplerTexture      LAYOUT;
+    static const String                          NAME;
+};
+
+struct CC_DLL CLUSTERLIGHTINDICES : public Object {
+    static constexpr uint                        BINDING = static_cast<uint>(PipelineGlobalBindings::SAMPLER_CLUSTER_LIGHT_INDICES);
+    static const gfx::DescriptorSetLayoutBinding DESCRIPTOR;
+    static const gfx::UniformSamplerTexture      LAYOUT;
+    static const String                          NAME;
+};
+
+struct CC_DLL TILEDLIGHTGRID : public Object {
+    static constexpr uint                        BINDING = static_cast<uint>(PipelineGlobalBindings::SAMPLER_TILED_LIGHT_GRID);
+    static const gfx::DescriptorSetLayoutBinding DESCRIPTOR;
+    static const gfx::UniformSamplerTexture      LAYOUT;
+    static const String                          NAME;
+};
+
+struct CC_DLL TILEDLIGHTINDICES : public Object {
+    static constexpr uint                        BINDING = static_cast<uint>(PipelineGlobalBindings::SAMPLER_TILED_LIGHT_INDICES);
+    static const gfx::DescriptorSetLayoutBinding DESCRIPTOR;
+    static const gfx::UniformSamplerTexture      LAYOUT;
+    static const String                          NAME;
+};
+
 struct CC_DLL JOINTTEXTURE : public Object {
     static constexpr uint                        BINDING = static_cast<uint>(ModelLocalBindings::SAMPLER_JOINTS);
     static const gfx::DescriptorSetLayoutBinding DESCRIPTOR;
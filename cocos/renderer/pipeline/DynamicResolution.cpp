@@ -0,0 +1,114 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cc {
+namespace pipeline {
+namespace {
+constexpr float FRAME_TIME_SMOOTHING = 0.1F;
+// Frames over budget by more than this fraction lower the scale, frames under budget by more than
+// the (larger) upscale margin raise it, so the scale settles instead of oscillating around the target.
+constexpr float DOWNSCALE_MARGIN = 0.05F;
+constexpr float UPSCALE_MARGIN   = 0.15F;
+constexpr float MAX_DOWNSCALE    = 0.1F;
+constexpr float MAX_UPSCALE      = 0.05F;
+// Frames to wait after a change so that the smoothed frame time reflects the new scale
+constexpr uint COOLDOWN_FRAMES = 8;
+// Under vsync the frame interval never drops below the display period, so a smoothed frame time this close to
+// the target gives no measure of headroom. After PROBE_FRAMES such frames the scale is probed one step up, a
+// probe that is followed by a downscale within PROBE_FAILURE_FRAMES doubles the wait before the next one.
+constexpr float VSYNC_TOLERANCE      = 0.02F;
+constexpr uint  PROBE_FRAMES         = 30;
+constexpr uint  MAX_PROBE_BACKOFF    = 4;
+constexpr uint  PROBE_FAILURE_FRAMES = COOLDOWN_FRAMES * 2;
+} // namespace
+
+float DynamicResolution::update(float frameTime) {
+    if (frameTime <= 0.F) {
+        return _scale;
+    }
+
+    _averageFrameTime = _averageFrameTime > 0.F ? _averageFrameTime + (frameTime - _averageFrameTime) * FRAME_TIME_SMOOTHING : frameTime;
+    if (_probeAge > 0 && ++_probeAge > PROBE_FAILURE_FRAMES) {
+        _probeAge     = 0;
+        _probeBackoff = 0;
+    }
+    if (_cooldown > 0) {
+        --_cooldown;
+        return _scale;
+    }
+
+    // shading cost is roughly proportional to the pixel count, i.e. the square of the scale
+    const float ratio = _targetFrameTime / _averageFrameTime;
+    float       scale = _scale;
+    if (ratio < 1.F - DOWNSCALE_MARGIN) {
+        scale *= std::max(std::sqrt(ratio), 1.F - MAX_DOWNSCALE);
+        if (_probeAge > 0) {
+            _probeAge     = 0;
+            _probeBackoff = std::min(_probeBackoff + 1, MAX_PROBE_BACKOFF);
+        }
+        _pinnedFrames = 0;
+    } else if (ratio > 1.F + UPSCALE_MARGIN) {
+        scale *= std::min(std::sqrt(ratio), 1.F + MAX_UPSCALE);
+        _pinnedFrames = 0;
+    } else if (_scale < _maxScale && std::abs(ratio - 1.F) <= VSYNC_TOLERANCE) {
+        if (++_pinnedFrames >= PROBE_FRAMES << _probeBackoff) {
+            scale *= 1.F + MAX_UPSCALE;
+            _pinnedFrames = 0;
+            _probeAge     = 1;
+        }
+    } else {
+        _pinnedFrames = 0;
+    }
+    scale = std::clamp(scale, _minScale, _maxScale);
+
+    if (scale != _scale) {
+        _scale    = scale;
+        _cooldown = COOLDOWN_FRAMES;
+    }
+    return _scale;
+}
+
+void DynamicResolution::reset(float scale) {
+    _scale            = std::clamp(scale, _minScale, _maxScale);
+    _averageFrameTime = 0.F;
+    _cooldown         = 0;
+    _pinnedFrames     = 0;
+    _probeBackoff     = 0;
+    _probeAge         = 0;
+}
+
+void DynamicResolution::setScaleRange(float minScale, float maxScale) {
+    _minScale = std::max(minScale, 0.1F);
+    _maxScale = std::max(maxScale, _minScale);
+    _scale    = std::clamp(_scale, _minScale, _maxScale);
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,66 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/TypeDef.h"
+
+namespace cc {
+namespace pipeline {
+
+// Frame time driven shading scale controller.
+// Fed with the measured frame time once per frame, it lowers the scale when frames run over the target and raises it
+// again when there is headroom. Frame times pinned to the target, as under vsync, are treated as possible headroom
+// and probed upwards now and then. The pipeline renders its scene passes at the returned scale and upscales when presenting.
+class CC_DLL DynamicResolution {
+public:
+    float update(float frameTime);
+    void  reset(float scale);
+
+    inline float getScale() const { return _scale; }
+    inline float getAverageFrameTime() const { return _averageFrameTime; }
+
+    inline float getTargetFrameTime() const { return _targetFrameTime; }
+    inline void  setTargetFrameTime(float seconds) { _targetFrameTime = seconds; }
+
+    inline float getMinScale() const { return _minScale; }
+    inline float getMaxScale() const { return _maxScale; }
+    void         setScaleRange(float minScale, float maxScale);
+
+private:
+    float _targetFrameTime{1.0F / 60.0F};
+    float _minScale{0.5F};
+    float _maxScale{1.0F};
+    float _scale{1.0F};
+    float _averageFrameTime{0.F};
+    uint  _cooldown{0};
+    uint  _pinnedFrames{0};
+    uint  _probeBackoff{0};
+    uint  _probeAge{0};
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -44,6 +44,13 @@ namespace pipeline {
         globalDescriptorSetLayout.bindings[info::BINDING] = info::DESCRIPTOR; \
     } while (0)
 
+// optional bindings are not indexed by binding, they only exist while their feature is on
+#define ADD_OPTIONAL_GLOBAL_DESCSET_LAYOUT(info)                            \
+    do {                                                                    \
+        globalDescriptorSetLayout.samplers[info::NAME] = info::LAYOUT;      \
+        globalDescriptorSetLayout.bindings.emplace_back(info::DESCRIPTOR); \
+    } while (0)
+
 void GlobalDSManager::activate(gfx::Device *device, RenderPipeline *pipeline) {
     _device   = device;
     _pipeline = pipeline;
@@ -79,6 +86,16 @@ void GlobalDSManager::activate(gfx::Device *device, RenderPipeline *pipeline) {
     _pointSampler        = SamplerLib::getSampler(pointHash);
 
     setDescriptorSetLayout();
+    if (_clusterLightBindings) {
+        ADD_OPTIONAL_GLOBAL_DESCSET_LAYOUT(CLUSTERLIGHTS);
+        ADD_OPTIONAL_GLOBAL_DESCSET_LAYOUT(CLUSTERLIGHTGRID);
+        ADD_OPTIONAL_GLOBAL_DESCSET_LAYOUT(CLUSTERLIGHTINDICES);
+    }
+    if (_tiledLightBindings) {
+        ADD_OPTIONAL_GLOBAL_DESCSET_LAYOUT(TILEDLIGHTGRID);
+        ADD_OPTIONAL_GLOBAL_DESCSET_LAYOUT(TILEDLIGHTINDICES);
+    }
+
     if (_descriptorSetLayout) {
         _descriptorSetLayout->destroy();
         CC_DELETE(_descriptorSetLayout);
@@ -170,7 +187,9 @@ void GlobalDSManager::destroy() {
 }
 
 void GlobalDSManager::setDescriptorSetLayout() {
-    globalDescriptorSetLayout.bindings.resize(static_cast<size_t>(PipelineGlobalBindings::COUNT));
+    globalDescriptorSetLayout.blocks.clear();
+    globalDescriptorSetLayout.samplers.clear();
+    globalDescriptorSetLayout.bindings.resize(static_cast<size_t>(PipelineGlobalBindings::SAMPLER_CLUSTER_LIGHTS));
 
     globalDescriptorSetLayout.blocks[UBOGlobal::NAME]            = UBOGlobal::LAYOUT;
     globalDescriptorSetLayout.bindings[UBOGlobal::BINDING]       = UBOGlobal::DESCRIPTOR;
@@ -50,6 +50,10 @@ public:
     inline gfx::DescriptorSetLayout *                     getDescriptorSetLayout() const { return _descriptorSetLayout; }
     inline gfx::DescriptorSet *                           getGlobalDescriptorSet() const { return _globalDescriptorSet; }
 
+    // the optional bindings at the end of PipelineGlobalBindings have to be requested before activate()
+    inline void setClusterLightBindings(bool enabled) { _clusterLightBindings = enabled; }
+    inline void setTiledLightBindings(bool enabled) { _tiledLightBindings = enabled; }
+
     void                activate(gfx::Device *device, RenderPipeline *pipeline);
     void                bindBuffer(uint binding, gfx::Buffer *buffer);
     void                bindTexture(uint binding, gfx::Texture *texture);
@@ -69,6 +73,8 @@ private:
     gfx::DescriptorSetLayout *                     _descriptorSetLayout = nullptr;
     gfx::DescriptorSet *                           _globalDescriptorSet = nullptr;
     std::unordered_map<uint, gfx::DescriptorSet *> _descriptorSetMap{};
+    bool                                           _clusterLightBindings = false;
+    bool                                           _tiledLightBindings   = false;
 };
 
 } // namespace pipeline
@@ -34,16 +34,37 @@ unordered_map<uint, SharedPtr<gfx::PipelineState>> PipelineStateManager::psoHash
 gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::Pass *  pass,
                                                                    gfx::Shader *        shader,
                                                                    gfx::InputAssembler *inputAssembler,
-                                                                   gfx::RenderPass *    renderPass) {
+                                                                   gfx::RenderPass *    renderPass,
+                                                                   PipelineStateVariant variant) {
     const auto passHash       = pass->getHash();
     const auto renderPassHash = renderPass->getHash();
     const auto iaHash         = inputAssembler->getAttributesHash();
     const auto shaderID       = shader->getTypedID();
-    const auto hash           = passHash ^ renderPassHash ^ iaHash ^ shaderID;
+    auto       hash           = passHash ^ renderPassHash ^ iaHash ^ shaderID;
+    if (variant != PipelineStateVariant::DEFAULT) {
+        hash = hash * 31U + static_cast<uint>(variant);
+    }
 
     auto *pso = psoHashMap[hash].get();
     if (!pso) {
-        auto *pipelineLayout = pass->getPipelineLayout();
+        auto *pipelineLayout    = pass->getPipelineLayout();
+        auto  depthStencilState = *(pass->getDepthStencilState());
+        auto  blendState        = *(pass->getBlendState());
+
+        switch (variant) {
+            case PipelineStateVariant::DEPTH_ONLY:
+                for (auto &target : blendState.targets) {
+                    target.blend          = 0;
+                    target.blendColorMask = gfx::ColorMask::NONE;
+                }
+                break;
+            case PipelineStateVariant::DEPTH_EQUAL:
+                depthStencilState.depthFunc  = gfx::ComparisonFunc::EQUAL;
+                depthStencilState.depthWrite = 0;
+                break;
+            default:
+                break;
+        }
 
         pso = gfx::Device::getInstance()->createPipelineState({
             shader,
@@ -51,8 +72,8 @@ gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::
             renderPass,
             {inputAssembler->getAttributes()},
             *(pass->getRasterizerState()),
-            *(pass->getDepthStencilState()),
-            *(pass->getBlendState()),
+            depthStencilState,
+            blendState,
             pass->getPrimitive(),
             pass->getDynamicStates(),
         });
@@ -31,12 +31,19 @@
 namespace cc {
 namespace pipeline {
 
+enum class PipelineStateVariant {
+    DEFAULT,
+    DEPTH_ONLY,  // color writes masked off, used by the depth pre-pass
+    DEPTH_EQUAL, // depth test EQUAL without depth writes, used after the depth pre-pass
+};
+
 class CC_DLL PipelineStateManager {
 public:
     static gfx::PipelineState *getOrCreatePipelineState(const scene::Pass *  pass,
                                                         gfx::Shader *        shader,
                                                         gfx::InputAssembler *inputAssembler,
-                                                        gfx::RenderPass *    renderPass);
+                                                        gfx::RenderPass *    renderPass,
+                                                        PipelineStateVariant variant = PipelineStateVariant::DEFAULT);
     static void                destroyAll();
 
 private:
@@ -144,7 +144,7 @@ void PipelineUBO::updateCameraUBOView(const RenderPipeline *pipeline, float *out
     //    }
 
     memcpy(output + UBOCamera::MAT_VIEW_OFFSET, camera->getMatView().m, sizeof(cc::Mat4));
-    memcpy(output + UBOCamera::MAT_VIEW_INV_OFFSET, camera->getNode()->getWorldMatrix().m, sizeof(cc::Mat4));
+    memcpy(output + UBOCamera::MAT_VIEW_INV_OFFSET, camera->getMatViewInv().m, sizeof(cc::Mat4));
     TO_VEC3(output, camera->getPosition(), UBOCamera::CAMERA_POS_OFFSET);
 
     memcpy(output + UBOCamera::MAT_PROJ_OFFSET, camera->getMatProj().m, sizeof(cc::Mat4));
@@ -180,8 +180,7 @@ void PipelineUBO::updateShadowUBOView(const RenderPipeline *pipeline, std::array
 
     if (shadow->isEnabled()) {
         if (mainLight && shadow->getType() == scene::ShadowType::SHADOW_MAP) {
-            auto *const node = mainLight->getNode();
-            cc::Mat4    matShadowCamera;
+            cc::Mat4 matShadowCamera;
 
             // light proj
             float x;
@@ -189,7 +188,7 @@ void PipelineUBO::updateShadowUBOView(const RenderPipeline *pipeline, std::array
             float farClamp;
             if (shadow->isAutoAdapt()) {
                 Vec3 tmpCenter;
-                getShadowWorldMatrix(sphere, node->getWorldRotation(), mainLight->getDirection(), &matShadowCamera, &tmpCenter);
+                getShadowWorldMatrix(sphere, mainLight->getWorldRotation(), mainLight->getDirection(), &matShadowCamera, &tmpCenter);
 
                 const float radius = sphere->getRadius();
                 x                  = radius;
@@ -198,7 +197,7 @@ void PipelineUBO::updateShadowUBOView(const RenderPipeline *pipeline, std::array
                 const float halfFar = tmpCenter.distance(sphere->getCenter());
                 farClamp            = std::min(halfFar * COEFFICIENT_OF_EXPANSION, SHADOW_CAMERA_MAX_FAR);
             } else {
-                matShadowCamera = mainLight->getNode()->getWorldMatrix();
+                matShadowCamera = mainLight->getWorldMatrix();
 
                 x = y    = shadow->getOrthoSize();
                 farClamp = shadow->getFar();
@@ -251,7 +250,7 @@ void PipelineUBO::updateShadowUBOLightView(const RenderPipeline *pipeline, std::
             float farClamp;
             if (shadow->isAutoAdapt()) {
                 Vec3 tmpCenter;
-                getShadowWorldMatrix(sphere, directionalLight->getNode()->getWorldRotation(), directionalLight->getDirection(), &matShadowCamera, &tmpCenter);
+                getShadowWorldMatrix(sphere, directionalLight->getWorldRotation(), directionalLight->getDirection(), &matShadowCamera, &tmpCenter);
 
                 const auto radius = sphere->getRadius();
                 x                 = radius;
@@ -260,7 +259,7 @@ void PipelineUBO::updateShadowUBOLightView(const RenderPipeline *pipeline, std::
                 const float halfFar = tmpCenter.distance(sphere->getCenter());
                 farClamp            = std::min(halfFar * COEFFICIENT_OF_EXPANSION, SHADOW_CAMERA_MAX_FAR);
             } else {
-                matShadowCamera = light->getNode()->getWorldMatrix();
+                matShadowCamera = light->getWorldMatrix();
 
                 x = y    = shadow->getOrthoSize();
                 farClamp = shadow->getFar();
@@ -282,7 +281,7 @@ void PipelineUBO::updateShadowUBOLightView(const RenderPipeline *pipeline, std::
         } break;
         case scene::LightType::SPOT: {
             const auto *spotLight       = static_cast<const scene::SpotLight *>(light);
-            const auto &matShadowCamera = spotLight->getNode()->getWorldMatrix();
+            const auto &matShadowCamera = spotLight->getWorldMatrix();
             memcpy(shadowUBO.data() + UBOShadow::MAT_LIGHT_VIEW_OFFSET, matShadowCamera.m, sizeof(matShadowCamera));
 
             const auto matShadowView = matShadowCamera.getInversed();
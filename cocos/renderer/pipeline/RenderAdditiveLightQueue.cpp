@@ -87,7 +87,7 @@ void RenderAdditiveLightQueue::recordCommandBuffer(gfx::Device *device, gfx::Ren
         const auto *      pass           = lightPass.pass;
         const auto &      dynamicOffsets = lightPass.dynamicOffsets;
         auto *            shader         = lightPass.shader;
-        const auto        lights         = lightPass.lights;
+        const auto &      lights         = lightPass.lights;
         auto *            ia             = subModel->getInputAssembler();
         auto *            pso            = PipelineStateManager::getOrCreatePipelineState(pass, shader, ia, renderPass);
         auto *            descriptorSet  = subModel->getDescriptorSet();
@@ -163,11 +163,6 @@ void RenderAdditiveLightQueue::clear() {
     _instancedQueue->clear();
     _batchedQueue->clear();
     _validLights.clear();
-
-    for (auto lightPass : _lightPasses) {
-        lightPass.dynamicOffsets.clear();
-        lightPass.lights.clear();
-    }
     _lightPasses.clear();
 }
 
@@ -223,6 +218,7 @@ void RenderAdditiveLightQueue::addRenderQueue(const scene::Pass *pass, const sce
         lightPass.pass     = pass;
         lightPass.shader   = subModel->getShader(lightPassIdx);
         lightPass.dynamicOffsets.resize(count);
+        lightPass.lights.reserve(count);
         for (unsigned idx = 0; idx < count; idx++) {
             const auto lightIdx = _lightIndices[idx];
             lightPass.lights.emplace_back(lightIdx);
@@ -346,7 +342,7 @@ void RenderAdditiveLightQueue::updateLightDescriptorSet(const scene::Camera *cam
                     updateDirLight(shadow, mainLight, &_shadowUBO);
                 }
 
-                const auto &matShadowCamera = light->getNode()->getWorldMatrix();
+                const auto &matShadowCamera = light->getWorldMatrix();
                 memcpy(_shadowUBO.data() + UBOShadow::MAT_LIGHT_VIEW_OFFSET, matShadowCamera.m, sizeof(matShadowCamera));
 
                 const auto matShadowView = matShadowCamera.getInversed();
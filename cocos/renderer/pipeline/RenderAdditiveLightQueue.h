@@ -45,8 +45,8 @@ struct AdditiveLightPass {
     const scene::SubModel *subModel = nullptr;
     const scene::Pass *    pass     = nullptr;
     gfx::Shader *          shader   = nullptr;
-    vector<uint>           dynamicOffsets;
-    vector<uint>           lights;
+    FrameVector<uint>      dynamicOffsets;
+    FrameVector<uint>      lights;
 };
 
 class RenderAdditiveLightQueue : public Object {
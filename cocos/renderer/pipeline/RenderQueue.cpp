@@ -34,6 +34,12 @@
 
 namespace cc {
 namespace pipeline {
+namespace {
+bool writesDepth(const scene::Pass *pass) {
+    const auto *depthStencilState = pass->getDepthStencilState();
+    return depthStencilState->depthTest && depthStencilState->depthWrite;
+}
+} // namespace
 
 RenderQueue::RenderQueue(RenderQueueCreateInfo desc)
 : _passDesc(std::move(desc)) {
@@ -44,7 +50,7 @@ void RenderQueue::clear() {
 }
 
 bool RenderQueue::insertRenderPass(const RenderObject &renderObj, uint subModelIdx, uint passIdx) {
-    const auto *      subModel      = renderObj.model->getSubModels()[subModelIdx].get();
+    auto *            subModel      = renderObj.model->getSubModels()[subModelIdx].get();
     const auto *const pass          = subModel->getPass(passIdx);
     const bool        isTransparent = pass->getBlendState()->targets[0].blend;
 
@@ -65,16 +71,38 @@ void RenderQueue::sort() {
     std::sort(_queue.begin(), _queue.end(), _passDesc.sortFunc);
 }
 
-void RenderQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff) {
+void RenderQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, bool depthPrepassed) {
+    for (auto &i : _queue) {
+        auto *const subModel       = i.subModel;
+        const auto  passIdx        = i.passIndex;
+        auto *      inputAssembler = subModel->getInputAssembler();
+
+        const auto *pass    = subModel->getPass(passIdx);
+        auto *      shader  = subModel->getShader(passIdx);
+        const bool  prepass = depthPrepassed && writesDepth(pass) && subModel->getDepthPrepassShader(passIdx);
+        const auto  variant = prepass ? PipelineStateVariant::DEPTH_EQUAL : PipelineStateVariant::DEFAULT;
+
+        auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, variant);
+        cmdBuff->bindPipelineState(pso);
+        cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
+        cmdBuff->bindDescriptorSet(localSet, subModel->getDescriptorSet());
+        cmdBuff->bindInputAssembler(inputAssembler);
+        cmdBuff->draw(inputAssembler);
+    }
+}
+
+void RenderQueue::recordDepthPrepass(gfx::Device * /*device*/, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff) {
     for (auto &i : _queue) {
-        const auto *const subModel       = i.subModel;
-        const auto        passIdx        = i.passIndex;
-        auto *            inputAssembler = subModel->getInputAssembler();
+        auto *const subModel = i.subModel;
+        const auto  passIdx  = i.passIndex;
+        const auto *pass     = subModel->getPass(passIdx);
+        if (!writesDepth(pass)) continue;
 
-        const auto *pass   = subModel->getPass(passIdx);
-        auto *      shader = subModel->getShader(passIdx);
+        auto *shader = subModel->getDepthPrepassShader(passIdx);
+        if (!shader) continue;
 
-        auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass);
+        auto *inputAssembler = subModel->getInputAssembler();
+        auto *pso            = PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, PipelineStateVariant::DEPTH_ONLY);
         cmdBuff->bindPipelineState(pso);
         cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
         cmdBuff->bindDescriptorSet(localSet, subModel->getDescriptorSet());
@@ -36,7 +36,9 @@ public:
 
     void clear();
     bool insertRenderPass(const RenderObject &renderObj, uint subModelIdx, uint passIdx);
-    void recordCommandBuffer(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff);
+    void recordCommandBuffer(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, bool depthPrepassed = false);
+    // Depth-only draw of every depth-writing pass, shaded afterwards by recordCommandBuffer with depthPrepassed set
+    void recordDepthPrepass(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff);
     void sort();
 
 private:
@@ -29,6 +29,7 @@
 #include "Define.h"
 #include "RenderPipeline.h"
 #include "SceneCulling.h"
+#include "core/assets/TextureStreamer.h"
 #include "core/geometry/AABB.h"
 #include "core/geometry/Sphere.h"
 #include "core/scene-graph/Node.h"
@@ -49,9 +50,9 @@ geometry::AABB castWorldBounds;
 RenderObject genRenderObject(const scene::Model *model, const scene::Camera *camera) {
     float depth = 0;
     if (model->getNode()) {
-        auto *const node = model->getTransform();
-        cc::Vec3    position;
-        cc::Vec3::subtract(node->getWorldPosition(), camera->getPosition(), &position);
+        cc::Vec3 position;
+        model->getWorldMatrix().getTranslation(&position);
+        position.subtract(camera->getPosition());
         depth = position.dot(camera->getForward());
     }
 
@@ -70,8 +71,7 @@ void getShadowWorldMatrix(const geometry::Sphere *sphere, const cc::Quaternion &
 }
 
 void updateDirLight(scene::Shadow *shadow, const scene::Light *light, std::array<float, UBOShadow::COUNT> *shadowUBO) {
-    auto *const node     = light->getNode();
-    const auto &rotation = node->getWorldRotation();
+    const auto &rotation = light->getWorldRotation();
     Quaternion  qt(rotation.x, rotation.y, rotation.z, rotation.w);
     Vec3        forward(0, 0, -1.0F);
     forward.transformQuat(qt);
@@ -110,20 +110,18 @@ void updateDirLight(scene::Shadow *shadow, const scene::Light *light, std::array
 
 void lightCollecting(scene::Camera *camera, std::vector<const scene::Light *> *validLights) {
     validLights->clear();
-    auto *              sphere    = CC_NEW(geometry::Sphere);
+    geometry::Sphere    sphere;
     const auto *        scene     = camera->getScene();
     const scene::Light *mainLight = scene->getMainLight();
     validLights->emplace_back(mainLight);
 
     for (auto &spotLight : scene->getSpotLights()) {
-        sphere->setCenter(spotLight->getPosition());
-        sphere->setRadius(spotLight->getRange());
-        if (sphere->interset(camera->getFrustum())) {
+        sphere.setCenter(spotLight->getPosition());
+        sphere.setRadius(spotLight->getRange());
+        if (sphere.interset(camera->getFrustum())) {
             validLights->emplace_back(static_cast<scene::Light *>(spotLight));
         }
     }
-
-    CC_SAFE_DELETE(sphere);
 }
 
 void sceneCulling(RenderPipeline *pipeline, scene::Camera *camera) {
@@ -139,7 +137,14 @@ void sceneCulling(RenderPipeline *pipeline, scene::Camera *camera) {
         isShadowMap = true;
     }
 
+    // reserve up front, a vector growing in the frame arena leaves its old buffers behind until the arena is reset
+    const auto modelCount = scene->getModels().size();
+    if (isShadowMap) {
+        shadowObjects.reserve(modelCount);
+    }
     RenderObjectList renderObjects;
+    renderObjects.reserve(modelCount + 1);
+    auto *const streamer = TextureStreamer::getInstance();
 
     if (skyBox != nullptr && skyBox->isEnabled() && skyBox->getModel() && (static_cast<uint32_t>(camera->getClearFlag()) & skyboxFlag)) {
         renderObjects.emplace_back(genRenderObject(skyBox->getModel(), camera));
@@ -148,9 +153,9 @@ void sceneCulling(RenderPipeline *pipeline, scene::Camera *camera) {
     for (const auto &model : scene->getModels()) {
         // filter model by view visibility
         if (model->isEnabled()) {
-            const auto        visibility = camera->getVisibility();
-            const auto *const node       = model->getNode();
-            if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
+            const auto visibility = camera->getVisibility();
+            const auto layer      = model->getNodeLayer();
+            if ((model->getNode() && ((visibility & layer) == layer)) ||
                 (visibility & static_cast<uint>(model->getVisFlags()))) {
                 // shadow render Object
                 const auto *modelWorldBounds = model->getWorldBounds();
@@ -168,14 +173,18 @@ void sceneCulling(RenderPipeline *pipeline, scene::Camera *camera) {
                 }
 
                 renderObjects.emplace_back(genRenderObject(model, camera));
+                if (streamer->isEnabled()) {
+                    streamer->updateModel(camera, model);
+                }
             }
         }
     }
 
     if (isShadowMap) {
         sceneData->getSphere()->define(castWorldBounds);
-        sceneData->setShadowObjects(std::move(shadowObjects));
     }
+    // always replaced, a list kept from an older frame would point into recycled arena memory
+    sceneData->setShadowObjects(std::move(shadowObjects));
 
     sceneData->setRenderObjects(std::move(renderObjects));
 }
@@ -118,6 +118,7 @@ bool DeferredPipeline::initialize(const RenderPipelineInfo &info) {
 
 bool DeferredPipeline::activate() {
     _macros["CC_PIPELINE_TYPE"] = 1.0F;
+    _globalDSManager->setTiledLightBindings(_tiledLightCulling);
 
     if (!RenderPipeline::activate()) {
         CC_LOG_ERROR("RenderPipeline active failed.");
@@ -135,6 +136,9 @@ bool DeferredPipeline::activate() {
 void DeferredPipeline::render(const vector<scene::Camera *> &cameras) {
     static gfx::TextureBarrier *present{_device->createTextureBarrier({{gfx::AccessType::COLOR_ATTACHMENT_WRITE}, {gfx::AccessType::PRESENT}})};
     static gfx::Texture *       backBuffer{nullptr};
+    if (_dynamicResolutionEnabled) {
+        updateDynamicResolution();
+    }
     _commandBuffers[0]->begin();
     _pipelineUBO->updateGlobalUBO();
     _pipelineUBO->updateMultiCameraUBO(cameras);
@@ -151,6 +155,44 @@ void DeferredPipeline::render(const vector<scene::Camera *> &cameras) {
     _device->getQueue()->submit(_commandBuffers);
 }
 
+void DeferredPipeline::setTiledLightCulling(bool enabled) {
+    if (_descriptorSet) {
+        CC_LOG_WARNING("Tiled light culling has to be set before the pipeline is activated.");
+        return;
+    }
+    if (enabled && !_device->hasFeature(gfx::Feature::TEXTURE_FLOAT)) {
+        CC_LOG_WARNING("Tiled light culling requires float textures.");
+        enabled = false;
+    }
+    _tiledLightCulling = enabled;
+}
+
+void DeferredPipeline::setDynamicResolution(bool enabled) {
+    if (_dynamicResolutionEnabled == enabled) {
+        return;
+    }
+
+    _dynamicResolutionEnabled = enabled;
+    if (enabled) {
+        _fixedShadingScale = _pipelineSceneData->getShadingScale();
+        _dynamicResolution.reset(_fixedShadingScale);
+        _lastFrameTime = {};
+    } else {
+        _pipelineSceneData->setShadingScale(_fixedShadingScale);
+    }
+}
+
+void DeferredPipeline::updateDynamicResolution() {
+    // The interval between frames includes waiting on the GPU, so it covers both CPU and GPU bound frames.
+    // It also includes the vsync wait, which the controller handles by probing frames pinned to the target
+    const auto now = std::chrono::steady_clock::now();
+    if (_lastFrameTime != std::chrono::steady_clock::time_point{}) {
+        const float frameTime = std::chrono::duration<float>(now - _lastFrameTime).count();
+        _pipelineSceneData->setShadingScale(_dynamicResolution.update(frameTime));
+    }
+    _lastFrameTime = now;
+}
+
 void DeferredPipeline::updateQuadVertexData(const gfx::Rect &renderArea) {
     if (_lastUsedRenderArea == renderArea) {
         return;
@@ -230,7 +272,7 @@ bool DeferredPipeline::createQuadInputAssembler(gfx::Buffer **quadIB, gfx::Buffe
     return (*quadIA) != nullptr;
 }
 
-gfx::Rect DeferredPipeline::getRenderArea(scene::Camera *camera, bool onScreen) {
+gfx::Rect DeferredPipeline::getRenderArea(scene::Camera *camera, bool onScreen, bool scaled) {
     gfx::Rect renderArea;
 
     uint w;
@@ -244,10 +286,11 @@ gfx::Rect DeferredPipeline::getRenderArea(scene::Camera *camera, bool onScreen)
     }
 
     const auto &viewport = camera->getViewport();
+    const auto  scale    = scaled ? _pipelineSceneData->getShadingScale() : 1.0F;
     renderArea.x         = static_cast<int>(viewport.x * w);
     renderArea.y         = static_cast<int>(viewport.y * h);
-    renderArea.width     = static_cast<uint>(viewport.z * w * _pipelineSceneData->getShadingScale());
-    renderArea.height    = static_cast<uint>(viewport.w * h * _pipelineSceneData->getShadingScale());
+    renderArea.width     = static_cast<uint>(viewport.z * w * scale);
+    renderArea.height    = static_cast<uint>(viewport.w * h * scale);
     return renderArea;
 }
 
@@ -289,6 +332,8 @@ bool DeferredPipeline::activeRenderer() {
     _macros["CC_USE_HDR"]               = _pipelineSceneData->isHDR();
     _macros["CC_SUPPORT_FLOAT_TEXTURE"] = _device->hasFeature(gfx::Feature::TEXTURE_FLOAT);
 
+    _macros["CC_ENABLE_TILED_LIGHT_CULLING"] = _tiledLightCulling;
+
     if (!createQuadInputAssembler(&_quadIB, &_quadVBOffscreen, &_quadIAOffscreen)) {
         return false;
     }
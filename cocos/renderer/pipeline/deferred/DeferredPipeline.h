@@ -26,9 +26,11 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 
 #include "gfx-base/GFXBuffer.h"
 #include "gfx-base/GFXInputAssembler.h"
+#include "pipeline/DynamicResolution.h"
 #include "pipeline/RenderPipeline.h"
 
 namespace cc {
@@ -64,17 +66,28 @@ public:
     inline const UintList &       getLightIndexOffsets() const { return _lightIndexOffsets; }
     inline const UintList &       getLightIndices() const { return _lightIndices; }
     gfx::InputAssembler *         getQuadIAOffScreen() { return _quadIAOffscreen; }
-    gfx::Rect                     getRenderArea(scene::Camera *camera, bool onScreen);
+    gfx::Rect                     getRenderArea(scene::Camera *camera, bool onScreen, bool scaled = true);
     inline DeferredRenderData *   getDeferredRenderData() { return _deferredRenderData; };
     void                          updateQuadVertexData(const gfx::Rect &renderArea);
     void                          genQuadVertexData(gfx::SurfaceTransform surfaceTransform, const gfx::Rect &renderArea, float *data);
 
+    // Scene passes render at a shading scale driven by the frame time, the postprocess stage upscales to the window
+    inline bool               isDynamicResolution() const { return _dynamicResolutionEnabled; }
+    void                      setDynamicResolution(bool enabled);
+    inline DynamicResolution &getDynamicResolution() { return _dynamicResolution; }
+
+    // Bins the deferred lights into screen tiles every frame for the lighting pass, see CC_ENABLE_TILED_LIGHT_CULLING.
+    // Off by default, must be set before activation, requires float textures.
+    void        setTiledLightCulling(bool enabled);
+    inline bool isTiledLightCulling() const { return _tiledLightCulling; }
+
 private:
     bool activeRenderer();
     bool createQuadInputAssembler(gfx::Buffer **quadIB, gfx::Buffer **quadVB, gfx::InputAssembler **quadIA);
     void destroyQuadInputAssembler();
     void destroyDeferredData();
     void generateDeferredRenderData();
+    void updateDynamicResolution();
 
     gfx::Buffer *                           _lightsUBO = nullptr;
     LightList                               _validLights;
@@ -94,6 +107,12 @@ private:
     gfx::RenderPass *   _lightingRenderPass = nullptr;
     uint                _width;
     uint                _height;
+
+    DynamicResolution                     _dynamicResolution;
+    bool                                  _dynamicResolutionEnabled{false};
+    bool                                  _tiledLightCulling{false};
+    float                                 _fixedShadingScale{1.0F};
+    std::chrono::steady_clock::time_point _lastFrameTime;
 };
 
 } // namespace pipeline
@@ -43,6 +43,7 @@
 #include "scene/RenderScene.h"
 #include "scene/SphereLight.h"
 #include "DeferredPipelineSceneData.h"
+#include "TiledLightCulling.h"
 
 namespace cc {
 namespace pipeline {
@@ -73,6 +74,7 @@ LightingStage::LightingStage() = default;
 LightingStage::~LightingStage() {
     CC_SAFE_DESTROY(_deferredLitsBufs);
     CC_SAFE_DESTROY(_deferredLitsBufView);
+    CC_SAFE_DELETE(_tiledLightCulling);
 }
 
 bool LightingStage::initialize(const RenderStageInfo &info) {
@@ -103,9 +105,10 @@ void LightingStage::gatherLights(scene::Camera *camera) {
     uint          offset     = 0;
     cc::Vec4      tmpArray;
 
-    uint i = 0;
+    _lightBounds.clear();
+
     for (const auto &light : scene->getSphereLights()) {
-        if (i >= _maxDeferredLights) {
+        if (idx >= _maxDeferredLights) {
             break;
         }
 
@@ -150,13 +153,13 @@ void LightingStage::gatherLights(scene::Camera *camera) {
         _lightBufferData[offset + 1] = light->getRange();
         _lightBufferData[offset + 2] = 0;
 
-        ++i;
+        _lightBounds.emplace_back(position.x, position.y, position.z, light->getRange());
+
         ++idx;
     }
 
-    i = 0;
     for (const auto &light : scene->getSpotLights()) {
-        if (i >= _maxDeferredLights) {
+        if (idx >= _maxDeferredLights) {
             break;
         }
 
@@ -208,13 +211,18 @@ void LightingStage::gatherLights(scene::Camera *camera) {
         _lightBufferData[offset + 1] = direction.y;
         _lightBufferData[offset + 2] = direction.z;
 
-        ++i;
+        _lightBounds.emplace_back(position.x, position.y, position.z, light->getRange());
+
         ++idx;
     }
 
     // the count of lights is set to cc_lightDir[0].w
     _lightBufferData[fieldLen * 3 + 3] = static_cast<float>(idx);
     cmdBuf->updateBuffer(_deferredLitsBufs, _lightBufferData.data());
+
+    if (_tiledLightCulling) {
+        _tiledLightCulling->update(camera, pipeline->getRenderArea(camera, false), _lightBounds, cmdBuf);
+    }
 }
 
 void LightingStage::initLightingBuffer() {
@@ -270,6 +278,11 @@ void LightingStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
 
     _planarShadowQueue = CC_NEW(PlanarShadowQueue(_pipeline));
 
+    // per-tile light lists, see CC_ENABLE_TILED_LIGHT_CULLING
+    if (static_cast<DeferredPipeline *>(_pipeline)->isTiledLightCulling()) {
+        _tiledLightCulling = CC_NEW(TiledLightCulling(_pipeline));
+    }
+
     // create reflection resource
     RenderQueueCreateInfo info = {true, _reflectionPhaseID, transparentCompareFn};
     _reflectionComp            = new ReflectionComp();
@@ -304,6 +317,7 @@ void LightingStage::destroy() {
     CC_SAFE_DESTROY(_descriptorSet);
     CC_SAFE_DESTROY(_descLayout);
     CC_SAFE_DESTROY(_planarShadowQueue);
+    CC_SAFE_DELETE(_tiledLightCulling);
     CC_SAFE_DELETE(_reflectionRenderQueue);
     RenderStage::destroy();
 
@@ -326,8 +340,8 @@ void LightingStage::render(scene::Camera *camera) {
     gatherLights(camera);
     _descriptorSet->update();
 
-    vector<uint> dynamicOffsets = {0};
-    cmdBuff->bindDescriptorSet(localSet, _descriptorSet, dynamicOffsets);
+    const uint dynamicOffsets[] = {0};
+    cmdBuff->bindDescriptorSet(localSet, _descriptorSet, static_cast<uint>(std::size(dynamicOffsets)), dynamicOffsets);
 
     // draw quad
     gfx::Rect renderArea = pipeline->getRenderArea(camera, false);
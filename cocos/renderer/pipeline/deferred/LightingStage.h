@@ -37,6 +37,7 @@ class RenderBatchedQueue;
 class RenderInstancedQueue;
 class RenderAdditiveLightQueue;
 class PlanarShadowQueue;
+class TiledLightCulling;
 struct DeferredRenderData;
 
 class CC_DLL LightingStage : public RenderStage {
@@ -71,6 +72,8 @@ private:
     gfx::DescriptorSet *      _descriptorSet{nullptr};
     gfx::DescriptorSetLayout *_descLayout{nullptr};
     uint                      _maxDeferredLights{UBODeferredLight::LIGHTS_PER_PASS};
+    vector<Vec4>              _lightBounds;
+    TiledLightCulling *       _tiledLightCulling{nullptr};
 
     ReflectionComp * _reflectionComp{nullptr};
     RenderQueue *    _reflectionRenderQueue{nullptr};
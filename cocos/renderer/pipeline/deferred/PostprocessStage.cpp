@@ -90,7 +90,8 @@ void PostprocessStage::render(scene::Camera *camera) {
     assert(pp != nullptr);
     gfx::CommandBuffer *cmdBf = pp->getCommandBuffers()[0];
 
-    gfx::Rect renderArea = pp->getRenderArea(camera, !camera->getWindow()->hasOffScreenAttachments());
+    // The scene was shaded into a shading scaled area of the offscreen targets, the quad stretches it over the full output
+    gfx::Rect renderArea = pp->getRenderArea(camera, !camera->getWindow()->hasOffScreenAttachments(), false);
 
     const gfx::Color &clearColor = camera->getClearColor();
     if (hasFlag(static_cast<gfx::ClearFlags>(camera->getClearFlag()), gfx::ClearFlagBit::COLOR)) {
@@ -0,0 +1,221 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "TiledLightCulling.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+
+#include "../GlobalDescriptorSetManager.h"
+#include "../RenderPipeline.h"
+#include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXTexture.h"
+#include "scene/Camera.h"
+
+namespace cc {
+namespace pipeline {
+namespace {
+constexpr uint INDICES_PER_ROW = UBODeferredLight::INDEX_TEXTURE_WIDTH * 4;
+} // namespace
+
+TiledLightCulling::TiledLightCulling(RenderPipeline *pipeline) : _pipeline(pipeline) {
+    auto *sampler = _pipeline->getGlobalDSManager()->getPointSampler();
+    _pipeline->getGlobalDSManager()->bindSampler(TILEDLIGHTGRID::BINDING, sampler);
+    _pipeline->getGlobalDSManager()->bindSampler(TILEDLIGHTINDICES::BINDING, sampler);
+
+    _indexTexture = createTexture(UBODeferredLight::INDEX_TEXTURE_WIDTH, _indexRowCapacity, TILEDLIGHTINDICES::BINDING);
+}
+
+TiledLightCulling::~TiledLightCulling() {
+    destroy();
+}
+
+void TiledLightCulling::destroy() {
+    CC_SAFE_DESTROY(_gridTexture);
+    CC_SAFE_DESTROY(_indexTexture);
+    CC_SAFE_DELETE(_gridTexture);
+    CC_SAFE_DELETE(_indexTexture);
+}
+
+gfx::Texture *TiledLightCulling::createTexture(uint width, uint height, uint binding) const {
+    auto *device = gfx::Device::getInstance();
+
+    gfx::TextureUsage usage = gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST;
+    // leave room for binning on the GPU, which writes the same layout
+    if (device->hasFeature(gfx::Feature::COMPUTE_SHADER)) usage |= gfx::TextureUsageBit::STORAGE;
+
+    auto *texture = device->createTexture({
+        gfx::TextureType::TEX2D,
+        usage,
+        gfx::Format::RGBA32F,
+        width,
+        height,
+    });
+    _pipeline->getGlobalDSManager()->bindTexture(binding, texture);
+    _pipeline->getGlobalDSManager()->update();
+    return texture;
+}
+
+void TiledLightCulling::update(const scene::Camera *camera, const gfx::Rect &renderArea, const vector<Vec4> &lights, gfx::CommandBuffer *cmdBuffer) {
+    const uint tileCountX = std::max((renderArea.width + UBODeferredLight::TILE_SIZE - 1) / UBODeferredLight::TILE_SIZE, 1U);
+    const uint tileCountY = std::max((renderArea.height + UBODeferredLight::TILE_SIZE - 1) / UBODeferredLight::TILE_SIZE, 1U);
+    if (tileCountX != _tileCountX || tileCountY != _tileCountY) {
+        resizeGrid(tileCountX, tileCountY);
+    }
+
+    binLights(camera, lights);
+    upload(cmdBuffer);
+}
+
+void TiledLightCulling::resizeGrid(uint tileCountX, uint tileCountY) {
+    auto *texture = _gridTexture;
+    _tileCountX   = tileCountX;
+    _tileCountY   = tileCountY;
+    _gridTexture  = createTexture(_tileCountX, _tileCountY, TILEDLIGHTGRID::BINDING);
+    if (texture) {
+        texture->destroy();
+        CC_DELETE(texture);
+    }
+
+    _tileCounts.resize(_tileCountX * _tileCountY);
+    _gridData.resize(_tileCountX * _tileCountY * 4);
+}
+
+bool TiledLightCulling::projectLight(const scene::Camera *camera, const Vec4 &light, TileRect *rect) const {
+    Vec3 center;
+    camera->getMatView().transformPoint({light.x, light.y, light.z}, &center);
+    const float radius = light.w;
+
+    // view space looks down -z
+    if (-center.z - radius > camera->getFarClip()) return false;
+
+    float minX = -1.F;
+    float minY = -1.F;
+    float maxX = 1.F;
+    float maxY = 1.F;
+
+    // when the sphere reaches the near plane its projection is unbounded, cover the whole screen
+    if (-center.z - radius > camera->getNearClip()) {
+        const auto &matProj = camera->getMatProj();
+        minX                = FLT_MAX;
+        minY                = FLT_MAX;
+        maxX                = -FLT_MAX;
+        maxY                = -FLT_MAX;
+        for (uint i = 0U; i < 8U; ++i) {
+            Vec4 corner{center.x + (i & 1U ? radius : -radius),
+                        center.y + (i & 2U ? radius : -radius),
+                        center.z + (i & 4U ? radius : -radius),
+                        1.F};
+            matProj.transformVector(&corner);
+            minX = std::min(minX, corner.x / corner.w);
+            minY = std::min(minY, corner.y / corner.w);
+            maxX = std::max(maxX, corner.x / corner.w);
+            maxY = std::max(maxY, corner.y / corner.w);
+        }
+        if (minX > 1.F || minY > 1.F || maxX < -1.F || maxY < -1.F) return false;
+    }
+
+    auto toTile = [](float ndc, uint tileCount) {
+        const float tile = (std::min(std::max(ndc, -1.F), 1.F) * 0.5F + 0.5F) * static_cast<float>(tileCount);
+        return std::min(static_cast<uint>(tile), tileCount - 1);
+    };
+    rect->left   = toTile(minX, _tileCountX);
+    rect->right  = toTile(maxX, _tileCountX);
+    rect->bottom = toTile(minY, _tileCountY);
+    rect->top    = toTile(maxY, _tileCountY);
+    return true;
+}
+
+void TiledLightCulling::binLights(const scene::Camera *camera, const vector<Vec4> &lights) {
+    static constexpr uint CULLED = UINT_MAX;
+
+    std::fill(_tileCounts.begin(), _tileCounts.end(), 0U);
+
+    // count the lights per tile
+    _lightRects.resize(lights.size());
+    for (uint i = 0U; i < lights.size(); ++i) {
+        auto &rect = _lightRects[i];
+        if (!projectLight(camera, lights[i], &rect)) {
+            rect.left = CULLED;
+            continue;
+        }
+        for (uint y = rect.bottom; y <= rect.top; ++y) {
+            for (uint x = rect.left; x <= rect.right; ++x) {
+                ++_tileCounts[y * _tileCountX + x];
+            }
+        }
+    }
+
+    // prefix sum into tile offsets, then scatter the light indices
+    uint offset = 0U;
+    for (uint i = 0U; i < _tileCounts.size(); ++i) {
+        _gridData[i * 4]     = static_cast<float>(offset);
+        _gridData[i * 4 + 1] = static_cast<float>(_tileCounts[i]);
+        offset += _tileCounts[i];
+        _tileCounts[i] = offset - _tileCounts[i];
+    }
+
+    _lightIndices.resize(offset);
+    for (uint i = 0U; i < lights.size(); ++i) {
+        const auto &rect = _lightRects[i];
+        if (rect.left == CULLED) continue;
+        for (uint y = rect.bottom; y <= rect.top; ++y) {
+            for (uint x = rect.left; x <= rect.right; ++x) {
+                _lightIndices[_tileCounts[y * _tileCountX + x]++] = i;
+            }
+        }
+    }
+}
+
+void TiledLightCulling::upload(gfx::CommandBuffer *cmdBuffer) {
+    gfx::BufferTextureCopy region;
+    region.texExtent = {_tileCountX, _tileCountY, 1U};
+    const auto *data = reinterpret_cast<const uint8_t *>(_gridData.data());
+    cmdBuffer->copyBuffersToTexture(&data, _gridTexture, &region, 1);
+
+    if (_lightIndices.empty()) return;
+
+    const uint rows = (static_cast<uint>(_lightIndices.size()) + INDICES_PER_ROW - 1) / INDICES_PER_ROW;
+    if (rows > _indexRowCapacity) {
+        auto *texture     = _indexTexture;
+        _indexRowCapacity = nextPow2(rows);
+        _indexTexture     = createTexture(UBODeferredLight::INDEX_TEXTURE_WIDTH, _indexRowCapacity, TILEDLIGHTINDICES::BINDING);
+        texture->destroy();
+        CC_DELETE(texture);
+    }
+
+    _indexData.assign(rows * INDICES_PER_ROW, 0.F);
+    std::copy(_lightIndices.begin(), _lightIndices.end(), _indexData.begin());
+
+    region.texExtent = {UBODeferredLight::INDEX_TEXTURE_WIDTH, rows, 1U};
+    data             = reinterpret_cast<const uint8_t *>(_indexData.data());
+    cmdBuffer->copyBuffersToTexture(&data, _indexTexture, &region, 1);
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,87 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "../Define.h"
+#include "base/CoreStd.h"
+#include "math/Vec4.h"
+
+namespace cc {
+namespace scene {
+class Camera;
+} // namespace scene
+namespace pipeline {
+
+class RenderPipeline;
+
+// CPU light binning for the deferred lighting pass.
+// Projects the bounding sphere of every light gathered for the pass onto the screen,
+// and uploads per-tile (offset, count) pairs and the flat list of light indices they point into,
+// so that each pixel only evaluates the lights overlapping its tile (see UBODeferredLight::TILE_SIZE).
+class CC_DLL TiledLightCulling : public Object {
+public:
+    explicit TiledLightCulling(RenderPipeline *pipeline);
+    ~TiledLightCulling() override;
+
+    // lights are world space bounding spheres (xyz: center, w: range), indexed as in the deferred light buffer
+    void update(const scene::Camera *camera, const gfx::Rect &renderArea, const vector<Vec4> &lights, gfx::CommandBuffer *cmdBuffer);
+    void destroy();
+
+    inline uint getTileCountX() const { return _tileCountX; }
+    inline uint getTileCountY() const { return _tileCountY; }
+    inline uint getLightIndexCount() const { return static_cast<uint>(_lightIndices.size()); }
+
+private:
+    struct TileRect {
+        uint left{0U};
+        uint bottom{0U};
+        uint right{0U}; // inclusive
+        uint top{0U};   // inclusive
+    };
+
+    bool projectLight(const scene::Camera *camera, const Vec4 &light, TileRect *rect) const;
+    void resizeGrid(uint tileCountX, uint tileCountY);
+    void binLights(const scene::Camera *camera, const vector<Vec4> &lights);
+    void upload(gfx::CommandBuffer *cmdBuffer);
+
+    gfx::Texture *createTexture(uint width, uint height, uint binding) const;
+
+    RenderPipeline * _pipeline = nullptr;
+    vector<TileRect> _lightRects;
+    vector<uint>     _lightIndices;
+    vector<uint>     _tileCounts;
+    vector<float>    _gridData;
+    vector<float>    _indexData;
+
+    gfx::Texture *_gridTexture      = nullptr;
+    gfx::Texture *_indexTexture     = nullptr;
+    uint          _tileCountX       = 0U;
+    uint          _tileCountY       = 0U;
+    uint          _indexRowCapacity = 4U;
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,411 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "ClusterLightCulling.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "../GlobalDescriptorSetManager.h"
+#include "../RenderPipeline.h"
+#include "base/job-system/JobSystem.h"
+#include "core/geometry/Sphere.h"
+#include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXTexture.h"
+#include "math/Vec4.h"
+#include "scene/Camera.h"
+#include "scene/RenderScene.h"
+#include "scene/SphereLight.h"
+#include "scene/SpotLight.h"
+
+namespace cc {
+namespace pipeline {
+namespace {
+constexpr uint CLUSTERS_XY     = ForwardCluster::CLUSTERS_X * ForwardCluster::CLUSTERS_Y;
+constexpr uint INDICES_PER_ROW = ForwardCluster::INDEX_TEXTURE_WIDTH * 4;
+
+inline uint clusterIndex(uint x, uint y, uint z) {
+    return (z * ForwardCluster::CLUSTERS_Y + y) * ForwardCluster::CLUSTERS_X + x;
+}
+
+Vec3 unproject(const Mat4 &projInv, float x, float y, float z) {
+    Vec4 point{x, y, z, 1.F};
+    projInv.transformVector(&point);
+    return {point.x / point.w, point.y / point.w, point.z / point.w};
+}
+
+// the point on segment [a, b] with the given view space z
+Vec3 pointAtDepth(const Vec3 &a, const Vec3 &b, float z) {
+    const float t = std::abs(b.z - a.z) > 1e-6F ? (z - a.z) / (b.z - a.z) : 0.F;
+    return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, z};
+}
+
+bool sphereAABB(const Vec3 &center, float radius, const Vec3 &min, const Vec3 &max) {
+    float distSqr = 0.F;
+    for (uint i = 0U; i < 3U; ++i) {
+        const float v = (&center.x)[i];
+        if (v < (&min.x)[i]) distSqr += ((&min.x)[i] - v) * ((&min.x)[i] - v);
+        if (v > (&max.x)[i]) distSqr += (v - (&max.x)[i]) * (v - (&max.x)[i]);
+    }
+    return distSqr <= radius * radius;
+}
+} // namespace
+
+ClusterLightCulling::ClusterLightCulling(RenderPipeline *pipeline) : _pipeline(pipeline) {
+    auto *sampler = _pipeline->getGlobalDSManager()->getPointSampler();
+    _pipeline->getGlobalDSManager()->bindSampler(CLUSTERLIGHTS::BINDING, sampler);
+    _pipeline->getGlobalDSManager()->bindSampler(CLUSTERLIGHTGRID::BINDING, sampler);
+    _pipeline->getGlobalDSManager()->bindSampler(CLUSTERLIGHTINDICES::BINDING, sampler);
+
+    _lightTexture = createTexture(ForwardCluster::LIGHT_TEXELS, _lightCapacity, CLUSTERLIGHTS::BINDING);
+    _gridTexture  = createTexture(CLUSTERS_XY, ForwardCluster::CLUSTERS_Z + 1, CLUSTERLIGHTGRID::BINDING);
+    _indexTexture = createTexture(ForwardCluster::INDEX_TEXTURE_WIDTH, _indexRowCapacity, CLUSTERLIGHTINDICES::BINDING);
+    _pipeline->getGlobalDSManager()->update();
+
+    _clusterCounts.resize(ForwardCluster::CLUSTER_COUNT);
+    _sliceLights.resize(ForwardCluster::CLUSTERS_Z);
+    _sliceIndices.resize(ForwardCluster::CLUSTERS_Z);
+    _gridData.resize((ForwardCluster::CLUSTER_COUNT + CLUSTERS_XY) * 4);
+}
+
+ClusterLightCulling::~ClusterLightCulling() {
+    destroy();
+}
+
+void ClusterLightCulling::destroy() {
+    CC_SAFE_DESTROY(_lightTexture);
+    CC_SAFE_DESTROY(_gridTexture);
+    CC_SAFE_DESTROY(_indexTexture);
+    CC_SAFE_DELETE(_lightTexture);
+    CC_SAFE_DELETE(_gridTexture);
+    CC_SAFE_DELETE(_indexTexture);
+    _cameraStates.clear();
+    _state = nullptr;
+}
+
+gfx::Texture *ClusterLightCulling::createTexture(uint width, uint height, uint binding) {
+    auto *texture = gfx::Device::getInstance()->createTexture({
+        gfx::TextureType::TEX2D,
+        gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST,
+        gfx::Format::RGBA32F,
+        width,
+        height,
+    });
+    _pipeline->getGlobalDSManager()->bindTexture(binding, texture);
+    return texture;
+}
+
+void ClusterLightCulling::update(const scene::Camera *camera, const gfx::Rect &renderArea, gfx::CommandBuffer *cmdBuffer) {
+    auto iter = _cameraStates.find(camera);
+    if (iter == _cameraStates.end()) {
+        if (_cameraStates.size() >= MAX_CAMERA_STATES) {
+            // drop the camera which has not been drawn for the longest time
+            auto oldest = std::min_element(_cameraStates.begin(), _cameraStates.end(), [](const auto &a, const auto &b) {
+                return a.second.lastUpdate < b.second.lastUpdate;
+            });
+            _cameraStates.erase(oldest);
+        }
+        iter = _cameraStates.emplace(camera, CameraState()).first;
+        iter->second.clusterMin.resize(ForwardCluster::CLUSTER_COUNT);
+        iter->second.clusterMax.resize(ForwardCluster::CLUSTER_COUNT);
+    }
+    _state             = &iter->second;
+    _state->lastUpdate = ++_updateCount;
+
+    gatherValidLights(camera);
+    updateClusterBounds(camera);
+    assignLights();
+    updateParams(camera, renderArea);
+    uploadLights(camera, cmdBuffer);
+    uploadClusters(cmdBuffer);
+}
+
+void ClusterLightCulling::gatherValidLights(const scene::Camera *camera) {
+    const auto *const scene   = camera->getScene();
+    const auto &      matView = camera->getMatView();
+    geometry::Sphere  sphere;
+
+    _validLights.clear();
+    _clusterLights.clear();
+
+    auto addLight = [&](scene::Light *light, const Vec3 &position, float range) {
+        sphere.setCenter(position);
+        sphere.setRadius(range);
+        if (!sphere.sphereFrustum(camera->getFrustum())) return;
+
+        ClusterLight clusterLight;
+        matView.transformPoint(position, &clusterLight.center);
+        clusterLight.radius = range;
+
+        // view space looks down -z
+        const float nearest  = std::max(-clusterLight.center.z - range, camera->getNearClip());
+        const float farthest = std::min(-clusterLight.center.z + range, camera->getFarClip());
+        if (nearest > farthest) return;
+        clusterLight.sliceBegin = static_cast<uint>(std::max(std::log(nearest) * _sliceScale + _sliceBias, 0.F));
+        clusterLight.sliceEnd   = std::min(static_cast<uint>(std::max(std::log(farthest) * _sliceScale + _sliceBias, 0.F)), ForwardCluster::CLUSTERS_Z - 1);
+
+        _validLights.emplace_back(light);
+        _clusterLights.emplace_back(clusterLight);
+    };
+
+    // slice parameters are needed to bin the lights
+    const float nearClip = camera->getNearClip();
+    const float farClip  = camera->getFarClip();
+    _sliceScale          = static_cast<float>(ForwardCluster::CLUSTERS_Z) / std::log(farClip / nearClip);
+    _sliceBias           = -std::log(nearClip) * _sliceScale;
+
+    for (const auto &light : scene->getSphereLights()) {
+        addLight(light, light->getPosition(), light->getRange());
+    }
+
+    for (const auto &light : scene->getSpotLights()) {
+        addLight(light, light->getPosition(), light->getRange());
+    }
+}
+
+void ClusterLightCulling::updateClusterBounds(const scene::Camera *camera) {
+    auto &state = *_state;
+    if (!std::memcmp(camera->getMatProj().m, state.proj.m, sizeof(state.proj.m)) && camera->getNearClip() == state.nearClip && camera->getFarClip() == state.farClip) return;
+    state.proj     = camera->getMatProj();
+    state.nearClip = camera->getNearClip();
+    state.farClip  = camera->getFarClip();
+
+    const float minZ    = gfx::Device::getInstance()->getCapabilities().clipSpaceMinZ;
+    const auto &projInv = camera->getMatProjInv();
+
+    for (uint y = 0U; y < ForwardCluster::CLUSTERS_Y; ++y) {
+        for (uint x = 0U; x < ForwardCluster::CLUSTERS_X; ++x) {
+            const float left   = -1.F + 2.F * static_cast<float>(x) / ForwardCluster::CLUSTERS_X;
+            const float right  = -1.F + 2.F * static_cast<float>(x + 1) / ForwardCluster::CLUSTERS_X;
+            const float bottom = -1.F + 2.F * static_cast<float>(y) / ForwardCluster::CLUSTERS_Y;
+            const float top    = -1.F + 2.F * static_cast<float>(y + 1) / ForwardCluster::CLUSTERS_Y;
+
+            const std::array<Vec3, 4> nearCorners{unproject(projInv, left, bottom, minZ), unproject(projInv, right, bottom, minZ),
+                                                  unproject(projInv, left, top, minZ), unproject(projInv, right, top, minZ)};
+            const std::array<Vec3, 4> farCorners{unproject(projInv, left, bottom, 1.F), unproject(projInv, right, bottom, 1.F),
+                                                 unproject(projInv, left, top, 1.F), unproject(projInv, right, top, 1.F)};
+
+            for (uint z = 0U; z < ForwardCluster::CLUSTERS_Z; ++z) {
+                const float sliceNear = -state.nearClip * std::pow(state.farClip / state.nearClip, static_cast<float>(z) / ForwardCluster::CLUSTERS_Z);
+                const float sliceFar  = -state.nearClip * std::pow(state.farClip / state.nearClip, static_cast<float>(z + 1) / ForwardCluster::CLUSTERS_Z);
+
+                Vec3 min{FLT_MAX, FLT_MAX, FLT_MAX};
+                Vec3 max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+                for (uint i = 0U; i < 4U; ++i) {
+                    for (const float depth : {sliceNear, sliceFar}) {
+                        const Vec3 corner = pointAtDepth(nearCorners[i], farCorners[i], depth);
+                        Vec3::min(min, corner, &min);
+                        Vec3::max(max, corner, &max);
+                    }
+                }
+
+                const uint index        = clusterIndex(x, y, z);
+                state.clusterMin[index] = min;
+                state.clusterMax[index] = max;
+            }
+        }
+    }
+}
+
+void ClusterLightCulling::assignLights() {
+    for (auto &lights : _sliceLights) lights.clear();
+    for (uint i = 0U; i < _clusterLights.size(); ++i) {
+        for (uint z = _clusterLights[i].sliceBegin; z <= _clusterLights[i].sliceEnd; ++z) {
+            _sliceLights[z].emplace_back(i);
+        }
+    }
+
+    uint jobThreadCount = JobSystem::getInstance()->threadCount();
+    if (jobThreadCount > 1 && !_clusterLights.empty()) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(1U, ForwardCluster::CLUSTERS_Z, 1U, [this](uint z) {
+            assignSlice(z);
+        }, "ClusterLightCulling::assignSlice");
+        g.run();
+        assignSlice(0U);
+        g.waitForAll();
+    } else {
+        for (uint z = 0U; z < ForwardCluster::CLUSTERS_Z; ++z) {
+            assignSlice(z);
+        }
+    }
+
+    // flatten the per-slice lists in cluster order
+    _lightIndexCount = 0U;
+    for (uint z = 0U; z < ForwardCluster::CLUSTERS_Z; ++z) {
+        _lightIndexCount += static_cast<uint>(_sliceIndices[z].size());
+    }
+
+    const uint rows = std::max((_lightIndexCount + INDICES_PER_ROW - 1) / INDICES_PER_ROW, 1U);
+    _indexData.resize(rows * INDICES_PER_ROW);
+
+    uint offset = 0U;
+    for (uint z = 0U; z < ForwardCluster::CLUSTERS_Z; ++z) {
+        for (uint i = 0U; i < CLUSTERS_XY; ++i) {
+            const uint index         = z * CLUSTERS_XY + i;
+            _gridData[index * 4]     = static_cast<float>(offset);
+            _gridData[index * 4 + 1] = static_cast<float>(_clusterCounts[index]);
+            offset += _clusterCounts[index];
+        }
+        const auto &indices = _sliceIndices[z];
+        const uint  base    = offset - static_cast<uint>(indices.size());
+        for (uint i = 0U; i < indices.size(); ++i) {
+            _indexData[base + i] = static_cast<float>(indices[i]);
+        }
+    }
+}
+
+void ClusterLightCulling::assignSlice(uint z) {
+    auto &      indices = _sliceIndices[z];
+    const auto &lights  = _sliceLights[z];
+    indices.clear();
+
+    for (uint i = 0U; i < CLUSTERS_XY; ++i) {
+        const uint index = z * CLUSTERS_XY + i;
+        const uint begin = static_cast<uint>(indices.size());
+        for (const uint light : lights) {
+            const auto &clusterLight = _clusterLights[light];
+            if (sphereAABB(clusterLight.center, clusterLight.radius, _state->clusterMin[index], _state->clusterMax[index])) {
+                indices.emplace_back(light);
+            }
+        }
+        _clusterCounts[index] = static_cast<uint>(indices.size()) - begin;
+    }
+}
+
+void ClusterLightCulling::uploadLights(const scene::Camera *camera, gfx::CommandBuffer *cmdBuffer) {
+    const auto  exposure   = camera->getExposure();
+    const auto  lightCount = static_cast<uint>(_validLights.size());
+    auto *const sceneData  = _pipeline->getPipelineSceneData();
+    if (lightCount > _lightCapacity) {
+        auto *texture  = _lightTexture;
+        _lightCapacity = nextPow2(lightCount);
+        _lightTexture  = createTexture(ForwardCluster::LIGHT_TEXELS, _lightCapacity, CLUSTERLIGHTS::BINDING);
+        _pipeline->getGlobalDSManager()->update();
+        texture->destroy();
+        CC_DELETE(texture);
+    }
+    if (!lightCount) return;
+
+    constexpr uint stride = ForwardCluster::LIGHT_TEXELS * 4;
+    _lightData.assign(lightCount * stride, 0.F);
+
+    // same layout as UBOForwardLight, one texel per vec4
+    for (uint l = 0, offset = 0; l < lightCount; l++, offset += stride) {
+        auto *      light       = _validLights[l];
+        const bool  isSpotLight = scene::LightType::SPOT == light->getType();
+        const auto *spotLight   = isSpotLight ? static_cast<scene::SpotLight *>(light) : nullptr;
+        const auto *sphereLight = isSpotLight ? nullptr : static_cast<scene::SphereLight *>(light);
+
+        const auto &position   = isSpotLight ? spotLight->getPosition() : sphereLight->getPosition();
+        _lightData[offset]     = position.x;
+        _lightData[offset + 1] = position.y;
+        _lightData[offset + 2] = position.z;
+        _lightData[offset + 3] = isSpotLight ? 1.F : 0.F;
+
+        auto        index = offset + 4;
+        const auto &color = light->getColor();
+        if (light->isUseColorTemperature()) {
+            const auto &tempRGB = light->getColorTemperatureRGB();
+            _lightData[index++] = color.x * tempRGB.x;
+            _lightData[index++] = color.y * tempRGB.y;
+            _lightData[index++] = color.z * tempRGB.z;
+        } else {
+            _lightData[index++] = color.x;
+            _lightData[index++] = color.y;
+            _lightData[index++] = color.z;
+        }
+
+        float luminance = isSpotLight ? spotLight->getLuminance() : sphereLight->getLuminance();
+        if (sceneData->isHDR()) {
+            _lightData[index] = luminance * sceneData->getFpScale() * _lightMeterScale;
+        } else {
+            _lightData[index] = luminance * exposure * _lightMeterScale;
+        }
+
+        index               = offset + 8;
+        _lightData[index++] = isSpotLight ? spotLight->getSize() : sphereLight->getSize();
+        _lightData[index++] = isSpotLight ? spotLight->getRange() : sphereLight->getRange();
+        _lightData[index]   = isSpotLight ? spotLight->getSpotAngle() : 0.F;
+
+        if (isSpotLight) {
+            index                 = offset + 12;
+            const auto &direction = spotLight->getDirection();
+            _lightData[index++]   = direction.x;
+            _lightData[index++]   = direction.y;
+            _lightData[index]     = direction.z;
+        }
+    }
+
+    gfx::BufferTextureCopy region;
+    region.texExtent = {ForwardCluster::LIGHT_TEXELS, lightCount, 1U};
+    const auto *data = reinterpret_cast<const uint8_t *>(_lightData.data());
+    cmdBuffer->copyBuffersToTexture(&data, _lightTexture, &region, 1);
+}
+
+void ClusterLightCulling::updateParams(const scene::Camera *camera, const gfx::Rect &renderArea) {
+    float *params = &_gridData[ForwardCluster::PARAMS_ROW * CLUSTERS_XY * 4];
+
+    params[ForwardCluster::PARAMS_SIZE_TEXEL * 4]          = static_cast<float>(ForwardCluster::CLUSTERS_X);
+    params[ForwardCluster::PARAMS_SIZE_TEXEL * 4 + 1]      = static_cast<float>(ForwardCluster::CLUSTERS_Y);
+    params[ForwardCluster::PARAMS_SIZE_TEXEL * 4 + 2]      = static_cast<float>(ForwardCluster::CLUSTERS_Z);
+    params[ForwardCluster::PARAMS_SIZE_TEXEL * 4 + 3]      = static_cast<float>(_validLights.size());
+    params[ForwardCluster::PARAMS_Z_TEXEL * 4]             = camera->getNearClip();
+    params[ForwardCluster::PARAMS_Z_TEXEL * 4 + 1]         = camera->getFarClip();
+    params[ForwardCluster::PARAMS_Z_TEXEL * 4 + 2]         = _sliceScale;
+    params[ForwardCluster::PARAMS_Z_TEXEL * 4 + 3]         = _sliceBias;
+    params[ForwardCluster::PARAMS_TILE_SIZE_TEXEL * 4]     = static_cast<float>(renderArea.width) / ForwardCluster::CLUSTERS_X;
+    params[ForwardCluster::PARAMS_TILE_SIZE_TEXEL * 4 + 1] = static_cast<float>(renderArea.height) / ForwardCluster::CLUSTERS_Y;
+    params[ForwardCluster::PARAMS_TILE_SIZE_TEXEL * 4 + 2] = static_cast<float>(ForwardCluster::INDEX_TEXTURE_WIDTH);
+}
+
+void ClusterLightCulling::uploadClusters(gfx::CommandBuffer *cmdBuffer) {
+    const uint rows = static_cast<uint>(_indexData.size()) / INDICES_PER_ROW;
+    if (rows > _indexRowCapacity) {
+        auto *texture     = _indexTexture;
+        _indexRowCapacity = nextPow2(rows);
+        _indexTexture     = createTexture(ForwardCluster::INDEX_TEXTURE_WIDTH, _indexRowCapacity, CLUSTERLIGHTINDICES::BINDING);
+        _pipeline->getGlobalDSManager()->update();
+        texture->destroy();
+        CC_DELETE(texture);
+    }
+
+    gfx::BufferTextureCopy region;
+    region.texExtent = {CLUSTERS_XY, ForwardCluster::CLUSTERS_Z + 1, 1U};
+    const auto *data = reinterpret_cast<const uint8_t *>(_gridData.data());
+    cmdBuffer->copyBuffersToTexture(&data, _gridTexture, &region, 1);
+
+    if (_lightIndexCount) {
+        region.texExtent = {ForwardCluster::INDEX_TEXTURE_WIDTH, rows, 1U};
+        data             = reinterpret_cast<const uint8_t *>(_indexData.data());
+        cmdBuffer->copyBuffersToTexture(&data, _indexTexture, &region, 1);
+    }
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "../Define.h"
+#include "base/CoreStd.h"
+#include "math/Mat4.h"
+#include "math/Vec3.h"
+
+namespace cc {
+namespace scene {
+class Camera;
+class Light;
+} // namespace scene
+namespace pipeline {
+
+class RenderPipeline;
+
+// CPU light culling for clustered forward shading.
+// Assigns the visible sphere and spot lights of a camera to a view space cluster grid (see ForwardCluster),
+// and uploads the light data, the per-cluster light lists and the grid parameters to the global descriptor set.
+// The cluster bounds are kept per camera, the textures are shared and refilled before each camera is drawn.
+class CC_DLL ClusterLightCulling : public Object {
+public:
+    explicit ClusterLightCulling(RenderPipeline *pipeline);
+    ~ClusterLightCulling() override;
+
+    void update(const scene::Camera *camera, const gfx::Rect &renderArea, gfx::CommandBuffer *cmdBuffer);
+    void destroy();
+
+    inline uint getLightCount() const { return static_cast<uint>(_validLights.size()); }
+    inline uint getLightIndexCount() const { return _lightIndexCount; }
+
+private:
+    static constexpr uint MAX_CAMERA_STATES = 8;
+
+    // cluster bounds only depend on the projection, so they are cached per camera
+    struct CameraState {
+        vector<Vec3> clusterMin;
+        vector<Vec3> clusterMax;
+        Mat4         proj;
+        float        nearClip{0.F};
+        float        farClip{0.F};
+        uint         lastUpdate{0U};
+    };
+
+    struct ClusterLight {
+        Vec3  center; // view space
+        float radius{0.F};
+        uint  sliceBegin{0U};
+        uint  sliceEnd{0U};
+    };
+
+    void gatherValidLights(const scene::Camera *camera);
+    void updateClusterBounds(const scene::Camera *camera);
+    void updateParams(const scene::Camera *camera, const gfx::Rect &renderArea);
+    void assignLights();
+    void assignSlice(uint z);
+    void uploadLights(const scene::Camera *camera, gfx::CommandBuffer *cmdBuffer);
+    void uploadClusters(gfx::CommandBuffer *cmdBuffer);
+
+    gfx::Texture *createTexture(uint width, uint height, uint binding);
+
+    RenderPipeline *                                  _pipeline = nullptr;
+    unordered_map<const scene::Camera *, CameraState> _cameraStates;
+    CameraState *                                     _state = nullptr; // of the camera being updated
+    vector<scene::Light *>                            _validLights;
+    vector<ClusterLight>                              _clusterLights;
+    vector<uint>                                      _clusterCounts;
+    vector<vector<uint>>                              _sliceLights;
+    vector<vector<uint>>                              _sliceIndices;
+    vector<float>                                     _lightData;
+    vector<float>                                     _gridData;
+    vector<float>                                     _indexData;
+
+    gfx::Texture *_lightTexture     = nullptr;
+    gfx::Texture *_gridTexture      = nullptr;
+    gfx::Texture *_indexTexture     = nullptr;
+    uint          _lightCapacity    = 64;
+    uint          _indexRowCapacity = 4;
+    uint          _lightIndexCount  = 0;
+    uint          _updateCount      = 0;
+    float         _lightMeterScale  = 10000.0F;
+    float         _sliceScale       = 0.F;
+    float         _sliceBias        = 0.F;
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -112,6 +112,7 @@ bool ForwardPipeline::initialize(const RenderPipelineInfo &info) {
 }
 
 bool ForwardPipeline::activate() {
+    _globalDSManager->setClusterLightBindings(_clusteredLighting);
     if (!RenderPipeline::activate()) {
         CC_LOG_ERROR("RenderPipeline active failed.");
         return false;
@@ -172,12 +173,25 @@ bool ForwardPipeline::activeRenderer() {
 
     _descriptorSet->update();
     // update global defines when all states initialized.
-    _macros["CC_USE_HDR"]               = _pipelineSceneData->isHDR();
-    _macros["CC_SUPPORT_FLOAT_TEXTURE"] = _device->hasFeature(gfx::Feature::TEXTURE_FLOAT);
+    _macros["CC_USE_HDR"]                        = _pipelineSceneData->isHDR();
+    _macros["CC_SUPPORT_FLOAT_TEXTURE"]          = _device->hasFeature(gfx::Feature::TEXTURE_FLOAT);
+    _macros["CC_ENABLE_CLUSTERED_LIGHT_CULLING"] = _clusteredLighting;
 
     return true;
 }
 
+void ForwardPipeline::setClusteredLighting(bool enabled) {
+    if (_descriptorSet) {
+        CC_LOG_WARNING("Clustered lighting has to be set before the pipeline is activated.");
+        return;
+    }
+    if (enabled && !_device->hasFeature(gfx::Feature::TEXTURE_FLOAT)) {
+        CC_LOG_WARNING("Clustered lighting requires float textures.");
+        enabled = false;
+    }
+    _clusteredLighting = enabled;
+}
+
 bool ForwardPipeline::destroy() {
     if (_descriptorSet) {
         _descriptorSet->getBuffer(UBOGlobal::BINDING)->destroy();
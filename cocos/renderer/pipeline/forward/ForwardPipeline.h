@@ -52,6 +52,13 @@ public:
     inline const UintList &       getLightIndexOffsets() const { return _lightIndexOffsets; }
     inline const UintList &       getLightIndices() const { return _lightIndices; }
 
+    // bins sphere and spot lights into a view space cluster grid every frame and uploads it to the
+    // cc_cluster* global textures, which are only part of the global layout while this is on.
+    // Must be set before activation. Programs see CC_ENABLE_CLUSTERED_LIGHT_CULLING and are expected to
+    // shade these lights from the grid in their base pass, so the additive light passes are skipped.
+    void        setClusteredLighting(bool enabled);
+    inline bool isClusteredLighting() const { return _clusteredLighting; }
+
 private:
     bool activeRenderer();
     void updateUBO(scene::Camera *);
@@ -62,6 +69,7 @@ private:
     UintList                                          _lightIndexOffsets;
     UintList                                          _lightIndices;
     unordered_map<gfx::ClearFlags, gfx::RenderPass *> _renderPasses;
+    bool                                              _clusteredLighting = false;
 };
 
 } // namespace pipeline
@@ -31,6 +31,7 @@
 #include "../RenderBatchedQueue.h"
 #include "../RenderInstancedQueue.h"
 #include "../RenderQueue.h"
+#include "ClusterLightCulling.h"
 #include "ForwardPipeline.h"
 #include "UIPhase.h"
 #include "gfx-base/GFXCommandBuffer.h"
@@ -97,6 +98,7 @@ void ForwardStage::destroy() {
     CC_SAFE_DELETE(_batchedQueue);
     CC_SAFE_DELETE(_instancedQueue);
     CC_SAFE_DELETE(_additiveLightQueue);
+    CC_SAFE_DELETE(_clusterLightCulling);
     CC_SAFE_DELETE(_planarShadowQueue);
     CC_SAFE_DELETE(_uiPhase);
     RenderStage::destroy();
@@ -152,7 +154,11 @@ void ForwardStage::render(scene::Camera *camera) {
 
     _instancedQueue->uploadBuffers(cmdBuff);
     _batchedQueue->uploadBuffers(cmdBuff);
-    _additiveLightQueue->gatherLightPasses(camera, cmdBuff);
+    // clustered lighting shades sphere and spot lights from the cluster grid in the base pass
+    const bool additiveLighting = !pipeline->isClusteredLighting();
+    if (additiveLighting) {
+        _additiveLightQueue->gatherLightPasses(camera, cmdBuff);
+    }
     _planarShadowQueue->gatherShadowPasses(camera, cmdBuff);
 
     // render area is not oriented
@@ -165,6 +171,13 @@ void ForwardStage::render(scene::Camera *camera) {
     _renderArea.width    = static_cast<uint>(viewPort.z * w * sceneData->getShadingScale());
     _renderArea.height   = static_cast<uint>(viewPort.w * h * sceneData->getShadingScale());
 
+    if (pipeline->isClusteredLighting()) {
+        if (!_clusterLightCulling) {
+            _clusterLightCulling = CC_NEW(ClusterLightCulling(_pipeline));
+        }
+        _clusterLightCulling->update(camera, _renderArea, cmdBuff);
+    }
+
     const auto &clearColor = camera->getClearColor();
     if (hasFlag(static_cast<gfx::ClearFlags>(camera->getClearFlag()), gfx::ClearFlagBit::COLOR)) {
         if (sceneData->isHDR()) {
@@ -190,10 +203,17 @@ void ForwardStage::render(scene::Camera *camera) {
     uint const globalOffsets[] = {_pipeline->getPipelineUBO()->getCurrentCameraUBOOffset()};
     cmdBuff->bindDescriptorSet(globalSet, _pipeline->getDescriptorSet(), static_cast<uint>(std::size(globalOffsets)), globalOffsets);
 
-    _renderQueues[0]->recordCommandBuffer(_device, renderPass, cmdBuff);
+    // The depth pre-pass shares the render pass, so the shading draws below test against its depth with EQUAL
+    const bool depthPrepass = camera->isDepthPrepass();
+    if (depthPrepass) {
+        _renderQueues[0]->recordDepthPrepass(_device, renderPass, cmdBuff);
+    }
+    _renderQueues[0]->recordCommandBuffer(_device, renderPass, cmdBuff, depthPrepass);
     _instancedQueue->recordCommandBuffer(_device, renderPass, cmdBuff);
     _batchedQueue->recordCommandBuffer(_device, renderPass, cmdBuff);
-    _additiveLightQueue->recordCommandBuffer(_device, renderPass, cmdBuff);
+    if (additiveLighting) {
+        _additiveLightQueue->recordCommandBuffer(_device, renderPass, cmdBuff);
+    }
     _planarShadowQueue->recordCommandBuffer(_device, renderPass, cmdBuff);
     _renderQueues[1]->recordCommandBuffer(_device, renderPass, cmdBuff);
     _uiPhase->render(camera, renderPass);
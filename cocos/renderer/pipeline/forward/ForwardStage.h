@@ -34,6 +34,7 @@ class RenderFlow;
 class RenderBatchedQueue;
 class RenderInstancedQueue;
 class RenderAdditiveLightQueue;
+class ClusterLightCulling;
 class PlanarShadowQueue;
 class ForwardPipeline;
 class UIPhase;
@@ -52,12 +53,13 @@ public:
 
 private:
     static RenderStageInfo    initInfo;
-    ForwardPipeline *         _forwrdPipeline     = nullptr;
-    PlanarShadowQueue *       _planarShadowQueue  = nullptr;
-    RenderBatchedQueue *      _batchedQueue       = nullptr;
-    RenderInstancedQueue *    _instancedQueue     = nullptr;
-    RenderAdditiveLightQueue *_additiveLightQueue = nullptr;
-    UIPhase *                 _uiPhase            = nullptr;
+    ForwardPipeline *         _forwrdPipeline      = nullptr;
+    PlanarShadowQueue *       _planarShadowQueue   = nullptr;
+    RenderBatchedQueue *      _batchedQueue        = nullptr;
+    RenderInstancedQueue *    _instancedQueue      = nullptr;
+    RenderAdditiveLightQueue *_additiveLightQueue  = nullptr;
+    ClusterLightCulling *     _clusterLightCulling = nullptr;
+    UIPhase *                 _uiPhase             = nullptr;
     gfx::Rect                 _renderArea;
     uint                      _phaseID = 0;
 };
@@ -25,6 +25,8 @@
 
 #include "ShadowFlow.h"
 
+#include <cstring>
+
 #include "../Define.h"
 #include "../SceneCulling.h"
 #include "../forward/ForwardPipeline.h"
@@ -33,6 +35,11 @@
 #include "gfx-base/GFXFramebuffer.h"
 #include "gfx-base/GFXRenderPass.h"
 #include "gfx-base/GFXTexture.h"
+#include "math/MathUtil.h"
+#include "scene/Model.h"
+#include "scene/Pass.h"
+#include "scene/SubModel.h"
+#include "scene/SpotLight.h"
 
 namespace cc::pipeline {
 std::unordered_map<uint, cc::gfx::RenderPass *> ShadowFlow::renderPassHashMap;
@@ -86,6 +93,10 @@ void ShadowFlow::render(scene::Camera *camera) {
             initShadowFrameBuffer(_pipeline, light);
         }
 
+        if (isShadowMapCached(light, camera)) {
+            continue;
+        }
+
         auto *shadowFrameBuffer = shadowFramebufferMap.at(light);
 
         for (auto *stage : _stages) {
@@ -100,7 +111,89 @@ void ShadowFlow::render(scene::Camera *camera) {
     _pipeline->getPipelineUBO()->updateShadowUBO(camera);
 }
 
+void ShadowFlow::setCachingEnabled(bool enabled) {
+    _cachingEnabled = enabled;
+    _shadowMapCache.clear();
+}
+
+bool ShadowFlow::isShadowMapCached(const scene::Light *light, const scene::Camera *camera) {
+    // The main light's shadow map follows the camera, only spot lights have a fixed projection
+    if (!_cachingEnabled || light->getType() != scene::LightType::SPOT) {
+        return false;
+    }
+
+    _casters.clear();
+    _casterTransforms.clear();
+    _casterPassHashes.clear();
+
+    // Same caster selection as ShadowMapBatchedQueue::gatherLightPasses
+    const auto *spotLight = static_cast<const scene::SpotLight *>(light);
+    const auto *sceneData = _pipeline->getPipelineSceneData();
+    for (const auto &ro : sceneData->getShadowObjects()) {
+        const auto *model       = ro.model;
+        const auto *worldBounds = model->getWorldBounds();
+        if (!worldBounds || (!worldBounds->aabbAabb(spotLight->getAABB()) && !worldBounds->aabbFrustum(spotLight->getFrustum()))) {
+            continue;
+        }
+
+        // Deforming casters change the shadow without moving their node
+        if (model->getType() != scene::Model::Type::DEFAULT || !model->getTransform()) {
+            _shadowMapCache.erase(light);
+            return false;
+        }
+
+        // Pass objects change when a material is swapped, their hashes when its defines or states change
+        size_t passHash = 0;
+        for (const auto &subModel : model->getSubModels()) {
+            for (const auto &pass : subModel->getPasses()) {
+                MathUtil::combineHash(passHash, std::hash<const scene::Pass *>()(pass.get()));
+                MathUtil::combineHash(passHash, static_cast<size_t>(pass->getHash()));
+            }
+        }
+
+        _casters.emplace_back(model);
+        _casterTransforms.emplace_back(model->getWorldMatrix());
+        _casterPassHashes.emplace_back(passHash);
+    }
+
+    const auto *shadow = sceneData->getShadow();
+    auto        iter   = _shadowMapCache.find(light);
+    if (iter != _shadowMapCache.end()) {
+        const auto &entry   = iter->second;
+        bool        matched = entry.casters == _casters &&
+                              entry.casterPassHashes == _casterPassHashes &&
+                              entry.position == spotLight->getPosition() &&
+                              entry.direction == spotLight->getDirection() &&
+                              entry.viewport == camera->getViewport() &&
+                              entry.shadowMapSize == shadow->getSize() &&
+                              entry.range == spotLight->getRange() &&
+                              entry.angle == spotLight->getAngle() &&
+                              entry.aspect == spotLight->getAspect();
+        for (size_t i = 0; matched && i < _casterTransforms.size(); ++i) {
+            matched = memcmp(entry.casterTransforms[i].m, _casterTransforms[i].m, sizeof(_casterTransforms[i].m)) == 0;
+        }
+        if (matched) {
+            return true;
+        }
+    }
+
+    auto &entry            = _shadowMapCache[light];
+    entry.casters          = _casters;
+    entry.casterTransforms = _casterTransforms;
+    entry.casterPassHashes = _casterPassHashes;
+    entry.position         = spotLight->getPosition();
+    entry.direction        = spotLight->getDirection();
+    entry.viewport         = camera->getViewport();
+    entry.shadowMapSize    = shadow->getSize();
+    entry.range            = spotLight->getRange();
+    entry.angle            = spotLight->getAngle();
+    entry.aspect           = spotLight->getAspect();
+    return false;
+}
+
 void ShadowFlow::clearShadowMap(scene::Camera *camera) {
+    _shadowMapCache.clear();
+
     auto *      sceneData            = _pipeline->getPipelineSceneData();
     const auto &shadowFramebufferMap = sceneData->getShadowFramebufferMap();
     for (const auto *light : _validLights) {
@@ -167,6 +260,7 @@ void ShadowFlow::resizeShadowMap() {
         });
     }
 
+    _shadowMapCache.clear();
     shadow->setShadowMapDirty(false);
 }
 
@@ -239,6 +333,7 @@ void ShadowFlow::initShadowFrameBuffer(RenderPipeline *pipeline, const scene::Li
     });
 
     pipeline->getPipelineSceneData()->setShadowFramebuffer(light, framebuffer);
+    _shadowMapCache.erase(light);
 }
 
 void ShadowFlow::destroy() {
@@ -254,6 +349,7 @@ void ShadowFlow::destroy() {
     _usedTextures.clear();
 
     _validLights.clear();
+    _shadowMapCache.clear();
 
     RenderFlow::destroy();
 }
@@ -26,10 +26,14 @@
 #pragma once
 
 #include "../RenderFlow.h"
+#include "math/Mat4.h"
 #include "scene/Define.h"
 #include "scene/Light.h"
 
 namespace cc {
+namespace scene {
+class Model;
+} // namespace scene
 namespace pipeline {
 class ForwardPipeline;
 
@@ -48,7 +52,29 @@ public:
 
     void destroy() override;
 
+    // Spot light shadow maps are re-rendered only when their casters, the light or the shadow map settings change.
+    // Off by default, uniform changes of a caster's material are not detected, see invalidateCache().
+    inline bool isCachingEnabled() const { return _cachingEnabled; }
+    void        setCachingEnabled(bool enabled);
+    // Forces every cached shadow map to be re-rendered next frame, e.g. after a caster's material has changed.
+    inline void invalidateCache() { _shadowMapCache.clear(); }
+
 private:
+    struct ShadowMapCacheEntry {
+        vector<const scene::Model *> casters;
+        vector<Mat4>                 casterTransforms;
+        vector<size_t>               casterPassHashes;
+        Vec3                         position;
+        Vec3                         direction;
+        Vec4                         viewport;
+        Vec2                         shadowMapSize;
+        float                        range{0.F};
+        float                        angle{0.F};
+        float                        aspect{0.F};
+    };
+
+    bool isShadowMapCached(const scene::Light *light, const scene::Camera *camera);
+
     void clearShadowMap(scene::Camera *camera);
 
     void resizeShadowMap();
@@ -62,6 +88,13 @@ private:
     vector<const scene::Light *> _validLights;
     vector<gfx::Texture *>       _usedTextures;
 
+    bool                                                          _cachingEnabled{false};
+    std::unordered_map<const scene::Light *, ShadowMapCacheEntry> _shadowMapCache;
+    // scratch lists of isShadowMapCached()
+    vector<const scene::Model *> _casters;
+    vector<Mat4>                 _casterTransforms;
+    vector<size_t>               _casterPassHashes;
+
     static std::unordered_map<uint, cc::gfx::RenderPass*> renderPassHashMap;
 };
 } // namespace pipeline
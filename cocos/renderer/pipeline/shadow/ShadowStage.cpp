@@ -71,8 +71,8 @@ void ShadowStage::render(scene::Camera *camera) {
     const auto &viewport      = camera->getViewport();
     _renderArea.x             = static_cast<int>(viewport.x * shadowMapSize.x);
     _renderArea.y             = static_cast<int>(viewport.y * shadowMapSize.y);
-    _renderArea.width         = static_cast<uint>(viewport.z * shadowMapSize.x * sceneData->getShadingScale());
-    _renderArea.height        = static_cast<int>(viewport.w * shadowMapSize.y * sceneData->getShadingScale());
+    _renderArea.width         = static_cast<uint>(viewport.z * shadowMapSize.x);
+    _renderArea.height        = static_cast<uint>(viewport.w * shadowMapSize.y);
 
     _clearColors[0]  = {1.0F, 1.0F, 1.0F, 1.0F};
     auto *renderPass = _framebuffer->getRenderPass();
@@ -93,6 +93,10 @@ bool Camera::initialize(const ICameraInfo &info) {
 }
 
 void Camera::destroy() {
+    // With frame pipelining the render thread may still be drawing the previous frame with it
+    if (auto *root = Root::getInstance()) {
+        root->waitForRender();
+    }
     if (_window) {
         _window->detachCamera(this);
         _window = nullptr;
@@ -136,7 +140,8 @@ void Camera::update(bool forceUpdate /*false*/) {
     bool viewProjDirty = false;
     // view matrix
     if (_node->getChangedFlags() || forceUpdate) {
-        _matView = _node->getWorldMatrix().getInversed();
+        _matViewInv = _node->getWorldMatrix();
+        _matView    = _matViewInv.getInversed();
         _forward.set(-_matView.m[2], -_matView.m[6], -_matView.m[10]);
 
         _position.set(_node->getWorldPosition());
@@ -214,6 +214,7 @@ public:
     inline uint32_t           getHeight() const { return _height; }
     inline float              getAspect() const { return _aspect; }
     inline const Mat4 &       getMatView() const { return _matView; }
+    inline const Mat4 &       getMatViewInv() const { return _matViewInv; }
     inline const Mat4 &       getMatProj() const { return _matProj; }
     inline const Mat4 &       getMatProjInv() const { return _matProjInv; }
     inline const Mat4 &       getMatViewProj() const { return _matViewProj; }
@@ -284,6 +285,10 @@ public:
     inline float getScreenScale() const { return _screenScale; }
     inline void  setScreenScale(float val) { _screenScale = val; }
 
+    // Lay down opaque depth before shading so that occluded fragments are not shaded
+    inline bool isDepthPrepass() const { return _depthPrepass; }
+    inline void setDepthPrepass(bool val) { _depthPrepass = val; }
+
     void detachCamera();
 
 protected:
@@ -311,6 +316,7 @@ private:
     gfx::SurfaceTransform _curTransform{gfx::SurfaceTransform::IDENTITY};
     bool                  _isProjDirty{true};
     Mat4                  _matView;
+    Mat4                  _matViewInv; // the node's world matrix as of the last update, the pipeline reads this instead of the node
     Mat4                  _matProj;
     Mat4                  _matProjInv;
     Mat4                  _matViewProj;
@@ -331,6 +337,7 @@ private:
     uint32_t              _height{0};
     gfx::ClearFlagBit     _clearFlag{gfx::ClearFlagBit::NONE};
     float                 _clearDepth{1.0F};
+    bool                  _depthPrepass{false};
 
     static const std::vector<float> FSTOPS;
     static const std::vector<float> SHUTTERS;
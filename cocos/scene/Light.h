@@ -29,6 +29,8 @@
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
 #include "core/scene-graph/Node.h"
+#include "math/Mat4.h"
+#include "math/Quaternion.h"
 #include "math/Vec3.h"
 
 namespace cc {
@@ -78,6 +80,16 @@ public:
     inline Node *getNode() const { return _node.get(); }
     inline void  setNode(Node *node) { _node = node; }
 
+    // The node's transform as of the last scene update, the pipeline reads these instead of the node
+    inline const Mat4 &      getWorldMatrix() const { return _worldMatrix; }
+    inline const Quaternion &getWorldRotation() const { return _worldRotation; }
+    inline void              syncWorldTransform() {
+        if (_node) {
+            _worldMatrix   = _node->getWorldMatrix();
+            _worldRotation = _node->getWorldRotation();
+        }
+    }
+
     inline LightType getType() const { return _type; }
 
     inline const std::string &getName() const { return _name; }
@@ -101,6 +113,8 @@ protected:
     Vec3            _color{1, 1, 1};
     Vec3            _colorTemperatureRGB;
     Vec3            _forward{0, 0, -1};
+    Mat4            _worldMatrix;
+    Quaternion      _worldRotation;
 
 private:
     CC_DISALLOW_COPY_MOVE_ASSIGN(Light);
@@ -25,6 +25,7 @@
 #include <array>
 
 #include "core/Director.h"
+#include "core/Root.h"
 #include "core/TypedArray.h"
 #include "core/assets/Material.h"
 #include "core/event/EventTypesToJS.h"
@@ -124,6 +125,10 @@ void Model::initialize() {
 }
 
 void Model::destroy() {
+    // With frame pipelining the render thread may still be drawing the previous frame with it
+    if (auto *root = Root::getInstance()) {
+        root->waitForRender();
+    }
     for (SubModel *subModel : _subModels) {
         CC_SAFE_DESTROY(subModel);
     }
@@ -176,6 +181,15 @@ void Model::updateTransform(uint32_t stamp) {
     }
 }
 
+void Model::syncRenderData() {
+    if (_transform) {
+        _worldMatrix = _transform->getWorldMatrix();
+    }
+    if (_node) {
+        _nodeLayer = _node->getLayer();
+    }
+}
+
 void Model::updateWorldBound() {
     Node *node = _transform;
     if (node) {
@@ -249,6 +263,9 @@ SubModel *Model::createSubModel() {
 }
 
 void Model::initSubModel(index_t idx, cc::RenderingSubMesh *subMeshData, Material *mat) {
+    if (auto *root = Root::getInstance()) {
+        root->waitForRender();
+    }
     initialize();
     bool isNewSubModel = false;
     if (idx >= _subModels.size()) {
@@ -268,12 +285,18 @@ void Model::initSubModel(index_t idx, cc::RenderingSubMesh *subMeshData, Materia
 }
 
 void Model::setSubModelMesh(index_t idx, cc::RenderingSubMesh *subMesh) const {
+    if (auto *root = Root::getInstance()) {
+        root->waitForRender();
+    }
     if (idx < _subModels.size()) {
         _subModels[idx]->setSubMesh(subMesh);
     }
 }
 
 void Model::setSubModelMaterial(index_t idx, Material *mat) {
+    if (auto *root = Root::getInstance()) {
+        root->waitForRender();
+    }
     if (idx < _subModels.size()) {
         _subModels[idx]->setPasses(mat->getPasses());
         updateAttributesAndBinding(idx);
@@ -281,12 +304,18 @@ void Model::setSubModelMaterial(index_t idx, Material *mat) {
 }
 
 void Model::onGlobalPipelineStateChanged() const {
+    if (auto *root = Root::getInstance()) {
+        root->waitForRender();
+    }
     for (SubModel *subModel : _subModels) {
         subModel->onPipelineStateChanged();
     }
 }
 
 void Model::onMacroPatchesStateChanged() {
+    if (auto *root = Root::getInstance()) {
+        root->waitForRender();
+    }
     for (index_t i = 0; i < _subModels.size(); ++i) {
         _subModels[i]->onMacroPatchesStateChanged(getMacroPatches(i));
     }
@@ -92,6 +92,7 @@ public:
     virtual void                      updateInstancedAttributes(const std::vector<gfx::Attribute> &attributes, Pass *pass);
 
     virtual void updateTransform(uint32_t stamp);
+    void         syncRenderData();
     virtual void updateUBOs(uint32_t stamp);
 
     inline void attachToScene(RenderScene *scene) { _scene = scene; };
@@ -133,6 +134,8 @@ public:
     inline uint32_t                                getUpdateStamp() const { return _updateStamp; }
     inline Layers::Enum                            getVisFlags() const { return _visFlags; }
     inline geometry::AABB *                        getWorldBounds() const { return _worldBounds; }
+    inline const Mat4 &                            getWorldMatrix() const { return _worldMatrix; }
+    inline uint32_t                                getNodeLayer() const { return _nodeLayer; }
     inline Type                                    getType() const { return _type; };
     inline void                                    setType(Type type) { _type = type; }
 
@@ -177,6 +180,8 @@ protected:
     int32_t                          _instMatWorldIdx{-1};
     Layers::Enum                     _visFlags{Layers::Enum::NONE};
     uint32_t                         _updateStamp{0};
+    Mat4                             _worldMatrix; // the transform's world matrix as of the last scene update, the pipeline reads this instead of the node
+    uint32_t                         _nodeLayer{0}; // the node's layer as of the last scene update
     SharedPtr<Node>                  _transform;
     SharedPtr<Node>                  _node;
     Float32Array                     _localData;
@@ -30,6 +30,7 @@
 #include <vector>
 #include "base/RefCounted.h"
 #include "base/TypeDef.h"
+#include "base/memory/SlabAllocator.h"
 #include "core/ArrayBuffer.h"
 #include "core/assets/EffectAsset.h"
 #include "renderer/core/PassUtils.h"
@@ -67,6 +68,8 @@ struct IBlockRef {
 
 class Pass : public RefCounted {
 public:
+    CC_SLAB_ALLOCATED(Pass)
+
     /**
      * @en The binding type enums of the property
      * @zh Uniform 的绑定类型（UBO 或贴图等）
@@ -30,6 +30,7 @@
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "core/Root.h"
 #include "core/scene-graph/Node.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
@@ -43,6 +44,15 @@
 namespace cc {
 namespace scene {
 
+namespace {
+// With frame pipelining the render thread may still be walking these lists for the previous frame
+void waitForRender() {
+    if (auto *root = Root::getInstance()) {
+        root->waitForRender();
+    }
+}
+} // namespace
+
 bool RenderScene::initialize(const IRenderSceneInfo &info) {
     _name = info.name;
     return true;
@@ -53,22 +63,30 @@ void RenderScene::update(uint32_t stamp) {
 
     if (_mainLight) {
         _mainLight->update();
+        _mainLight->syncWorldTransform();
+    }
+    for (const auto &light : _directionalLights) {
+        light->syncWorldTransform();
     }
     for (const auto &light : _sphereLights) {
         light->update();
+        light->syncWorldTransform();
     }
     for (const auto &spotLight : _spotLights) {
         spotLight->update();
+        spotLight->syncWorldTransform();
     }
     for (const auto &model : _models) {
         if (model->isEnabled()) {
             model->updateTransform(stamp);
+            model->syncRenderData();
             model->updateUBOs(stamp);
         }
     }
 }
 
 void RenderScene::destroy() {
+    waitForRender();
     removeCameras();
     removeSphereLights();
     removeSpotLights();
@@ -76,11 +94,13 @@ void RenderScene::destroy() {
 }
 
 void RenderScene::addCamera(Camera *camera) {
+    waitForRender();
     camera->attachToScene(this);
     _cameras.emplace_back(camera);
 }
 
 void RenderScene::removeCamera(Camera *camera) {
+    waitForRender();
     auto iter = std::find(_cameras.begin(), _cameras.end(), camera);
     if (iter != _cameras.end()) {
         _cameras.erase(iter);
@@ -88,6 +108,7 @@ void RenderScene::removeCamera(Camera *camera) {
 }
 
 void RenderScene::removeCameras() {
+    waitForRender();
     for (const auto &camera : _cameras) {
         camera->detachFromScene();
     }
@@ -95,6 +116,7 @@ void RenderScene::removeCameras() {
 }
 
 void RenderScene::unsetMainLight(DirectionalLight *dl) {
+    waitForRender();
     if (_mainLight == dl) {
         const auto &dlList = _directionalLights;
         if (!dlList.empty()) {
@@ -109,12 +131,19 @@ void RenderScene::unsetMainLight(DirectionalLight *dl) {
     }
 }
 
+void RenderScene::setMainLight(DirectionalLight *dl) {
+    waitForRender();
+    _mainLight = dl;
+}
+
 void RenderScene::addDirectionalLight(DirectionalLight *dl) {
+    waitForRender();
     dl->attachToScene(this);
     _directionalLights.emplace_back(dl);
 }
 
 void RenderScene::removeDirectionalLight(DirectionalLight *dl) {
+    waitForRender();
     auto iter = std::find(_directionalLights.begin(), _directionalLights.end(), dl);
     if (iter != _directionalLights.end()) {
         (*iter)->detachFromScene();
@@ -124,10 +153,12 @@ void RenderScene::removeDirectionalLight(DirectionalLight *dl) {
 }
 
 void RenderScene::addSphereLight(SphereLight *light) {
+    waitForRender();
     _sphereLights.emplace_back(light);
 }
 
 void RenderScene::removeSphereLight(SphereLight *sphereLight) {
+    waitForRender();
     auto iter = std::find(_sphereLights.begin(), _sphereLights.end(), sphereLight);
     if (iter != _sphereLights.end()) {
         _sphereLights.erase(iter);
@@ -137,10 +168,12 @@ void RenderScene::removeSphereLight(SphereLight *sphereLight) {
 }
 
 void RenderScene::addSpotLight(SpotLight *spotLight) {
+    waitForRender();
     _spotLights.emplace_back(spotLight);
 }
 
 void RenderScene::removeSpotLight(SpotLight *spotLight) {
+    waitForRender();
     auto iter = std::find(_spotLights.begin(), _spotLights.end(), spotLight);
     if (iter != _spotLights.end()) {
         _spotLights.erase(iter);
@@ -150,6 +183,7 @@ void RenderScene::removeSpotLight(SpotLight *spotLight) {
 }
 
 void RenderScene::removeSphereLights() {
+    waitForRender();
     for (const auto &sphereLight : _sphereLights) {
         sphereLight->detachFromScene();
     }
@@ -157,6 +191,7 @@ void RenderScene::removeSphereLights() {
 }
 
 void RenderScene::removeSpotLights() {
+    waitForRender();
     for (const auto &spotLight : _spotLights) {
         spotLight->detachFromScene();
     }
@@ -164,11 +199,13 @@ void RenderScene::removeSpotLights() {
 }
 
 void RenderScene::addModel(Model *model) {
+    waitForRender();
     model->attachToScene(this);
     _models.emplace_back(model);
 }
 
 void RenderScene::removeModel(index_t idx) {
+    waitForRender();
     if (idx >= static_cast<index_t>(_models.size())) {
         CC_LOG_WARNING("Try to remove invalid model.");
         return;
@@ -177,6 +214,7 @@ void RenderScene::removeModel(index_t idx) {
 }
 
 void RenderScene::removeModel(Model *model) {
+    waitForRender();
     auto iter = std::find(_models.begin(), _models.end(), model);
     if (iter != _models.end()) {
         model->detachFromScene();
@@ -187,6 +225,7 @@ void RenderScene::removeModel(Model *model) {
 }
 
 void RenderScene::removeModels() {
+    waitForRender();
     for (const auto &model : _models) {
         model->detachFromScene();
         CC_SAFE_DESTROY(model);
@@ -194,10 +233,12 @@ void RenderScene::removeModels() {
     _models.clear();
 }
 void RenderScene::addBatch(DrawBatch2D *drawBatch2D) {
+    waitForRender();
     _batches.emplace_back(drawBatch2D);
 }
 
 void RenderScene::removeBatch(DrawBatch2D *drawBatch2D) {
+    waitForRender();
     auto iter = std::find(_batches.begin(), _batches.end(), drawBatch2D);
     if (iter != _batches.end()) {
         _batches.erase(iter);
@@ -207,10 +248,12 @@ void RenderScene::removeBatch(DrawBatch2D *drawBatch2D) {
 }
 
 void RenderScene::removeBatches() {
+    waitForRender();
     _batches.clear();
 }
 
 void RenderScene::onGlobalPipelineStateChanged() {
+    waitForRender();
     for (const auto &model : _models) {
         model->onGlobalPipelineStateChanged();
     }
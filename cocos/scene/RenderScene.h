@@ -92,7 +92,7 @@ public:
     void onGlobalPipelineStateChanged();
 
     inline DirectionalLight *getMainLight() const { return _mainLight.get(); }
-    inline void              setMainLight(DirectionalLight *dl) { _mainLight = dl; }
+    void                     setMainLight(DirectionalLight *dl);
 
     inline uint64_t                                   generateModelId() { return _modelId++; }
     inline const std::string &                        getName() const { return _name; }
@@ -23,8 +23,10 @@
  THE SOFTWARE.
  ****************************************************************************/
 #include "scene/SubModel.h"
+#include <algorithm>
 #include "core/Root.h"
 #include "pipeline/Define.h"
+#include "renderer/core/ProgramLib.h"
 #include "renderer/pipeline/forward/ForwardPipeline.h"
 #include "scene/Model.h"
 #include "scene/Pass.h"
@@ -64,6 +66,29 @@ gfx::Shader *SubModel::getShader(uint index) const {
     return _shaders[index];
 }
 
+gfx::Shader *SubModel::getDepthPrepassShader(uint index) {
+    if (index >= _passes.size()) {
+        return nullptr;
+    }
+
+    if (_depthPrepassShaders.size() != _passes.size()) {
+        _depthPrepassShaders.assign(_passes.size(), nullptr);
+        _depthPrepassChecked.assign(_passes.size(), false);
+    }
+    if (!_depthPrepassChecked[index]) {
+        _depthPrepassChecked[index] = true;
+        // Effects without the define would compile the full shader again, they skip the pre-pass instead
+        const auto *tmpl = ProgramLib::getInstance()->getTemplate(_passes[index]->getProgram());
+        if (tmpl && std::any_of(tmpl->defines.begin(), tmpl->defines.end(), [](const IDefineRecord &define) { return define.name == "CC_DEPTH_PREPASS"; })) {
+            std::vector<IMacroPatch> patches = _patches;
+            patches.push_back({"CC_DEPTH_PREPASS", true});
+            _depthPrepassShaders[index] = _passes[index]->getShaderVariant(patches);
+        }
+    }
+
+    return _depthPrepassShaders[index];
+}
+
 Pass *SubModel::getPass(uint index) const {
     if (index >= _passes.size()) {
         return nullptr;
@@ -161,6 +186,8 @@ void SubModel::destroy() {
     _subMesh = nullptr;
     _passes.clear();
     _shaders.clear();
+    _depthPrepassShaders.clear();
+    _depthPrepassChecked.clear();
 
     CC_SAFE_DESTROY_NULL(_reflectionTex);
     CC_SAFE_DESTROY_NULL(_reflectionSampler);
@@ -197,6 +224,8 @@ void SubModel::flushPassInfo() {
     for (uint i = 0; i < _passes.size(); ++i) {
         _shaders[i] = _passes[i]->getShaderVariant(_patches);
     }
+    _depthPrepassShaders.clear();
+    _depthPrepassChecked.clear();
 }
 
 void SubModel::setSubMesh(RenderingSubMesh *subMesh) {
@@ -27,6 +27,7 @@
 
 #include <vector>
 #include "base/RefCounted.h"
+#include "base/memory/SlabAllocator.h"
 #include "core/assets/RenderingSubMesh.h"
 #include "renderer/gfx-base/GFXDescriptorSet.h"
 #include "renderer/gfx-base/GFXInputAssembler.h"
@@ -39,6 +40,8 @@ namespace scene {
 class Pass;
 class SubModel : public RefCounted {
 public:
+    CC_SLAB_ALLOCATED(SubModel)
+
     SubModel()           = default;
     ~SubModel() override = default;
 
@@ -46,6 +49,9 @@ public:
 
     gfx::Shader *getShader(uint) const;
     Pass *       getPass(uint) const;
+    // Position-only variant of the pass shader, compiled on first use by the depth pre-pass.
+    // Null if the effect doesn't handle CC_DEPTH_PREPASS, the pass is then shaded without a pre-pass.
+    gfx::Shader *getDepthPrepassShader(uint);
 
     inline void setDescriptorSet(gfx::DescriptorSet *descriptorSet) { _descriptorSet = descriptorSet; }
     inline void setInputAssembler(gfx::InputAssembler *ia) { _inputAssembler = ia; }
@@ -89,6 +95,9 @@ protected:
     std::vector<SharedPtr<Pass>>        _passes;
     std::vector<SharedPtr<gfx::Shader>> _shaders;
 
+    std::vector<SharedPtr<gfx::Shader>> _depthPrepassShaders;
+    std::vector<bool>                   _depthPrepassChecked;
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(SubModel);
 };
 
@@ -0,0 +1,75 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <vector>
+#include "cocos/2d/assembler/LabelAssembler.h"
+#include "cocos/2d/assembler/SpriteAssembler.h"
+#include "cocos/2d/framework/UIRenderer.h"
+#include "cocos/math/Color.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+constexpr uint32_t STRIDE = cc::UIRenderer::VERTEX_FLOATS;
+
+bool vertexEquals(const std::vector<float> &vertices, uint32_t index, float x, float y, float u, float v) {
+    const float *vertex = vertices.data() + index * STRIDE;
+    return IsEqualF(vertex[0], x) && IsEqualF(vertex[1], y) && IsEqualF(vertex[3], u) && IsEqualF(vertex[4], v);
+}
+} // namespace
+
+TEST(assembler2DTest, test1) {
+    logLabel = "simple sprites are one quad around the anchor";
+    cc::UIRenderer renderer;
+    cc::SpriteAssembler::fillSimple(&renderer, cc::Size(100.F, 50.F), cc::Vec2(0.5F, 0.F), cc::Vec4(0.F, 0.F, 0.5F, 1.F), cc::Color(255, 0, 0, 255));
+    const auto &vertices = renderer.getVertices();
+    ExpectEq(renderer.getVertexCount() == 4 && renderer.getIndices().size() == 6, true);
+    ExpectEq(vertexEquals(vertices, 0, -50.F, 0.F, 0.F, 0.F), true);
+    ExpectEq(vertexEquals(vertices, 3, 50.F, 50.F, 0.5F, 1.F), true);
+    ExpectEq(IsEqualF(vertices[5], 1.F) && IsEqualF(vertices[6], 0.F) && IsEqualF(vertices[8], 1.F), true);
+
+    logLabel = "sliced sprites keep their borders and shrink them when they don't fit";
+    cc::SpriteAssembler::fillSliced(&renderer, cc::Size(100.F, 100.F), cc::Vec2(0.F, 0.F), cc::Vec4(0.F, 0.F, 1.F, 1.F), cc::Vec4(10.F, 10.F, 10.F, 10.F), cc::Size(40.F, 40.F), cc::Color(255, 255, 255, 255));
+    ExpectEq(renderer.getVertexCount() == 16 && renderer.getIndices().size() == 54, true);
+    ExpectEq(vertexEquals(renderer.getVertices(), 5, 10.F, 10.F, 0.25F, 0.25F), true);
+    ExpectEq(vertexEquals(renderer.getVertices(), 10, 90.F, 90.F, 0.75F, 0.75F), true);
+    cc::SpriteAssembler::fillSliced(&renderer, cc::Size(10.F, 100.F), cc::Vec2(0.F, 0.F), cc::Vec4(0.F, 0.F, 1.F, 1.F), cc::Vec4(10.F, 10.F, 10.F, 10.F), cc::Size(40.F, 40.F), cc::Color(255, 255, 255, 255));
+    ExpectEq(vertexEquals(renderer.getVertices(), 5, 5.F, 10.F, 0.25F, 0.25F), true);
+}
+
+TEST(assembler2DTest, test2) {
+    logLabel = "ttf labels flip v for the top-down label texture";
+    cc::UIRenderer renderer;
+    cc::LabelAssembler::fillTTF(&renderer, cc::Size(20.F, 10.F), cc::Vec2(0.F, 0.F), cc::Color(255, 255, 255, 255));
+    ExpectEq(vertexEquals(renderer.getVertices(), 0, 0.F, 0.F, 0.F, 1.F), true);
+    ExpectEq(vertexEquals(renderer.getVertices(), 3, 20.F, 10.F, 1.F, 0.F), true);
+
+    logLabel = "bitmap font labels draw one quad per glyph";
+    std::vector<cc::Vec4> rects{{0.F, 0.F, 8.F, 12.F}, {8.F, 0.F, 6.F, 12.F}};
+    std::vector<cc::Vec4> uvs{{0.F, 0.F, 0.25F, 0.5F}, {0.25F, 0.F, 0.5F, 0.5F}};
+    cc::LabelAssembler::fillBitmapFont(&renderer, rects, uvs, cc::Color(255, 255, 255, 128));
+    const auto &indices = renderer.getIndices();
+    ExpectEq(renderer.getVertexCount() == 8 && indices.size() == 12, true);
+    ExpectEq(vertexEquals(renderer.getVertices(), 7, 14.F, 12.F, 0.5F, 0.5F), true);
+    ExpectEq(indices[6] == 4 && indices[10] == 7, true);
+}
@@ -0,0 +1,63 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/2d/renderer/SkylinePacker.h"
+#include "utils.h"
+
+TEST(skylinePackerTest, test1) {
+    logLabel = "rectangles are placed along the bottom edge first";
+    cc::SkylinePacker packer(64, 64);
+    uint x = 0;
+    uint y = 0;
+    ExpectEq(packer.insert(32, 16, &x, &y), true);
+    ExpectEq(x == 0 && y == 0, true);
+    ExpectEq(packer.insert(32, 8, &x, &y), true);
+    ExpectEq(x == 32 && y == 0, true);
+
+    logLabel = "the next rectangle goes where it ends lowest";
+    ExpectEq(packer.insert(32, 8, &x, &y), true);
+    ExpectEq(x == 32 && y == 8, true);
+    ExpectEq(packer.getUsedArea() == 32 * 16 + 32 * 8 * 2, true);
+
+    logLabel = "rectangles larger than the bin are rejected";
+    ExpectEq(packer.insert(65, 1, &x, &y), false);
+    ExpectEq(packer.insert(1, 65, &x, &y), false);
+}
+
+TEST(skylinePackerTest, test2) {
+    logLabel = "a full bin rejects insertions until it is reset";
+    cc::SkylinePacker packer(32, 32);
+    uint x = 0;
+    uint y = 0;
+    for (int i = 0; i < 16; ++i) {
+        ExpectEq(packer.insert(8, 8, &x, &y), true);
+    }
+    ExpectEq(packer.getUsedArea() == 32 * 32, true);
+    ExpectEq(packer.insert(8, 8, &x, &y), false);
+
+    packer.reset();
+    ExpectEq(packer.getUsedArea() == 0, true);
+    ExpectEq(packer.insert(32, 32, &x, &y), true);
+    ExpectEq(x == 0 && y == 0, true);
+}
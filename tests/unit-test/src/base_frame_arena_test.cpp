@@ -0,0 +1,69 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include <cstdint>
+#include "cocos/base/memory/FrameArena.h"
+#include "utils.h"
+
+TEST(frameArenaTest, test1) {
+    logLabel = "allocations are aligned and don't overlap";
+    cc::FrameArena arena(256);
+    auto *         a = arena.allocate<uint8_t>(3);
+    auto *         b = arena.allocate<double>(4);
+    auto *         c = arena.allocate<uint8_t>(1000); // bigger than a block
+    ExpectEq(reinterpret_cast<uintptr_t>(b) % alignof(double) == 0, true);
+    ExpectEq(reinterpret_cast<uint8_t *>(b) >= a + 3, true);
+    ExpectEq(c != nullptr && arena.getCapacity() >= 1256, true);
+}
+
+TEST(frameArenaTest, test2) {
+    logLabel = "memory stays valid for one more frame and is coalesced on reuse";
+    cc::FrameArena arena(256);
+    auto *         first = arena.allocate<int>(100);
+    first[99]            = 42;
+    arena.allocate<int>(200);
+    const auto grownCapacity = arena.getCapacity();
+
+    arena.nextFrame();
+    auto *second = arena.allocate<int>(10);
+    ExpectEq(first[99] == 42, true);
+    ExpectEq(reinterpret_cast<uint8_t *>(second) + 10 * sizeof(int) <= reinterpret_cast<uint8_t *>(first) ||
+                 reinterpret_cast<uint8_t *>(second) >= reinterpret_cast<uint8_t *>(first + 100),
+             true);
+
+    arena.nextFrame();
+    ExpectEq(arena.getUsedSize() == 0 && arena.getCapacity() == grownCapacity, true);
+}
+
+TEST(frameArenaTest, test3) {
+    logLabel = "frame vectors work as std::vector";
+    cc::FrameArena       arena;
+    cc::FrameVector<int> numbers{cc::FrameAllocator<int>(&arena)};
+    for (int i = 0; i < 1000; ++i) {
+        numbers.push_back(i);
+    }
+    cc::FrameVector<int> moved;
+    moved = std::move(numbers);
+    ExpectEq(moved.size() == 1000 && moved[999] == 999 && moved.get_allocator().getArena() == &arena, true);
+}
@@ -0,0 +1,103 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "cocos/base/threading/ThreadSafeGrowableLinearAllocator.h"
+#include "utils.h"
+
+TEST(growableLinearAllocatorTest, test1) {
+    logLabel = "threads allocate disjoint memory and the allocator grows as needed";
+    constexpr uint32_t threadCount     = 8;
+    constexpr uint32_t allocationCount = 2000;
+
+    cc::ThreadSafeGrowableLinearAllocator allocator(4096);
+    std::vector<std::vector<uint32_t *>>  results(threadCount);
+    std::vector<std::thread>              threads;
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint32_t i = 0; i < allocationCount; ++i) {
+                auto *data = allocator.allocate<uint32_t>(1 + i % 7, alignof(uint32_t));
+                for (uint32_t j = 0; j < 1 + i % 7; ++j) {
+                    data[j] = t;
+                }
+                results[t].push_back(data);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    bool   intact   = true;
+    size_t usedSize = 0;
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        for (uint32_t i = 0; i < allocationCount; ++i) {
+            for (uint32_t j = 0; j < 1 + i % 7; ++j) {
+                intact = intact && results[t][i][j] == t;
+                usedSize += sizeof(uint32_t);
+            }
+        }
+    }
+    ExpectEq(intact, true);
+    ExpectEq(allocator.getUsedSize() == usedSize, true);
+}
+
+TEST(growableLinearAllocatorTest, test2) {
+    logLabel = "recycling reuses the blocks and tracks the peak usage";
+    cc::ThreadSafeGrowableLinearAllocator allocator(1024);
+    for (uint32_t i = 0; i < 10; ++i) {
+        allocator.allocate<uint8_t>(512);
+    }
+    auto *large = allocator.allocate<uint64_t>(1000, alignof(uint64_t));
+    ExpectEq(large != nullptr && reinterpret_cast<uintptr_t>(large) % alignof(uint64_t) == 0, true);
+    const size_t capacity = allocator.getCapacity();
+
+    allocator.recycle();
+    ExpectEq(allocator.getUsedSize() == 0 && allocator.getPeakUsedSize() == 5120 + 8000, true);
+    ExpectEq(allocator.getCapacity() == capacity - 8000 - alignof(uint64_t) + 1, true);
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        allocator.allocate<uint8_t>(512);
+    }
+    ExpectEq(allocator.getCapacity() == capacity - 8000 - alignof(uint64_t) + 1, true);
+}
+
+TEST(growableLinearAllocatorTest, test3) {
+    logLabel = "a thread keeps its state when it uses more allocators than it caches";
+    std::vector<std::unique_ptr<cc::ThreadSafeGrowableLinearAllocator>> allocators;
+    for (uint32_t i = 0; i < 8; ++i) {
+        allocators.emplace_back(std::make_unique<cc::ThreadSafeGrowableLinearAllocator>(1024));
+    }
+    for (uint32_t round = 0; round < 3; ++round) {
+        for (auto &allocator : allocators) {
+            allocator->allocate<uint8_t>(16);
+        }
+    }
+    for (auto &allocator : allocators) {
+        ExpectEq(allocator->getCapacity() == 1024 && allocator->getUsedSize() == 48, true);
+    }
+}
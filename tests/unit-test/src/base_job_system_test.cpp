@@ -0,0 +1,108 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include <atomic>
+#include <vector>
+#include "cocos/base/job-system/JobSystem.h"
+#include "utils.h"
+
+TEST(jobSystemTest, test1) {
+    logLabel = "edges order jobs and for-each jobs visit every index once";
+    std::vector<uint> visits(1000, 0U);
+    std::atomic<int>  order{0};
+    int               before = -1;
+    int               after  = -1;
+    uint              sum    = 0U;
+
+    cc::JobGraph g(cc::JobSystem::getInstance());
+    uint first   = g.createJob([&]() { before = order++; });
+    uint forEach = g.createForEachIndexJob(0U, 1000U, 1U, [&](uint i) { visits[i]++; });
+    uint last    = g.createJob([&]() {
+        after = order++;
+        for (uint v : visits) sum += v;
+    });
+    g.makeEdge(first, forEach);
+    g.makeEdge(forEach, last);
+    g.run();
+    g.waitForAll();
+
+    ExpectEq(before == 0 && after == 1, true);
+    ExpectEq(sum == 1000U, true);
+}
+
+TEST(jobSystemTest, test2) {
+    logLabel = "strided for-each jobs only visit the strided indices";
+    std::vector<uint> visits(100, 0U);
+    cc::JobGraph      g(cc::JobSystem::getInstance());
+    g.createForEachIndexJob(1U, 100U, 3U, [&](uint i) { visits[i]++; });
+    g.run();
+    g.waitForAll();
+
+    bool expected = true;
+    for (uint i = 0U; i < 100U; ++i) {
+        expected = expected && visits[i] == (i % 3U == 1U ? 1U : 0U);
+    }
+    ExpectEq(expected, true);
+}
+
+#if CC_JOB_SYSTEM == CC_JOB_SYSTEM_NATIVE
+TEST(jobSystemTest, test3) {
+    logLabel = "the native job system runs dependent graphs on its own workers";
+    cc::NativeJobSystem system(4U);
+    ExpectEq(system.threadCount() == 4U, true);
+
+    bool expected = true;
+    for (uint round = 0U; round < 100U; ++round) {
+        std::vector<uint> values(256, 0U);
+        std::atomic<uint> total{0U};
+
+        cc::NativeJobGraph g(&system);
+        uint fill  = g.createForEachIndexJob(0U, 256U, 1U, [&](uint i) { values[i] = i; });
+        uint left  = g.createForEachIndexJob(0U, 128U, 1U, [&](uint i) { total += values[i]; });
+        uint right = g.createForEachIndexJob(128U, 256U, 1U, [&](uint i) { total += values[i]; });
+        uint check = g.createJob([&]() { expected = expected && total == 255U * 256U / 2U; });
+        g.makeEdge(fill, left);
+        g.makeEdge(fill, right);
+        g.makeEdge(left, check);
+        g.makeEdge(right, check);
+        g.run();
+        g.waitForAll();
+    }
+    ExpectEq(expected, true);
+
+    logLabel = "several native graphs can be in flight at once";
+    std::atomic<uint> counter{0U};
+    {
+        cc::NativeJobGraph g1(&system);
+        cc::NativeJobGraph g2(&system);
+        g1.createForEachIndexJob(0U, 1000U, 1U, [&](uint /*i*/) { ++counter; });
+        g2.createForEachIndexJob(0U, 1000U, 1U, [&](uint /*i*/) { ++counter; });
+        g1.run();
+        g2.run();
+        g2.waitForAll();
+        g1.waitForAll();
+    }
+    ExpectEq(counter == 2000U, true);
+}
+#endif
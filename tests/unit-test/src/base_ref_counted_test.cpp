@@ -0,0 +1,83 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "cocos/base/DeferredReleasePool.h"
+#include "cocos/base/RefCounted.h"
+#include "utils.h"
+
+namespace {
+std::atomic<int> destroyedNum{0};
+
+class SharedObject final : public cc::RefCounted {
+public:
+    SharedObject() { enableThreadSafeRefCount(); }
+    ~SharedObject() override { ++destroyedNum; }
+};
+} // namespace
+
+TEST(refCountedTest, test1) {
+    logLabel = "thread safe counts survive concurrent retains and releases";
+    cc::DeferredReleasePool::setMainThread();
+    auto *object = new SharedObject();
+    object->addRef();
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 4; ++i) {
+        workers.emplace_back([object]() {
+            for (int j = 0; j < 10000; ++j) {
+                object->addRef();
+                object->release();
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    ExpectEq(object->getRefCount() == 1 && destroyedNum == 0, true);
+    object->release();
+    ExpectEq(destroyedNum == 1, true);
+}
+
+TEST(refCountedTest, test2) {
+    logLabel = "objects released off the main thread are destroyed by the pool";
+    cc::DeferredReleasePool::clear();
+    destroyedNum = 0;
+    auto *released     = new SharedObject();
+    auto *autoreleased = new SharedObject();
+    released->addRef();
+    autoreleased->addRef();
+
+    std::thread worker([=]() {
+        released->release();
+        cc::DeferredReleasePool::add(autoreleased);
+    });
+    worker.join();
+    ExpectEq(destroyedNum == 0, true);
+
+    cc::DeferredReleasePool::clear();
+    ExpectEq(destroyedNum == 2, true);
+}
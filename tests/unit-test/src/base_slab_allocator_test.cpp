@@ -0,0 +1,108 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "cocos/base/memory/SlabAllocator.h"
+#include "utils.h"
+
+namespace {
+struct SlabObject {
+    CC_SLAB_ALLOCATED(SlabObject)
+
+    uint8_t data[40];
+};
+
+struct BigSlabObject {
+    CC_SLAB_ALLOCATED(BigSlabObject)
+
+    uint8_t data[4000];
+};
+} // namespace
+
+TEST(slabAllocatorTest, test1) {
+    logLabel = "freed objects are reused and counted per type";
+    auto &stats  = SlabObject::getSlabTypeStats();
+    auto  before = stats.liveCount.load();
+    auto *first  = new SlabObject();
+    ExpectEq(reinterpret_cast<uintptr_t>(first) % alignof(std::max_align_t) == 0, true);
+    ExpectEq(stats.liveCount.load() - before == 1 && stats.objectSize.load() == sizeof(SlabObject), true);
+    delete first;
+    auto *second = new SlabObject();
+    ExpectEq(second == first, true);
+    delete second;
+    ExpectEq(stats.liveCount.load() == before, true);
+}
+
+TEST(slabAllocatorTest, test2) {
+    logLabel = "objects don't overlap and big ones fall back to the heap";
+    std::vector<SlabObject *> objects;
+    for (int i = 0; i < 1000; ++i) {
+        objects.push_back(new SlabObject());
+        objects.back()->data[0]  = static_cast<uint8_t>(i);
+        objects.back()->data[39] = static_cast<uint8_t>(i);
+    }
+    bool intact = true;
+    for (int i = 0; i < 1000; ++i) {
+        intact = intact && objects[i]->data[0] == static_cast<uint8_t>(i) && objects[i]->data[39] == static_cast<uint8_t>(i);
+    }
+    ExpectEq(intact, true);
+    for (auto *object : objects) {
+        delete object;
+    }
+
+    auto *big = new (std::nothrow) BigSlabObject();
+    ExpectEq(big != nullptr && BigSlabObject::getSlabTypeStats().liveCount.load() == 1, true);
+    delete big;
+    ExpectEq(BigSlabObject::getSlabTypeStats().liveCount.load() == 0, true);
+}
+
+TEST(slabAllocatorTest, test3) {
+    logLabel = "objects can be freed on other threads";
+    auto &                    stats  = SlabObject::getSlabTypeStats();
+    auto                      before = stats.liveCount.load();
+    std::vector<SlabObject *> objects(5000);
+    std::thread               producer([&objects]() {
+        for (auto &object : objects) {
+            object = new SlabObject();
+        }
+    });
+    producer.join();
+    std::thread consumer([&objects]() {
+        for (auto *object : objects) {
+            delete object;
+        }
+    });
+    consumer.join();
+    ExpectEq(stats.liveCount.load() == before, true);
+
+    // registered for good, it must outlive the test
+    static cc::SlabTypeStats sharedStats{"shared int"};
+    auto                     shared = std::allocate_shared<int>(cc::SlabStlAllocator<int>(&sharedStats), 42);
+    ExpectEq(*shared == 42 && sharedStats.liveCount.load() == 1, true);
+    shared.reset();
+    ExpectEq(sharedStats.liveCount.load() == 0, true);
+}
@@ -0,0 +1,82 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <thread>
+#include "cocos/base/memory/TaggedMemoryTracker.h"
+#include "utils.h"
+
+TEST(taggedMemoryTrackerTest, test1) {
+    logLabel = "allocations are charged to the tag of the current scope";
+    const auto before = cc::TaggedMemoryTracker::getStats(cc::MemoryTag::SPINE);
+    void *     small  = nullptr;
+    void *     large  = nullptr;
+    {
+        cc::MemoryTagScope scope(cc::MemoryTag::SPINE);
+        small = cc::TaggedMemoryTracker::allocate(24);
+        large = cc::TaggedMemoryTracker::allocate(1000, 64);
+    }
+    ExpectEq(cc::TaggedMemoryTracker::getCurrentTag() == cc::MemoryTag::DEFAULT, true);
+    ExpectEq(reinterpret_cast<uintptr_t>(large) % 64 == 0, true);
+    ExpectEq(cc::TaggedMemoryTracker::getAllocationSize(large) == 1000, true);
+
+    const auto during = cc::TaggedMemoryTracker::getStats(cc::MemoryTag::SPINE);
+    ExpectEq(during.liveBytes - before.liveBytes == 1024, true);
+    ExpectEq(during.liveCount - before.liveCount == 2, true);
+
+    cc::TaggedMemoryTracker::deallocate(small);
+    cc::TaggedMemoryTracker::deallocate(large);
+    const auto after = cc::TaggedMemoryTracker::getStats(cc::MemoryTag::SPINE);
+    ExpectEq(after.liveBytes == before.liveBytes && after.allocatedBytes - before.allocatedBytes == 1024, true);
+}
+
+TEST(taggedMemoryTrackerTest, test2) {
+    logLabel = "blocks freed on another thread are subtracted from the total";
+    const auto before = cc::TaggedMemoryTracker::getStats(cc::MemoryTag::AUDIO);
+    void *     ptr    = nullptr;
+    std::thread producer([&ptr]() {
+        cc::MemoryTagScope scope(cc::MemoryTag::AUDIO);
+        ptr = cc::TaggedMemoryTracker::allocate(4096);
+    });
+    producer.join();
+    ExpectEq(cc::TaggedMemoryTracker::getStats(cc::MemoryTag::AUDIO).liveBytes - before.liveBytes == 4096, true);
+
+    cc::TaggedMemoryTracker::deallocate(ptr);
+    ExpectEq(cc::TaggedMemoryTracker::getStats(cc::MemoryTag::AUDIO).liveBytes == before.liveBytes, true);
+}
+
+TEST(taggedMemoryTrackerTest, test3) {
+    logLabel = "reallocate keeps the contents";
+    auto *data = static_cast<uint8_t *>(cc::TaggedMemoryTracker::reallocate(nullptr, 16));
+    for (uint8_t i = 0; i < 16; ++i) {
+        data[i] = i;
+    }
+    data = static_cast<uint8_t *>(cc::TaggedMemoryTracker::reallocate(data, 4096));
+    bool intact = true;
+    for (uint8_t i = 0; i < 16; ++i) {
+        intact = intact && data[i] == i;
+    }
+    ExpectEq(intact && cc::TaggedMemoryTracker::getAllocationSize(data) == 4096, true);
+    ExpectEq(cc::TaggedMemoryTracker::reallocate(data, 0) == nullptr, true);
+}
@@ -0,0 +1,103 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include <array>
+#include <atomic>
+#include <vector>
+#include "cocos/base/threading/TaskPool.h"
+#include "utils.h"
+
+namespace {
+void waitUntil(const std::atomic<bool> &flag) {
+    while (!flag.load()) {
+        std::this_thread::yield();
+    }
+}
+} // namespace
+
+TEST(taskPoolTest, test1) {
+    logLabel = "queued tasks start by priority";
+    std::vector<int>  order;
+    std::atomic<bool> started{false};
+    std::atomic<bool> gate{false};
+    {
+        cc::TaskPool pool(1);
+        pool.pushTask([&](int /*tid*/) {
+            started = true;
+            waitUntil(gate);
+        });
+        waitUntil(started);
+        pool.pushTask([&](int /*tid*/) { order.push_back(2); }, cc::TaskPool::TaskType::DEFAULT, cc::TaskPool::Priority::LOW);
+        pool.pushTask([&](int /*tid*/) { order.push_back(1); }, cc::TaskPool::TaskType::DEFAULT, cc::TaskPool::Priority::NORMAL);
+        pool.pushTask([&](int /*tid*/) { order.push_back(0); }, cc::TaskPool::TaskType::DEFAULT, cc::TaskPool::Priority::HIGH);
+        gate = true;
+    }
+    ExpectEq(order == std::vector<int>({0, 1, 2}), true);
+}
+
+TEST(taskPoolTest, test2) {
+    logLabel = "cancelled and stopped tasks never run";
+    std::atomic<int>  ran{0};
+    std::atomic<bool> started{false};
+    std::atomic<bool> gate{false};
+    {
+        cc::TaskPool             pool(1);
+        cc::TaskPool::CancelToken token;
+        pool.pushTask([&](int /*tid*/) {
+            started = true;
+            waitUntil(gate);
+        });
+        waitUntil(started);
+        pool.pushTask([&](int /*tid*/) { ran += 1; }, cc::TaskPool::TaskType::DEFAULT, cc::TaskPool::Priority::NORMAL, &token);
+        pool.pushTask([&](int /*tid*/) { ran += 10; }, cc::TaskPool::TaskType::IO);
+        pool.pushTask([&](int /*tid*/) { ran += 100; }, cc::TaskPool::TaskType::NETWORK);
+        token.cancel();
+        pool.stopTasksByType(cc::TaskPool::TaskType::IO);
+        gate = true;
+    }
+    ExpectEq(ran.load() == 100, true);
+}
+
+TEST(taskPoolTest, test3) {
+    logLabel = "bursts beyond the queue capacity and large callables all run once";
+    constexpr int    taskNum = 5000;
+    std::vector<int> visits(taskNum, 0);
+    {
+        cc::TaskPool pool(4);
+        for (int i = 0; i < taskNum; ++i) {
+            if (i % 2) {
+                pool.pushTask([&visits, i](int /*tid*/) { visits[i]++; });
+            } else {
+                std::array<char, 256> payload{};
+                payload[0] = 1;
+                pool.pushTask([&visits, i, payload](int /*tid*/) { visits[i] += payload[0]; });
+            }
+        }
+    }
+    bool expected = true;
+    for (int v : visits) {
+        expected = expected && v == 1;
+    }
+    ExpectEq(expected, true);
+}
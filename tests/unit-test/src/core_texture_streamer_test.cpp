@@ -0,0 +1,131 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <vector>
+#include "core/assets/ImageAsset.h"
+#include "core/assets/Texture2D.h"
+#include "core/assets/TextureStreamer.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+// a 256x256 RGBA8 texture with all of its 9 mipmaps authored
+struct StreamableTexture {
+    StreamableTexture() {
+        std::vector<SharedPtr<ImageAsset>> mipmaps;
+        for (uint32_t level = 0; level < 9; ++level) {
+            uint32_t size = std::max(256U >> level, 1U);
+            data.emplace_back(size * size * 4, static_cast<uint8_t>(level));
+            auto *image = new ImageAsset();
+            image->setWidth(size);
+            image->setHeight(size);
+            image->setFormat(PixelFormat::RGBA8888);
+            image->setData(data.back().data());
+            mipmaps.emplace_back(image);
+        }
+        texture = new Texture2D();
+        texture->addRef();
+        texture->setMipmaps(mipmaps);
+    }
+    ~StreamableTexture() {
+        if (texture) {
+            texture->release();
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> data;
+    Texture2D *                       texture{nullptr};
+};
+
+void flushFrames(uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        gfx::Device::getInstance()->flushTextureUploads();
+    }
+}
+} // namespace
+
+TEST(textureStreamerTest, test1) {
+    initCocos(100, 100);
+    auto *streamer = TextureStreamer::getInstance();
+    streamer->setEnabled(true);
+
+    {
+        logLabel = "textures with mipmaps start from the level fitting the initial size";
+        StreamableTexture streamable;
+        ExpectEq(streamable.texture->getResidentLevel() == 2 && streamer->getTextureCount() == 1, true);
+
+        logLabel = "disabling and re-enabling streaming keeps the textures tracked";
+        streamer->setEnabled(false);
+        flushFrames(gfx::Device::getInstance()->getMaxFramesInFlight() + 1);
+        ExpectEq(streamable.texture->getResidentLevel() == 0 && !streamable.texture->isStreaming(), true);
+        streamer->setEnabled(true);
+        ExpectEq(streamer->getTextureCount() == 1, true);
+
+        logLabel = "a texture culling has not reported yet keeps its resident level";
+        StreamableTexture unseen;
+        streamer->update();
+        ExpectEq(unseen.texture->getResidentLevel() == 2 && !unseen.texture->isStreaming(), true);
+    }
+    ExpectEq(streamer->getTextureCount() == 0, true);
+
+    streamer->setEnabled(false);
+    destroyCocos();
+}
+
+TEST(textureStreamerTest, test2) {
+    initCocos(100, 100);
+    auto *streamer = TextureStreamer::getInstance();
+    streamer->setEnabled(true);
+
+    {
+        logLabel = "a texture destroyed while streaming drops its upload";
+        StreamableTexture destroyed;
+        destroyed.texture->streamToLevel(0);
+        ExpectEq(destroyed.texture->isStreaming(), true);
+        destroyed.texture->release();
+        destroyed.texture = nullptr;
+        flushFrames(gfx::Device::getInstance()->getMaxFramesInFlight() + 1);
+        ExpectEq(streamer->getTextureCount() == 0, true);
+
+        logLabel = "a level without data keeps the current texture";
+        StreamableTexture incomplete;
+        incomplete.texture->getMipmaps()[1]->setData(nullptr);
+        incomplete.texture->streamToLevel(0);
+        ExpectEq(!incomplete.texture->isStreaming() && incomplete.texture->getResidentLevel() == 2, true);
+
+        logLabel = "the swap happens once the GPU is done with every level";
+        StreamableTexture streamed;
+        streamed.texture->streamToLevel(1);
+        flushFrames(gfx::Device::getInstance()->getMaxFramesInFlight());
+        ExpectEq(streamed.texture->getResidentLevel() == 2 && streamed.texture->isStreaming(), true);
+        flushFrames(1);
+        ExpectEq(streamed.texture->getResidentLevel() == 1 && !streamed.texture->isStreaming(), true);
+    }
+
+    streamer->setEnabled(false);
+    destroyCocos();
+}
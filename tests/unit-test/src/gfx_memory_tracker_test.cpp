@@ -0,0 +1,154 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include <vector>
+#include "cocos/renderer/gfx-base/GFXBuffer.h"
+#include "cocos/renderer/gfx-base/GFXMemoryTracker.h"
+#include "utils.h"
+
+namespace {
+using namespace cc::gfx;
+
+class FakeBuffer final : public Buffer {
+public:
+    explicit FakeBuffer(BufferUsage usage, uint size) {
+        BufferInfo info;
+        info.usage    = usage;
+        info.memUsage = MemoryUsageBit::DEVICE;
+        info.size     = size;
+        initialize(info);
+    }
+
+    void update(const void * /*buffer*/, uint /*size*/) override {}
+
+protected:
+    void doInit(const BufferInfo & /*info*/) override {}
+    void doInit(const BufferViewInfo & /*info*/) override {}
+    void doResize(uint /*size*/, uint /*count*/) override {}
+    void doDestroy() override {}
+};
+
+struct Exceeded {
+    cc::MemoryTag tag;
+    uint64_t      usage;
+    uint64_t      budget;
+};
+} // namespace
+
+TEST(gfxMemoryTrackerTest, test1) {
+    logLabel = "usage is accounted by category and the high-water mark survives until the frame ends";
+    MemoryStatus  status;
+    MemoryTracker tracker(&status);
+    FakeBuffer    vertices(BufferUsageBit::VERTEX | BufferUsageBit::TRANSFER_DST, 1024);
+    FakeBuffer    uniforms(BufferUsageBit::UNIFORM, 256);
+
+    tracker.allocate(&vertices, vertices.getSize());
+    tracker.allocate(&uniforms, uniforms.getSize());
+    ExpectEq(status.bufferSize == 1280, true);
+    ExpectEq(tracker.getCategoryUsage(MemoryCategory::VERTEX_BUFFER).current == 1024, true);
+    ExpectEq(tracker.getCategoryUsage(MemoryCategory::UNIFORM_BUFFER).current == 256, true);
+    ExpectEq(tracker.getTotalUsage().count == 2, true);
+
+    tracker.release(&vertices, vertices.getSize());
+    MemoryCounter total = tracker.getTotalUsage();
+    ExpectEq(total.current == 256 && total.frameHighWater == 1280 && total.lastFrameHighWater == 0 && total.peak == 1280, true);
+
+    tracker.nextFrame();
+    total = tracker.getTotalUsage();
+    ExpectEq(total.frameHighWater == 256 && total.lastFrameHighWater == 1280 && total.peak == 1280, true);
+
+    tracker.nextFrame();
+    total = tracker.getTotalUsage();
+    ExpectEq(total.frameHighWater == 256 && total.lastFrameHighWater == 256, true);
+
+    tracker.release(&uniforms, uniforms.getSize());
+    ExpectEq(status.bufferSize == 0 && tracker.getTotalUsage().count == 0, true);
+}
+
+TEST(gfxMemoryTrackerTest, test2) {
+    logLabel = "the budget callback fires once per overrun and may query the tracker";
+    MemoryStatus  status;
+    MemoryTracker tracker(&status);
+    FakeBuffer    buffer(BufferUsageBit::STORAGE, 4096);
+
+    std::vector<Exceeded> calls;
+    uint64_t              reportedTotal = 0;
+    tracker.setBudget(MemoryTracker::ALL_MEMORY_TAGS, 2048);
+    tracker.setBudgetCallback([&](cc::MemoryTag tag, uint64_t usage, uint64_t budget) {
+        calls.push_back({tag, usage, budget});
+        reportedTotal = tracker.getTotalUsage().current; // must not deadlock
+    });
+
+    tracker.allocate(&buffer, buffer.getSize());
+    tracker.nextFrame();
+    ExpectEq(calls.size() == 1, true);
+    ExpectEq(calls[0].tag == MemoryTracker::ALL_MEMORY_TAGS && calls[0].usage == 4096 && calls[0].budget == 2048, true);
+    ExpectEq(reportedTotal == 4096, true);
+
+    // still over budget, no new report
+    tracker.nextFrame();
+    ExpectEq(calls.size() == 1, true);
+
+    // back under budget and over again, reported again
+    tracker.release(&buffer, buffer.getSize());
+    tracker.nextFrame();
+    tracker.nextFrame();
+    tracker.allocate(&buffer, buffer.getSize());
+    tracker.nextFrame();
+    ExpectEq(calls.size() == 2, true);
+
+    tracker.setBudgetCallback(nullptr);
+    tracker.release(&buffer, buffer.getSize());
+}
+
+TEST(gfxMemoryTrackerTest, test3) {
+    logLabel = "resources are charged to the tag of the scope they are created in";
+    MemoryStatus  status;
+    MemoryTracker tracker(&status);
+    FakeBuffer    untagged(BufferUsageBit::VERTEX, 512);
+    // the scope macro is active whether or not the CPU allocation tracker is compiled in
+    CC_MEMORY_TAG_SCOPE(cc::MemoryTag::SPINE);
+    FakeBuffer spine(BufferUsageBit::VERTEX, 2048);
+
+    ExpectEq(untagged.getMemoryTag() == cc::MemoryTag::DEFAULT, true);
+    ExpectEq(spine.getMemoryTag() == cc::MemoryTag::SPINE, true);
+
+    std::vector<Exceeded> calls;
+    tracker.setBudget(cc::MemoryTag::SPINE, 1024);
+    tracker.setBudgetCallback([&](cc::MemoryTag tag, uint64_t usage, uint64_t budget) {
+        calls.push_back({tag, usage, budget});
+    });
+
+    tracker.allocate(&untagged, untagged.getSize());
+    tracker.allocate(&spine, spine.getSize());
+    ExpectEq(tracker.getTagUsage(cc::MemoryTag::DEFAULT).current == 512, true);
+    ExpectEq(tracker.getTagUsage(cc::MemoryTag::SPINE).current == 2048, true);
+
+    tracker.nextFrame();
+    ExpectEq(calls.size() == 1 && calls[0].tag == cc::MemoryTag::SPINE && calls[0].usage == 2048, true);
+
+    tracker.release(&untagged, untagged.getSize());
+    tracker.release(&spine, spine.getSize());
+    ExpectEq(tracker.getTagUsage(cc::MemoryTag::SPINE).current == 0, true);
+}
@@ -0,0 +1,163 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "utils.h"
+
+namespace {
+using namespace cc::gfx;
+
+class FakeTexture final : public Texture {
+protected:
+    void doInit(const TextureInfo & /*info*/) override {}
+    void doInit(const TextureViewInfo & /*info*/) override {}
+    void doDestroy() override {}
+    void doResize(uint /*width*/, uint /*height*/, uint /*size*/) override {}
+};
+
+// records the copies instead of talking to a GPU
+class FakeDevice final : public Device {
+public:
+    struct Copy {
+        Texture *texture;
+        uint     mipLevel;
+        uint     regionCount;
+        uint8_t  firstByte;
+    };
+
+    void resize(uint /*width*/, uint /*height*/) override {}
+    void acquire() override {}
+    void present() override {}
+
+    void copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) override {
+        copies.push_back({dst, regions[0].texSubres.mipLevel, count, buffers[0][0]});
+    }
+    void copyTextureToBuffers(Texture * /*src*/, uint8_t *const * /*buffers*/, const BufferTextureCopy * /*region*/, uint /*count*/) override {}
+
+    std::vector<Copy> copies;
+
+protected:
+    bool doInit(const DeviceInfo & /*info*/) override { return true; }
+    void doDestroy() override {}
+
+    CommandBuffer *      createCommandBuffer(const CommandBufferInfo & /*info*/, bool /*hasAgent*/) override { return nullptr; }
+    Queue *              createQueue() override { return nullptr; }
+    Buffer *             createBuffer() override { return nullptr; }
+    Texture *            createTexture() override { return nullptr; }
+    Sampler *            createSampler() override { return nullptr; }
+    Shader *             createShader() override { return nullptr; }
+    InputAssembler *     createInputAssembler() override { return nullptr; }
+    RenderPass *         createRenderPass() override { return nullptr; }
+    Framebuffer *        createFramebuffer() override { return nullptr; }
+    DescriptorSet *      createDescriptorSet() override { return nullptr; }
+    DescriptorSetLayout *createDescriptorSetLayout() override { return nullptr; }
+    PipelineLayout *     createPipelineLayout() override { return nullptr; }
+    PipelineState *      createPipelineState() override { return nullptr; }
+    GlobalBarrier *      createGlobalBarrier() override { return nullptr; }
+    TextureBarrier *     createTextureBarrier() override { return nullptr; }
+};
+
+// a 64x64 RGBA8 texture with a full mip chain, the data of each level is filled with its level index
+struct MipChain {
+    explicit MipChain(Texture *texture) {
+        TextureInfo info;
+        info.format     = Format::RGBA8;
+        info.width      = 64;
+        info.height     = 64;
+        info.levelCount = 7;
+        texture->initialize(info);
+        for (uint level = 0; level < info.levelCount; ++level) {
+            uint size = std::max(64U >> level, 1U);
+            data.emplace_back(size * size * 4, static_cast<uint8_t>(level));
+            BufferTextureCopy region;
+            region.texExtent.width    = size;
+            region.texExtent.height   = size;
+            region.texSubres.mipLevel = level;
+            regions.push_back(region);
+        }
+        for (auto &level : data) {
+            buffers.push_back(level.data());
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> data;
+    std::vector<const uint8_t *>      buffers;
+    std::vector<BufferTextureCopy>    regions;
+};
+} // namespace
+
+TEST(textureUploadTest, test1) {
+    logLabel = "uploads are split by the per-frame budget and complete once the GPU is done with them";
+    FakeDevice  device;
+    FakeTexture texture;
+    MipChain    chain(&texture);
+    device.setTextureUploadBudget(16 * 1024);
+
+    bool completed = false;
+    device.copyBuffersToTextureAsync(chain.buffers.data(), &texture, chain.regions.data(), static_cast<uint>(chain.regions.size()), [&]() { completed = true; });
+    ExpectEq(device.copies.empty(), true);
+
+    // the 16 KB base level fills the first frame, the remaining levels fit in the second
+    device.flushTextureUploads();
+    ExpectEq(device.copies.size() == 1 && device.copies[0].mipLevel == 0 && device.copies[0].regionCount == 1, true);
+    device.flushTextureUploads();
+    ExpectEq(device.copies.size() == 2 && device.copies[1].mipLevel == 1 && device.copies[1].regionCount == 6, true);
+    ExpectEq(device.copies[1].firstByte == 1, true);
+
+    bool early = false;
+    for (uint i = 1; i < device.getMaxFramesInFlight(); ++i) {
+        device.flushTextureUploads();
+        early = early || completed;
+    }
+    ExpectEq(early, false);
+    device.flushTextureUploads();
+    ExpectEq(completed, true);
+    device.destroy();
+}
+
+TEST(textureUploadTest, test2) {
+    logLabel = "destroying a texture drops its pending uploads and callbacks";
+    FakeDevice  device;
+    FakeTexture kept;
+    FakeTexture dropped;
+    MipChain    keptChain(&kept);
+    MipChain    droppedChain(&dropped);
+    device.setTextureUploadBudget(0);
+
+    int completed = 0;
+    device.copyBuffersToTextureAsync(droppedChain.buffers.data(), &dropped, droppedChain.regions.data(), 1, [&]() { completed += 10; });
+    device.flushTextureUploads();
+    device.copyBuffersToTextureAsync(droppedChain.buffers.data(), &dropped, droppedChain.regions.data(), 1, [&]() { completed += 10; });
+    device.copyBuffersToTextureAsync(keptChain.buffers.data(), &kept, keptChain.regions.data(), 1, [&]() { ++completed; });
+    dropped.destroy();
+
+    for (uint i = 0; i <= device.getMaxFramesInFlight(); ++i) {
+        device.flushTextureUploads();
+    }
+    ExpectEq(device.copies.size() == 2 && device.copies[1].texture == &kept, true);
+    ExpectEq(completed == 1, true);
+    device.destroy();
+}
@@ -0,0 +1,71 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "core/Root.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXDescriptorSet.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+#include "renderer/pipeline/forward/ClusterLightCulling.h"
+#include "renderer/pipeline/forward/ForwardPipeline.h"
+#include "utils.h"
+
+using namespace cc;
+
+TEST(pipelineClusterLightCullingTest, test1) {
+    initCocos(100, 100);
+    auto *root = Root::getInstance();
+
+    logLabel = "the macro is off without clustered lighting";
+    const auto &defaultMacros = root->getPipeline()->getMacros();
+    ExpectEq(cc::get<bool>(defaultMacros.at("CC_ENABLE_CLUSTERED_LIGHT_CULLING")), false);
+
+    if (!gfx::Device::getInstance()->hasFeature(gfx::Feature::TEXTURE_FLOAT)) {
+        destroyCocos();
+        return;
+    }
+
+    // replace the default pipeline, the root destroys the new one with the director
+    auto *defaultPipeline = root->getPipeline();
+    defaultPipeline->destroy();
+    delete defaultPipeline;
+
+    logLabel = "the forward program is told to read the cluster grid";
+    auto *forward = new pipeline::ForwardPipeline();
+    forward->initialize({});
+    forward->setClusteredLighting(true);
+    ExpectEq(root->setRenderPipeline(forward), true);
+    const auto &macros = forward->getMacros();
+    auto        iter   = macros.find("CC_ENABLE_CLUSTERED_LIGHT_CULLING");
+    ExpectEq(iter != macros.end() && cc::get<bool>(iter->second), true);
+
+    logLabel = "the cluster textures are bound to the global set the forward pass draws with";
+    auto *culling   = CC_NEW(pipeline::ClusterLightCulling(forward));
+    auto *globalSet = forward->getDescriptorSet();
+    ExpectEq(globalSet->getTexture(pipeline::CLUSTERLIGHTS::BINDING) != nullptr, true);
+    ExpectEq(globalSet->getTexture(pipeline::CLUSTERLIGHTGRID::BINDING) != nullptr, true);
+    ExpectEq(globalSet->getTexture(pipeline::CLUSTERLIGHTINDICES::BINDING) != nullptr, true);
+    CC_SAFE_DELETE(culling);
+
+    destroyCocos();
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/renderer/pipeline/DynamicResolution.h"
+#include "utils.h"
+
+TEST(pipelineDynamicResolutionTest, test1) {
+    logLabel = "frames over budget lower the scale down to the minimum";
+    cc::pipeline::DynamicResolution drs;
+    drs.setTargetFrameTime(1.0F / 60.0F);
+    drs.setScaleRange(0.5F, 1.0F);
+    drs.reset(1.0F);
+    float scale = drs.update(1.0F / 30.0F);
+    ExpectEq(scale < 1.0F, true);
+    ExpectEq(scale >= 0.9F, true);
+    for (int i = 0; i < 500; ++i) {
+        scale = drs.update(1.0F / 30.0F);
+    }
+    ExpectEq(IsEqualF(scale, 0.5F), true);
+
+    logLabel = "frames under budget raise the scale back up to the maximum";
+    for (int i = 0; i < 2000; ++i) {
+        scale = drs.update(1.0F / 120.0F);
+    }
+    ExpectEq(IsEqualF(scale, 1.0F), true);
+}
+
+TEST(pipelineDynamicResolutionTest, test2) {
+    logLabel = "frames near the target keep the scale";
+    cc::pipeline::DynamicResolution drs;
+    drs.setTargetFrameTime(1.0F / 60.0F);
+    drs.reset(0.8F);
+    float scale = 0.F;
+    for (int i = 0; i < 100; ++i) {
+        scale = drs.update(1.0F / 62.0F);
+    }
+    ExpectEq(IsEqualF(scale, 0.8F), true);
+
+    logLabel = "reset clamps to the scale range";
+    drs.setScaleRange(0.6F, 0.9F);
+    drs.reset(1.0F);
+    ExpectEq(IsEqualF(drs.getScale(), 0.9F), true);
+}
+
+TEST(pipelineDynamicResolutionTest, test3) {
+    logLabel = "frames pinned to the vsync period after a hitch raise the scale back up";
+    cc::pipeline::DynamicResolution drs;
+    drs.setTargetFrameTime(1.0F / 60.0F);
+    drs.setScaleRange(0.5F, 1.0F);
+    drs.reset(1.0F);
+    float scale = 1.0F;
+    for (int i = 0; i < 30; ++i) {
+        scale = drs.update(1.0F / 20.0F);
+    }
+    ExpectEq(scale < 0.8F, true);
+    for (int i = 0; i < 2000; ++i) {
+        scale = drs.update(1.0F / 60.0F);
+    }
+    ExpectEq(IsEqualF(scale, 1.0F), true);
+
+    logLabel = "probes that miss the vsync period back off";
+    // anything above 0.7 misses every other vsync
+    drs.reset(0.7F);
+    uint missed = 0;
+    for (int i = 0; i < 4000; ++i) {
+        const bool miss = drs.getScale() > 0.7F + 1e-4F;
+        missed += miss ? 1 : 0;
+        drs.update(miss ? 1.0F / 30.0F : 1.0F / 60.0F);
+    }
+    ExpectEq(missed < 400, true);
+}